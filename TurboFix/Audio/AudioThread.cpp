@@ -0,0 +1,105 @@
+#include "AudioThread.hpp"
+
+#include "../Util/Threads.hpp"
+
+CAudioThread::CAudioThread(ISoundBackend& backend, unsigned maxVoices, float maxDistance)
+    : mState(new SState()) {
+    mState->VoicePool = std::make_unique<CVoicePool>(backend, maxVoices, maxDistance);
+    mThread = std::thread(&CAudioThread::run, mState);
+}
+
+CAudioThread::~CAudioThread() {
+    mState->Stop.store(true);
+    mState->Pushed.fetch_add(1);
+    mState->Pushed.notify_one();
+
+    // This may run during DLL_PROCESS_DETACH, so the thread isn't joined.
+    if (Threads::Detach(mThread)) {
+        // Ended with the process, maybe halfway through a batch: don't lock.
+        mState->VoicePool.reset();
+        return;
+    }
+
+    // At most waits for the batch it's working on, which doesn't need the loader lock.
+    std::lock_guard lock(mState->BatchMutex);
+    mState->VoicePool.reset();
+}
+
+void CAudioThread::Play(int sample, const Vector3& pos, float volume, float speed) {
+    SCommand command{ SCommand::EType::Play };
+    command.Sample = sample;
+    command.Position = pos;
+    command.Volume = volume;
+    command.Speed = speed;
+    push(command);
+}
+
+void CAudioThread::SetListener(const Vector3& pos, const Vector3& rot) {
+    SCommand command{ SCommand::EType::Listener };
+    command.Position = pos;
+    command.Rotation = rot;
+    push(command);
+}
+
+CVoicePool::SStats CAudioThread::Stats() const {
+    CVoicePool::SStats stats;
+    stats.Active = mState->StatActive.load(std::memory_order_relaxed);
+    stats.Played = mState->StatPlayed.load(std::memory_order_relaxed);
+    stats.Culled = mState->StatCulled.load(std::memory_order_relaxed);
+    stats.Stolen = mState->StatStolen.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void CAudioThread::push(const SCommand& command) {
+    if (!mState->Queue.TryPush(command)) {
+        mState->Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    mState->Pushed.fetch_add(1, std::memory_order_release);
+    mState->Pushed.notify_one();
+}
+
+void CAudioThread::run(SState* state) {
+    uint32_t seen = 0;
+    while (true) {
+        state->Pushed.wait(seen, std::memory_order_acquire);
+        seen = state->Pushed.load(std::memory_order_acquire);
+
+        std::lock_guard lock(state->BatchMutex);
+        if (state->Stop.load())
+            break;
+
+        CVoicePool& voicePool = *state->VoicePool;
+
+        // Listener updates are coalesced: only the latest one is applied,
+        // right before the first play that needs it, or at the end of the batch.
+        bool listenerPending = false;
+        SCommand listener{};
+
+        SCommand command;
+        while (state->Queue.TryPop(command)) {
+            switch (command.Type) {
+                case SCommand::EType::Listener:
+                    listener = command;
+                    listenerPending = true;
+                    break;
+                case SCommand::EType::Play:
+                    if (listenerPending) {
+                        voicePool.Update(listener.Position, listener.Rotation);
+                        listenerPending = false;
+                    }
+                    voicePool.Play(command.Sample, command.Position, command.Volume, command.Speed);
+                    break;
+            }
+        }
+
+        if (listenerPending)
+            voicePool.Update(listener.Position, listener.Rotation);
+
+        const auto& stats = voicePool.Stats();
+        state->StatActive.store(stats.Active, std::memory_order_relaxed);
+        state->StatPlayed.store(stats.Played, std::memory_order_relaxed);
+        state->StatCulled.store(stats.Culled, std::memory_order_relaxed);
+        state->StatStolen.store(stats.Stolen, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "../Util/CommandQueue.hpp"
+#include "VoicePool.hpp"
+
+#include <inc/types.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Runs all sound backend calls on its own thread, so a stall in the sound device
+// doesn't hold up the script. The script only pushes small commands.
+class CAudioThread {
+public:
+    CAudioThread(ISoundBackend& backend, unsigned maxVoices, float maxDistance);
+    ~CAudioThread();
+
+    CAudioThread(const CAudioThread&) = delete;
+    CAudioThread& operator=(const CAudioThread&) = delete;
+
+    void Play(int sample, const Vector3& pos, float volume, float speed = 1.0f);
+
+    // Only the latest listener update is applied each time the thread wakes up.
+    void SetListener(const Vector3& pos, const Vector3& rot);
+
+    // Copied from the voice pool after each batch of commands.
+    CVoicePool::SStats Stats() const;
+
+    // Commands that didn't fit in the queue.
+    uint64_t Dropped() const {
+        return mState->Dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct SCommand {
+        enum class EType : uint8_t {
+            Play,
+            Listener,
+        };
+
+        EType Type;
+        // Play only
+        int Sample;
+        // Play: sound position, Listener: listener position
+        Vector3 Position;
+        // Listener only
+        Vector3 Rotation;
+        // Play only
+        float Volume;
+        float Speed;
+    };
+
+    // Everything the audio thread uses.
+    struct SState {
+        CCommandQueue<SCommand, 256> Queue;
+        std::atomic<uint32_t> Pushed = 0;
+        std::atomic<bool> Stop = false;
+        std::atomic<uint64_t> Dropped = 0;
+
+        // Held while the thread works through a batch of commands. After Stop,
+        // the thread doesn't touch the voice pool anymore once it has this.
+        std::mutex BatchMutex;
+        std::unique_ptr<CVoicePool> VoicePool;
+
+        std::atomic<unsigned> StatActive = 0;
+        std::atomic<uint64_t> StatPlayed = 0;
+        std::atomic<uint64_t> StatCulled = 0;
+        std::atomic<uint64_t> StatStolen = 0;
+    };
+
+    void push(const SCommand& command);
+    static void run(SState* state);
+
+    // Never freed: the thread may outlive this, see Threads::Detach. The voice
+    // pool is released in the destructor, so the backend can go right after.
+    SState* mState;
+    std::thread mThread;
+};
@@ -0,0 +1,77 @@
+#include "Decode.hpp"
+
+#include "../Util/Logger.hpp"
+#include "../Util/String.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+
+#define DR_FLAC_IMPLEMENTATION
+#define DR_FLAC_NO_OGG
+#include <dr_libs/dr_flac.h>
+
+// Last: stb_vorbis.c defines a few short macros of its own.
+#define STB_VORBIS_NO_PUSHDATA_API
+#include <stb/stb_vorbis.c>
+
+namespace {
+    bool readOgg(const std::string& file, Audio::SPcm& pcm) {
+        int channels = 0;
+        int sampleRate = 0;
+        short* samples = nullptr;
+        int frames = stb_vorbis_decode_filename(file.c_str(), &channels, &sampleRate, &samples);
+        if (frames < 0 || samples == nullptr) {
+            logger.Write(ERROR, "[Decode] Failed to decode [%s] as OGG Vorbis", file.c_str());
+            return false;
+        }
+
+        pcm.SampleRate = static_cast<uint32_t>(sampleRate);
+        pcm.Channels = static_cast<uint16_t>(channels);
+        pcm.Samples.assign(samples, samples + static_cast<size_t>(frames) * channels);
+        free(samples);
+        return true;
+    }
+
+    bool readFlac(const std::string& file, Audio::SPcm& pcm) {
+        unsigned int channels = 0;
+        unsigned int sampleRate = 0;
+        drflac_uint64 frames = 0;
+        drflac_int16* samples = drflac_open_file_and_read_pcm_frames_s16(file.c_str(),
+            &channels, &sampleRate, &frames, nullptr);
+        if (samples == nullptr) {
+            logger.Write(ERROR, "[Decode] Failed to decode [%s] as FLAC", file.c_str());
+            return false;
+        }
+
+        pcm.SampleRate = sampleRate;
+        pcm.Channels = static_cast<uint16_t>(channels);
+        pcm.Samples.assign(samples, samples + static_cast<size_t>(frames) * channels);
+        drflac_free(samples, nullptr);
+        return true;
+    }
+}
+
+const std::vector<std::string>& Audio::AudioExtensions() {
+    static const std::vector<std::string> extensions = { ".wav", ".ogg", ".flac" };
+    return extensions;
+}
+
+bool Audio::ReadAudio(const std::string& file, SPcm& pcm) {
+    const std::string extension = Util::to_lower(std::filesystem::path(file).extension().string());
+    bool read;
+    if (extension == ".ogg") {
+        read = readOgg(file, pcm);
+    }
+    else if (extension == ".flac") {
+        read = readFlac(file, pcm);
+    }
+    else {
+        read = ReadWav(file, pcm);
+    }
+
+    if (read && (pcm.Channels == 0 || pcm.SampleRate == 0 || pcm.Samples.empty())) {
+        logger.Write(ERROR, "[Decode] [%s] has no audio", file.c_str());
+        return false;
+    }
+    return read;
+}
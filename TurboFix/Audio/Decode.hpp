@@ -0,0 +1,14 @@
+#pragma once
+#include "Wav.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Audio {
+// Extensions ReadAudio knows, lower case.
+const std::vector<std::string>& AudioExtensions();
+
+// Decodes a WAV, OGG Vorbis or FLAC file to 16-bit PCM, going by the extension.
+// OGG and FLAC are decoded with the bundled stb_vorbis and dr_flac.
+bool ReadAudio(const std::string& file, SPcm& pcm);
+}
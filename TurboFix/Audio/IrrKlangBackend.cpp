@@ -0,0 +1,138 @@
+#include "IrrKlangBackend.hpp"
+
+#include "Decode.hpp"
+#include "../Util/Logger.hpp"
+
+CIrrKlangBackend::CIrrKlangBackend()
+    : mEngine(irrklang::createIrrKlangDevice(irrklang::ESOD_DIRECT_SOUND_8)) {
+    if (!mEngine) {
+        logger.Write(ERROR, "[Audio] Failed to create irrKlang device");
+        return;
+    }
+    mEngine->setDefault3DSoundMinDistance(Audio::DefaultMinDistance);
+}
+
+CIrrKlangBackend::~CIrrKlangBackend() {
+    for (const auto& [voice, sound] : mVoices) {
+        sound->stop();
+        sound->drop();
+    }
+    // The device itself isn't dropped: that waits for irrKlang's threads,
+    // which can't finish while we're unloading under the loader lock.
+}
+
+int CIrrKlangBackend::LoadSample(const std::string& file) {
+    {
+        std::lock_guard lock(mSamplesMutex);
+        auto it = mSampleIds.find(file);
+        if (it != mSampleIds.end())
+            return it->second;
+    }
+
+    // Decoded by us rather than by irrKlang, so every backend gets the same PCM.
+    // Outside the lock, so loader threads decode in parallel.
+    Audio::SPcm pcm;
+    if (Audio::ReadAudio(file, pcm))
+        return AddSample(file, pcm);
+
+    // Formats we don't decode (compressed WAVs) may still play with irrKlang's own decoders.
+    std::lock_guard lock(mSamplesMutex);
+    auto it = mSampleIds.find(file);
+    if (it != mSampleIds.end())
+        return it->second;
+
+    irrklang::ISoundSource* source = mEngine->addSoundSourceFromFile(file.c_str(), irrklang::ESM_NO_STREAMING, true);
+    if (!source) {
+        logger.Write(ERROR, "[Audio] Failed to load [%s]", file.c_str());
+        return -1;
+    }
+    logger.Write(INFO, "[Audio] Loaded [%s] with irrKlang's decoder", file.c_str());
+    return addSource(file, source);
+}
+
+int CIrrKlangBackend::AddSample(const std::string& name, const Audio::SPcm& pcm) {
+    std::lock_guard lock(mSamplesMutex);
+    auto it = mSampleIds.find(name);
+    if (it != mSampleIds.end())
+        return it->second;
+
+    irrklang::ISoundSource* source = mEngine->getSoundSource(name.c_str(), false);
+    if (!source) {
+        irrklang::SAudioStreamFormat format{};
+        format.ChannelCount = pcm.Channels;
+        format.FrameCount = static_cast<irrklang::ik_s32>(pcm.FrameCount());
+        format.SampleRate = static_cast<irrklang::ik_s32>(pcm.SampleRate);
+        format.SampleFormat = irrklang::ESF_S16;
+
+        // Copied by irrKlang.
+        source = mEngine->addSoundSourceFromPCMData(const_cast<int16_t*>(pcm.Samples.data()),
+            static_cast<irrklang::ik_s32>(pcm.Samples.size() * sizeof(int16_t)), name.c_str(), format);
+    }
+    if (!source) {
+        logger.Write(ERROR, "[Audio] Failed to add [%s]", name.c_str());
+        return -1;
+    }
+
+    return addSource(name, source);
+}
+
+int CIrrKlangBackend::addSource(const std::string& name, irrklang::ISoundSource* source) {
+    int id = static_cast<int>(mSamples.size());
+    mSamples.push_back(source);
+    mSampleIds[name] = id;
+    return id;
+}
+
+void CIrrKlangBackend::SetListener(const Vector3& pos, const Vector3& dir) {
+    mEngine->setListenerPosition(
+        irrklang::vec3df(pos.x, pos.y, pos.z),
+        irrklang::vec3df(dir.x, dir.y, dir.z),
+        irrklang::vec3df(0, 0, 0),
+        irrklang::vec3df(0, 0, -1)
+    );
+}
+
+uint32_t CIrrKlangBackend::Play(int sample, const Vector3& pos, float volume, float speed) {
+    irrklang::ISoundSource* source;
+    {
+        std::lock_guard lock(mSamplesMutex);
+        if (sample < 0 || sample >= static_cast<int>(mSamples.size()))
+            return 0;
+        source = mSamples[sample];
+    }
+
+    // Start paused, so the volume is set before anything is heard.
+    irrklang::ISound* sound = mEngine->play3D(source, { pos.x, pos.y, pos.z }, false, true, true);
+    if (!sound)
+        return 0;
+
+    sound->setVolume(volume);
+    if (speed != 1.0f)
+        sound->setPlaybackSpeed(speed);
+    sound->setIsPaused(false);
+
+    uint32_t voice = mNextVoice++;
+    if (mNextVoice == 0)
+        mNextVoice = 1;
+    mVoices[voice] = sound;
+    return voice;
+}
+
+bool CIrrKlangBackend::IsPlaying(uint32_t voice) {
+    auto it = mVoices.find(voice);
+    return it != mVoices.end() && !it->second->isFinished();
+}
+
+void CIrrKlangBackend::Stop(uint32_t voice) {
+    auto it = mVoices.find(voice);
+    if (it == mVoices.end())
+        return;
+
+    it->second->stop();
+    it->second->drop();
+    mVoices.erase(it);
+}
+
+float CIrrKlangBackend::MinDistance() const {
+    return mEngine->getDefault3DSoundMinDistance();
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "SoundBackend.hpp"
+
+#include <irrKlang.h>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class CIrrKlangBackend : public ISoundBackend {
+public:
+    // Check Valid() afterwards, creating the device may fail.
+    CIrrKlangBackend();
+    ~CIrrKlangBackend() override;
+
+    bool Valid() const {
+        return mEngine != nullptr;
+    }
+
+    const char* Name() const override {
+        return "IrrKlang";
+    }
+
+    int LoadSample(const std::string& file) override;
+    int AddSample(const std::string& name, const Audio::SPcm& pcm) override;
+    void SetListener(const Vector3& pos, const Vector3& dir) override;
+    uint32_t Play(int sample, const Vector3& pos, float volume, float speed) override;
+    bool IsPlaying(uint32_t voice) override;
+    void Stop(uint32_t voice) override;
+    float MinDistance() const override;
+
+private:
+    // Call with mSamplesMutex locked.
+    int addSource(const std::string& name, irrklang::ISoundSource* source);
+
+    irrklang::ISoundEngine* mEngine;
+
+    std::mutex mSamplesMutex;
+    std::vector<irrklang::ISoundSource*> mSamples;
+    std::unordered_map<std::string, int> mSampleIds;
+
+    std::unordered_map<uint32_t, irrklang::ISound*> mVoices;
+    uint32_t mNextVoice = 1;
+};
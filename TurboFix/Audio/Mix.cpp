@@ -0,0 +1,69 @@
+#include "Mix.hpp"
+
+#include <algorithm>
+
+Audio::SPcm Audio::ToMono(const SPcm& pcm) {
+    if (pcm.Channels <= 1)
+        return pcm;
+
+    SPcm mono;
+    mono.SampleRate = pcm.SampleRate;
+    mono.Channels = 1;
+    mono.Samples.resize(pcm.FrameCount());
+    for (size_t frame = 0; frame < mono.Samples.size(); ++frame) {
+        int sum = 0;
+        for (uint16_t channel = 0; channel < pcm.Channels; ++channel) {
+            sum += pcm.Samples[frame * pcm.Channels + channel];
+        }
+        mono.Samples[frame] = static_cast<int16_t>(sum / pcm.Channels);
+    }
+    return mono;
+}
+
+Audio::SPcm Audio::Resample(const SPcm& pcm, uint32_t sampleRate) {
+    if (pcm.SampleRate == sampleRate || pcm.FrameCount() == 0)
+        return pcm;
+
+    SPcm out;
+    out.SampleRate = sampleRate;
+    out.Channels = pcm.Channels;
+
+    const size_t inFrames = pcm.FrameCount();
+    const size_t outFrames = static_cast<size_t>(static_cast<uint64_t>(inFrames) * sampleRate / pcm.SampleRate);
+    const double step = static_cast<double>(pcm.SampleRate) / sampleRate;
+    out.Samples.resize(outFrames * out.Channels);
+
+    for (size_t frame = 0; frame < outFrames; ++frame) {
+        double pos = frame * step;
+        size_t i0 = std::min(static_cast<size_t>(pos), inFrames - 1);
+        size_t i1 = std::min(i0 + 1, inFrames - 1);
+        double t = pos - static_cast<double>(i0);
+
+        for (uint16_t channel = 0; channel < out.Channels; ++channel) {
+            double s0 = pcm.Samples[i0 * pcm.Channels + channel];
+            double s1 = pcm.Samples[i1 * pcm.Channels + channel];
+            out.Samples[frame * out.Channels + channel] = static_cast<int16_t>(s0 + (s1 - s0) * t);
+        }
+    }
+    return out;
+}
+
+Audio::SPcm Audio::Mix(const SPcm& a, const SPcm& b, uint32_t sampleRate) {
+    SPcm layerA = Resample(ToMono(a), sampleRate);
+    SPcm layerB = Resample(ToMono(b), sampleRate);
+
+    SPcm out;
+    out.SampleRate = sampleRate;
+    out.Channels = 1;
+    out.Samples.resize(std::max(layerA.Samples.size(), layerB.Samples.size()));
+
+    for (size_t i = 0; i < out.Samples.size(); ++i) {
+        int sum = 0;
+        if (i < layerA.Samples.size())
+            sum += layerA.Samples[i];
+        if (i < layerB.Samples.size())
+            sum += layerB.Samples[i];
+        out.Samples[i] = static_cast<int16_t>(std::clamp(sum, -32768, 32767));
+    }
+    return out;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "Wav.hpp"
+
+namespace Audio {
+// Rate pre-mixed samples are rendered at.
+constexpr uint32_t MixSampleRate = 44100;
+
+// Averages all channels into one.
+SPcm ToMono(const SPcm& pcm);
+
+// Linear interpolation, good enough for short effects.
+SPcm Resample(const SPcm& pcm, uint32_t sampleRate);
+
+// Sums both layers into one mono buffer at sampleRate. Clips instead of
+// normalizing, so the result sounds the same as playing both at once.
+SPcm Mix(const SPcm& a, const SPcm& b, uint32_t sampleRate);
+}
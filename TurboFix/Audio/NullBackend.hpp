@@ -0,0 +1,53 @@
+#pragma once
+#include "SoundBackend.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+// Accepts everything and plays nothing. Voices finish right away.
+class CNullBackend : public ISoundBackend {
+public:
+    const char* Name() const override {
+        return "Null";
+    }
+
+    int LoadSample(const std::string& file) override {
+        std::lock_guard lock(mSamplesMutex);
+        auto it = mSampleIds.find(file);
+        if (it != mSampleIds.end())
+            return it->second;
+
+        int id = static_cast<int>(mSampleIds.size());
+        mSampleIds[file] = id;
+        return id;
+    }
+
+    int AddSample(const std::string& name, const Audio::SPcm&) override {
+        return LoadSample(name);
+    }
+
+    void SetListener(const Vector3&, const Vector3&) override { }
+
+    uint32_t Play(int sample, const Vector3&, float, float) override {
+        if (sample < 0)
+            return 0;
+        if (++mNextVoice == 0)
+            mNextVoice = 1;
+        return mNextVoice;
+    }
+
+    bool IsPlaying(uint32_t) override {
+        return false;
+    }
+
+    void Stop(uint32_t) override { }
+
+    float MinDistance() const override {
+        return Audio::DefaultMinDistance;
+    }
+
+private:
+    std::mutex mSamplesMutex;
+    std::unordered_map<std::string, int> mSampleIds;
+    uint32_t mNextVoice = 0;
+};
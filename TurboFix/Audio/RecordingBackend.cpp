@@ -0,0 +1,164 @@
+#include "RecordingBackend.hpp"
+
+#include "Decode.hpp"
+#include "../Util/Logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+CRecordingBackend::CRecordingBackend(std::string outputFile)
+    : mOutputFile(std::move(outputFile))
+    , mStartTime(std::chrono::steady_clock::now())
+    , mListenerPos{} {
+}
+
+CRecordingBackend::~CRecordingBackend() {
+    Write();
+}
+
+int CRecordingBackend::LoadSample(const std::string& file) {
+    {
+        std::lock_guard lock(mSamplesMutex);
+        auto it = mSampleIds.find(file);
+        if (it != mSampleIds.end())
+            return it->second;
+    }
+
+    Audio::SPcm pcm;
+    if (!Audio::ReadAudio(file, pcm))
+        return -1;
+    return AddSample(file, pcm);
+}
+
+int CRecordingBackend::AddSample(const std::string& name, const Audio::SPcm& pcm) {
+    std::lock_guard lock(mSamplesMutex);
+    auto it = mSampleIds.find(name);
+    if (it != mSampleIds.end())
+        return it->second;
+
+    if (pcm.Channels == 0 || pcm.SampleRate == 0)
+        return -1;
+
+    int id = static_cast<int>(mSamples.size());
+    mSamples.push_back(pcm);
+    mSampleIds[name] = id;
+    return id;
+}
+
+void CRecordingBackend::SetListener(const Vector3& pos, const Vector3& dir) {
+    mListenerPos = pos;
+}
+
+uint32_t CRecordingBackend::Play(int sample, const Vector3& pos, float volume, float speed) {
+    if (speed <= 0.0f)
+        return 0;
+
+    uint64_t start = currentFrame();
+    mixFinished(start);
+
+    uint64_t frames;
+    {
+        std::lock_guard lock(mSamplesMutex);
+        if (sample < 0 || sample >= static_cast<int>(mSamples.size()))
+            return 0;
+        const auto& pcm = mSamples[sample];
+        frames = static_cast<uint64_t>(pcm.FrameCount() * SampleRate / pcm.SampleRate / speed);
+    }
+
+    // Same inverse distance rolloff irrKlang uses by default.
+    float dx = pos.x - mListenerPos.x;
+    float dy = pos.y - mListenerPos.y;
+    float dz = pos.z - mListenerPos.z;
+    float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+    float gain = volume * MinDistance() / std::max(distance, MinDistance());
+
+    uint32_t voice = mNextVoice++;
+    if (mNextVoice == 0)
+        mNextVoice = 1;
+    mVoices[voice] = { sample, gain, speed, start, start + frames };
+    ++mSounds;
+    return voice;
+}
+
+bool CRecordingBackend::IsPlaying(uint32_t voice) {
+    auto it = mVoices.find(voice);
+    return it != mVoices.end() && currentFrame() < it->second.EndFrame;
+}
+
+void CRecordingBackend::Stop(uint32_t voice) {
+    auto it = mVoices.find(voice);
+    if (it == mVoices.end())
+        return;
+
+    auto& event = it->second;
+    event.EndFrame = std::min(event.EndFrame, currentFrame());
+    {
+        std::lock_guard lock(mSamplesMutex);
+        mix(event);
+    }
+    mVoices.erase(it);
+}
+
+float CRecordingBackend::MinDistance() const {
+    return Audio::DefaultMinDistance;
+}
+
+bool CRecordingBackend::Write() {
+    // Whatever is still playing gets recorded until its end.
+    mixFinished(std::numeric_limits<uint64_t>::max());
+
+    Audio::SPcm out;
+    out.SampleRate = SampleRate;
+    out.Channels = 1;
+    out.Samples.resize(mMix.size());
+    std::transform(mMix.begin(), mMix.end(), out.Samples.begin(), [](float value) {
+        return static_cast<int16_t>(std::clamp(value, -32768.0f, 32767.0f));
+    });
+
+    logger.Write(INFO, "[Audio] Recorded %llu sounds (%.1f s) to [%s]",
+        static_cast<unsigned long long>(mSounds),
+        static_cast<double>(mMix.size()) / SampleRate, mOutputFile.c_str());
+    return Audio::WriteWav(mOutputFile, out);
+}
+
+uint64_t CRecordingBackend::currentFrame() const {
+    auto elapsed = std::chrono::steady_clock::now() - mStartTime;
+    return static_cast<uint64_t>(std::chrono::duration<double>(elapsed).count() * SampleRate);
+}
+
+void CRecordingBackend::mix(const SEvent& event) {
+    const uint64_t end = std::min(event.EndFrame, MaxFrames);
+    if (event.StartFrame >= end)
+        return;
+
+    if (mMix.size() < end)
+        mMix.resize(end);
+
+    const auto& pcm = mSamples[event.Sample];
+    const double step = static_cast<double>(pcm.SampleRate) * event.Speed / SampleRate;
+    for (uint64_t frame = event.StartFrame; frame < end; ++frame) {
+        size_t srcFrame = static_cast<size_t>((frame - event.StartFrame) * step);
+        if (srcFrame >= pcm.FrameCount())
+            break;
+
+        // Down-mix to mono
+        float value = 0.0f;
+        for (uint16_t channel = 0; channel < pcm.Channels; ++channel) {
+            value += pcm.Samples[srcFrame * pcm.Channels + channel];
+        }
+        mMix[frame] += event.Gain * value / pcm.Channels;
+    }
+}
+
+void CRecordingBackend::mixFinished(uint64_t frame) {
+    std::lock_guard lock(mSamplesMutex);
+    for (auto it = mVoices.begin(); it != mVoices.end();) {
+        if (it->second.EndFrame > frame) {
+            ++it;
+            continue;
+        }
+        mix(it->second);
+        it = mVoices.erase(it);
+    }
+}
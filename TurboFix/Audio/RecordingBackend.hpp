@@ -0,0 +1,68 @@
+#pragma once
+#include "SoundBackend.hpp"
+#include "Wav.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Doesn't need a sound device: mixes everything that's played into a mono
+// WAV file, written when the backend is destroyed. Voices play for as long
+// as their sample lasts, so voice counts behave like with a real device.
+// Finished sounds are mixed right away, so only playing ones are kept.
+class CRecordingBackend : public ISoundBackend {
+public:
+    explicit CRecordingBackend(std::string outputFile);
+    ~CRecordingBackend() override;
+
+    const char* Name() const override {
+        return "Recording";
+    }
+
+    int LoadSample(const std::string& file) override;
+    int AddSample(const std::string& name, const Audio::SPcm& pcm) override;
+    void SetListener(const Vector3& pos, const Vector3& dir) override;
+    uint32_t Play(int sample, const Vector3& pos, float volume, float speed) override;
+    bool IsPlaying(uint32_t voice) override;
+    void Stop(uint32_t voice) override;
+    float MinDistance() const override;
+
+    // Mixes everything played so far and writes it to the output file.
+    bool Write();
+
+private:
+    static constexpr uint32_t SampleRate = 44100;
+    // Anything played after this isn't recorded, but still counts as playing.
+    static constexpr uint64_t MaxFrames = SampleRate * 60 * 10;
+
+    struct SEvent {
+        int Sample;
+        float Gain;
+        float Speed;
+        uint64_t StartFrame;
+        uint64_t EndFrame;
+    };
+
+    uint64_t currentFrame() const;
+    // Adds the event to mMix. Needs mSamplesMutex.
+    void mix(const SEvent& event);
+    // Mixes and removes voices that ended before frame.
+    void mixFinished(uint64_t frame);
+
+    std::string mOutputFile;
+    std::chrono::steady_clock::time_point mStartTime;
+    Vector3 mListenerPos;
+
+    std::mutex mSamplesMutex;
+    std::vector<Audio::SPcm> mSamples;
+    std::unordered_map<std::string, int> mSampleIds;
+
+    // Voice ID -> event, while it's playing.
+    std::unordered_map<uint32_t, SEvent> mVoices;
+    uint32_t mNextVoice = 1;
+
+    // Finished sounds, up to MaxFrames.
+    std::vector<float> mMix;
+    uint64_t mSounds = 0;
+};
@@ -0,0 +1,29 @@
+#include "SoundBackend.hpp"
+
+#include "IrrKlangBackend.hpp"
+#include "NullBackend.hpp"
+#include "RecordingBackend.hpp"
+#include "../Util/Logger.hpp"
+#include "../Util/String.hpp"
+
+std::unique_ptr<ISoundBackend> Audio::CreateSoundBackend(const std::string& name, const std::string& recordingFile) {
+    std::unique_ptr<ISoundBackend> backend;
+
+    if (Util::strcmpwi(name, "IrrKlang")) {
+        auto irrKlang = std::make_unique<CIrrKlangBackend>();
+        if (irrKlang->Valid())
+            backend = std::move(irrKlang);
+    }
+    else if (Util::strcmpwi(name, "Recording")) {
+        backend = std::make_unique<CRecordingBackend>(recordingFile);
+    }
+    else if (!Util::strcmpwi(name, "Null")) {
+        logger.Write(ERROR, "[Audio] Unknown sound backend [%s]", name.c_str());
+    }
+
+    if (!backend)
+        backend = std::make_unique<CNullBackend>();
+
+    logger.Write(INFO, "[Audio] Using sound backend [%s]", backend->Name());
+    return backend;
+}
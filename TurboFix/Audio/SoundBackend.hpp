@@ -0,0 +1,48 @@
+#pragma once
+#include "Wav.hpp"
+
+#include <inc/types.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// What actually plays the sounds. Besides irrKlang, there's a null backend
+// and one that records everything to a WAV file, both of which don't need
+// a sound device.
+//
+// LoadSample and AddSample may be called from any thread (sound sets are loaded
+// on worker threads), everything else is called from the audio thread.
+class ISoundBackend {
+public:
+    virtual ~ISoundBackend() = default;
+
+    virtual const char* Name() const = 0;
+
+    // Decodes the file into memory with Audio::ReadAudio. Loading the same file
+    // again returns the same ID. -1 when it couldn't be loaded.
+    virtual int LoadSample(const std::string& file) = 0;
+
+    // Same as LoadSample, for PCM data generated at runtime. name identifies it.
+    virtual int AddSample(const std::string& name, const Audio::SPcm& pcm) = 0;
+
+    virtual void SetListener(const Vector3& pos, const Vector3& dir) = 0;
+
+    // Returns a voice ID, or 0 when it couldn't be played.
+    // speed scales the playback rate, so it also shifts the pitch.
+    virtual uint32_t Play(int sample, const Vector3& pos, float volume, float speed) = 0;
+    virtual bool IsPlaying(uint32_t voice) = 0;
+    // Stops the voice if it's still playing, and releases it.
+    virtual void Stop(uint32_t voice) = 0;
+
+    // Sounds don't get louder when closer than this.
+    virtual float MinDistance() const = 0;
+};
+
+namespace Audio {
+constexpr float DefaultMinDistance = 7.5f;
+
+// name: "IrrKlang", "Null" or "Recording". Falls back to "Null" if the
+// backend can't be created. The recording backend writes recordingFile when
+// it's destroyed.
+std::unique_ptr<ISoundBackend> CreateSoundBackend(const std::string& name, const std::string& recordingFile);
+}
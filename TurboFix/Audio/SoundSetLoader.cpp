@@ -0,0 +1,105 @@
+#include "SoundSetLoader.hpp"
+
+#include "../Util/Threads.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+CSoundSetLoader::CSoundSetLoader(unsigned threads)
+    : mShared(std::make_shared<SShared>()) {
+    for (unsigned i = 0; i < std::max(threads, 1u); ++i) {
+        mThreads.emplace_back(&CSoundSetLoader::run, mShared);
+    }
+}
+
+CSoundSetLoader::~CSoundSetLoader() {
+    {
+        std::lock_guard lock(mShared->Mutex);
+        mShared->Stop = true;
+        mShared->Jobs.clear();
+    }
+    mShared->Wake.notify_all();
+
+    // Same as the audio thread: this may run under the loader lock, so don't join.
+    // A worker still decoding keeps the shared state alive until it's done.
+    bool running = false;
+    for (auto& thread : mThreads) {
+        if (!Threads::Detach(thread))
+            running = true;
+    }
+
+    // Ended with the process, maybe halfway through a backend call: don't lock.
+    if (!running)
+        return;
+
+    // At most waits for the backend call a worker is in, which doesn't need the
+    // loader lock. Workers don't touch the backend after this.
+    std::lock_guard backendLock(mShared->BackendMutex);
+}
+
+int CSoundSetLoader::CJob::Backend(const std::function<int()>& call) const {
+    std::lock_guard lock(mShared.BackendMutex);
+    if (Stale())
+        return -1;
+    return call();
+}
+
+bool CSoundSetLoader::CJob::Stale() const {
+    return mShared.Stop.load() || mShared.Generation.load() != mGeneration;
+}
+
+void CSoundSetLoader::Clear() {
+    // Waits for a backend call of an old job to finish, so none come after this.
+    std::lock_guard backendLock(mShared->BackendMutex);
+    std::lock_guard lock(mShared->Mutex);
+    ++mShared->Generation;
+    mShared->Jobs.clear();
+    mShared->Results.clear();
+}
+
+void CSoundSetLoader::Queue(size_t index, SSoundSet soundSet, LoadFn load) {
+    {
+        std::lock_guard lock(mShared->Mutex);
+        mShared->Jobs.push_back({ mShared->Generation, index, std::move(soundSet), std::move(load) });
+    }
+    mShared->Wake.notify_one();
+}
+
+std::vector<CSoundSetLoader::SResult> CSoundSetLoader::TakeFinished() {
+    std::lock_guard lock(mShared->Mutex);
+    std::vector<SResult> results;
+    results.swap(mShared->Results);
+    return results;
+}
+
+size_t CSoundSetLoader::Pending() {
+    std::lock_guard lock(mShared->Mutex);
+    return mShared->Jobs.size() + mShared->Running;
+}
+
+void CSoundSetLoader::run(std::shared_ptr<SShared> shared) {
+    std::unique_lock lock(shared->Mutex);
+    while (true) {
+        shared->Wake.wait(lock, [&]() {
+            return shared->Stop || !shared->Jobs.empty();
+        });
+        if (shared->Stop)
+            break;
+
+        SJob job = std::move(shared->Jobs.front());
+        shared->Jobs.pop_front();
+        ++shared->Running;
+        lock.unlock();
+
+        auto tStart = std::chrono::steady_clock::now();
+        bool loaded = job.Load(job.SoundSet, CJob(*shared, job.Generation));
+        auto tEnd = std::chrono::steady_clock::now();
+
+        lock.lock();
+        --shared->Running;
+        if (job.Generation == shared->Generation) {
+            shared->Results.push_back({ job.Index, std::move(job.SoundSet), loaded,
+                std::chrono::duration<double, std::milli>(tEnd - tStart).count() });
+        }
+    }
+}
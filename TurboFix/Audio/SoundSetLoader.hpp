@@ -0,0 +1,95 @@
+#pragma once
+#include "../SoundSet.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Decodes sound sets on worker threads, so loading doesn't hold up the script.
+// Finished sound sets are picked up on the script thread with TakeFinished.
+class CSoundSetLoader {
+    struct SShared;
+
+public:
+    // Handed to a job, so its backend calls stop once it's no longer wanted.
+    class CJob {
+    public:
+        // Runs a backend call that returns a sample ID. Returns -1 without calling
+        // it after Clear or once the loader is destroyed, so the backend can be
+        // reloaded or destroyed right after.
+        int Backend(const std::function<int()>& call) const;
+
+        // After Clear or once the loader is destroyed.
+        bool Stale() const;
+
+    private:
+        friend class CSoundSetLoader;
+        CJob(SShared& shared, uint32_t generation)
+            : mShared(shared), mGeneration(generation) {}
+
+        SShared& mShared;
+        uint32_t mGeneration;
+    };
+
+    // Fills in the samples of the sound set. Runs on a worker thread, and has
+    // to make every backend call through CJob::Backend.
+    using LoadFn = std::function<bool(SSoundSet&, const CJob&)>;
+
+    struct SResult {
+        // Index passed to Queue.
+        size_t Index;
+        SSoundSet SoundSet;
+        bool Loaded;
+        double LoadTimeMs;
+    };
+
+    explicit CSoundSetLoader(unsigned threads);
+    ~CSoundSetLoader();
+
+    CSoundSetLoader(const CSoundSetLoader&) = delete;
+    CSoundSetLoader& operator=(const CSoundSetLoader&) = delete;
+
+    // Drops queued jobs, and results of jobs that were already running.
+    void Clear();
+
+    void Queue(size_t index, SSoundSet soundSet, LoadFn load);
+
+    // Results of the jobs queued since the last Clear.
+    std::vector<SResult> TakeFinished();
+
+    // Queued or still running.
+    size_t Pending();
+
+private:
+    struct SJob {
+        uint32_t Generation;
+        size_t Index;
+        SSoundSet SoundSet;
+        LoadFn Load;
+    };
+
+    // Workers may outlive the loader when it's destroyed during unload, see the destructor.
+    struct SShared {
+        std::mutex Mutex;
+        std::condition_variable Wake;
+        std::deque<SJob> Jobs;
+        std::vector<SResult> Results;
+        size_t Running = 0;
+
+        // Held for each backend call a job makes. After Stop, or once the
+        // generation moved on, a job doesn't call the backend anymore once it has this.
+        std::mutex BackendMutex;
+        std::atomic<uint32_t> Generation = 0;
+        std::atomic<bool> Stop = false;
+    };
+
+    static void run(std::shared_ptr<SShared> shared);
+
+    std::shared_ptr<SShared> mShared;
+    std::vector<std::thread> mThreads;
+};
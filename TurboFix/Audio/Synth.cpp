@@ -0,0 +1,334 @@
+#include "Synth.hpp"
+
+#include "Mix.hpp"
+
+#include <simpleini/SimpleIni.h>
+#include <emmintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace {
+    constexpr float Pi = 3.14159265358979f;
+    constexpr unsigned Lanes = 4;
+    static_assert(Audio::WhistleVariants <= Lanes, "Whistles are rendered in one pass");
+
+    // Per-pop parameters, after randomization.
+    struct SVoiceParams {
+        float FilterCoeff;
+        float DecayMul;
+        float BodyDecayMul;
+        float BodyCos;
+        float BodySin;
+        uint32_t Seed;
+    };
+
+    SVoiceParams randomize(const Audio::SSynthParams& params, std::mt19937& rng) {
+        std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+        const float rate = static_cast<float>(Audio::MixSampleRate);
+
+        float cutoff = params.CutoffHz * (1.0f + params.CutoffJitter * jitter(rng));
+        cutoff = std::clamp(cutoff, 20.0f, rate * 0.45f);
+        float decaySec = std::max(params.DecayMs * (1.0f + params.DecayJitter * jitter(rng)), 1.0f) / 1000.0f;
+        float bodyHz = params.BodyHz * (1.0f + 0.15f * jitter(rng));
+        float bodyW = 2.0f * Pi * bodyHz / rate;
+
+        SVoiceParams voice;
+        voice.FilterCoeff = 1.0f - std::exp(-2.0f * Pi * cutoff / rate);
+        voice.DecayMul = std::exp(-1.0f / (decaySec * rate));
+        // The thump rings a bit longer than the noise.
+        voice.BodyDecayMul = std::exp(-1.0f / (decaySec * 1.5f * rate));
+        voice.BodyCos = std::cos(bodyW);
+        voice.BodySin = std::sin(bodyW);
+        // xorshift can't start at 0.
+        voice.Seed = rng() | 1;
+        return voice;
+    }
+
+    // 4 lanes of xorshift32, returns floats in [1, 2).
+    __m128 nextRandom(__m128i& state) {
+        state = _mm_xor_si128(state, _mm_slli_epi32(state, 13));
+        state = _mm_xor_si128(state, _mm_srli_epi32(state, 17));
+        state = _mm_xor_si128(state, _mm_slli_epi32(state, 5));
+        __m128i mantissa = _mm_or_si128(_mm_srli_epi32(state, 9), _mm_set1_epi32(0x3F800000));
+        return _mm_castsi128_ps(mantissa);
+    }
+
+    // Renders 4 pops at once, one per SSE lane. out is interleaved per lane.
+    void renderLanes(const Audio::SSynthParams& params, const SVoiceParams (&voices)[Lanes],
+                     size_t frames, std::vector<float>& out) {
+        auto load = [&](auto member) {
+            return _mm_setr_ps(voices[0].*member, voices[1].*member, voices[2].*member, voices[3].*member);
+        };
+
+        const __m128 filterCoeff = load(&SVoiceParams::FilterCoeff);
+        const __m128 decayMul = load(&SVoiceParams::DecayMul);
+        const __m128 bodyDecayMul = load(&SVoiceParams::BodyDecayMul);
+        const __m128 bodyCos = load(&SVoiceParams::BodyCos);
+        const __m128 bodySin = load(&SVoiceParams::BodySin);
+
+        // Low-passing white noise loses level, so make up for it per lane.
+        float noiseGain[Lanes];
+        for (unsigned i = 0; i < Lanes; ++i) {
+            float a = voices[i].FilterCoeff;
+            noiseGain[i] = 0.5f * std::sqrt((2.0f - a) / a);
+        }
+        const __m128 noiseScale = _mm_loadu_ps(noiseGain);
+
+        const float rate = static_cast<float>(Audio::MixSampleRate);
+        const __m128 crackleChance = _mm_set1_ps(params.CrackleRate * 1000.0f / rate);
+        const __m128 crackleLevel = _mm_set1_ps(1.5f);
+        const __m128 bodyLevel = _mm_set1_ps(params.BodyLevel);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 three = _mm_set1_ps(3.0f);
+
+        __m128i rngState = _mm_setr_epi32(
+            static_cast<int>(voices[0].Seed), static_cast<int>(voices[1].Seed),
+            static_cast<int>(voices[2].Seed), static_cast<int>(voices[3].Seed));
+        __m128 filtered = _mm_setzero_ps();
+        __m128 env = one;
+        __m128 bodyEnv = one;
+        __m128 bodyC = one;
+        __m128 bodyS = _mm_setzero_ps();
+
+        // Short attack against clicks, and a fade-out over the last 20%.
+        const size_t attackFrames = std::max<size_t>(static_cast<size_t>(rate / 1000.0f), 1);
+        const size_t fadeStart = frames - frames / 5;
+
+        out.resize(frames * Lanes);
+        for (size_t frame = 0; frame < frames; ++frame) {
+            __m128 noise = _mm_sub_ps(_mm_mul_ps(nextRandom(rngState), two), three);
+            __m128 chance = _mm_sub_ps(nextRandom(rngState), one);
+
+            // One-pole low-pass
+            filtered = _mm_add_ps(filtered, _mm_mul_ps(filterCoeff, _mm_sub_ps(noise, filtered)));
+
+            // Sparse unfiltered impulses on top
+            __m128 crackle = _mm_and_ps(_mm_cmplt_ps(chance, crackleChance), _mm_mul_ps(noise, crackleLevel));
+
+            // Sine by rotating (c, s) each frame
+            __m128 c = _mm_sub_ps(_mm_mul_ps(bodyC, bodyCos), _mm_mul_ps(bodyS, bodySin));
+            bodyS = _mm_add_ps(_mm_mul_ps(bodyC, bodySin), _mm_mul_ps(bodyS, bodyCos));
+            bodyC = c;
+
+            __m128 burst = _mm_mul_ps(env, _mm_add_ps(_mm_mul_ps(filtered, noiseScale), crackle));
+            __m128 body = _mm_mul_ps(_mm_mul_ps(bodyEnv, bodyLevel), bodyS);
+            __m128 sample = _mm_add_ps(burst, body);
+
+            float shape = 1.0f;
+            if (frame < attackFrames)
+                shape = static_cast<float>(frame) / static_cast<float>(attackFrames);
+            else if (frame >= fadeStart)
+                shape = static_cast<float>(frames - frame) / static_cast<float>(frames - fadeStart);
+            sample = _mm_mul_ps(sample, _mm_set1_ps(shape));
+
+            _mm_storeu_ps(&out[frame * Lanes], sample);
+
+            env = _mm_mul_ps(env, decayMul);
+            bodyEnv = _mm_mul_ps(bodyEnv, bodyDecayMul);
+        }
+    }
+
+    // One lane of the interleaved output, normalized so its peak is at level.
+    Audio::SPcm toPcm(const std::vector<float>& lanes, unsigned lane, size_t frames, float level) {
+        float peak = 0.0f;
+        for (size_t frame = 0; frame < frames; ++frame) {
+            peak = std::max(peak, std::abs(lanes[frame * Lanes + lane]));
+        }
+        const float gain = peak > 0.0f ? level * 32767.0f / peak : 0.0f;
+
+        Audio::SPcm pcm;
+        pcm.SampleRate = Audio::MixSampleRate;
+        pcm.Channels = 1;
+        pcm.Samples.resize(frames);
+        for (size_t frame = 0; frame < frames; ++frame) {
+            pcm.Samples[frame] = static_cast<int16_t>(lanes[frame * Lanes + lane] * gain);
+        }
+        return pcm;
+    }
+
+    std::vector<Audio::SPcm> render(const Audio::SSynthParams& params, unsigned count) {
+        const size_t frames = std::max<size_t>(
+            static_cast<size_t>(params.LengthMs / 1000.0f * Audio::MixSampleRate), 1);
+
+        std::mt19937 rng(params.Seed);
+        std::vector<Audio::SPcm> pops;
+        std::vector<float> lanes;
+        pops.reserve(count);
+
+        while (pops.size() < count) {
+            SVoiceParams voices[Lanes];
+            for (auto& voice : voices) {
+                voice = randomize(params, rng);
+            }
+            renderLanes(params, voices, frames, lanes);
+
+            for (unsigned lane = 0; lane < Lanes && pops.size() < count; ++lane) {
+                pops.push_back(toPcm(lanes, lane, frames, 0.9f));
+            }
+        }
+        return pops;
+    }
+
+    // Parabolic sine, for x in [-pi, pi]. Within 0.1% of sin, plenty for a whistle.
+    __m128 fastSin(__m128 x) {
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128 b = _mm_set1_ps(4.0f / Pi);
+        const __m128 c = _mm_set1_ps(-4.0f / (Pi * Pi));
+        const __m128 p = _mm_set1_ps(0.225f);
+
+        __m128 y = _mm_mul_ps(x, _mm_add_ps(b, _mm_mul_ps(c, _mm_and_ps(x, absMask))));
+        return _mm_add_ps(y, _mm_mul_ps(p, _mm_sub_ps(_mm_mul_ps(y, _mm_and_ps(y, absMask)), y)));
+    }
+
+    // Renders 4 whistles at once, one per SSE lane, like renderLanes.
+    void renderWhistleLanes(const Audio::SSynthParams& params, const float (&startHz)[Lanes], uint32_t seed,
+                            size_t frames, std::vector<float>& out) {
+        const float rate = static_cast<float>(Audio::MixSampleRate);
+
+        // The pitch glides down exponentially, to WhistleDrop at the end.
+        float w[Lanes];
+        for (unsigned i = 0; i < Lanes; ++i) {
+            w[i] = 2.0f * Pi * std::clamp(startHz[i], 20.0f, rate * 0.45f) / rate;
+        }
+        __m128 omega = _mm_loadu_ps(w);
+        const __m128 glide = _mm_set1_ps(std::pow(std::clamp(params.WhistleDrop, 0.05f, 1.0f),
+            1.0f / static_cast<float>(frames)));
+
+        const __m128 pi = _mm_set1_ps(Pi);
+        const __m128 twoPi = _mm_set1_ps(2.0f * Pi);
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 three = _mm_set1_ps(3.0f);
+        const __m128 hissCoeff = _mm_set1_ps(1.0f - std::exp(-2.0f * Pi * 5000.0f / rate));
+        const __m128 hissLevel = _mm_set1_ps(0.15f);
+
+        __m128i rngState = _mm_setr_epi32(static_cast<int>(seed), static_cast<int>(seed * 3 + 1),
+            static_cast<int>(seed * 5 + 1), static_cast<int>(seed * 7 + 1));
+        __m128 phase = _mm_setzero_ps();
+        __m128 hiss = _mm_setzero_ps();
+
+        // Spools up quickly, then dies away over the length.
+        const size_t attackFrames = std::max<size_t>(static_cast<size_t>(rate * 0.015f), 1);
+        const float decayMul = std::exp(-3.0f / static_cast<float>(frames));
+        const size_t fadeStart = frames - frames / 5;
+        float env = 1.0f;
+
+        out.resize(frames * Lanes);
+        for (size_t frame = 0; frame < frames; ++frame) {
+            phase = _mm_add_ps(phase, omega);
+            phase = _mm_sub_ps(phase, _mm_and_ps(_mm_cmpgt_ps(phase, pi), twoPi));
+            omega = _mm_mul_ps(omega, glide);
+
+            __m128 noise = _mm_sub_ps(_mm_mul_ps(nextRandom(rngState), two), three);
+            hiss = _mm_add_ps(hiss, _mm_mul_ps(hissCoeff, _mm_sub_ps(noise, hiss)));
+
+            float shape = env;
+            if (frame < attackFrames)
+                shape *= static_cast<float>(frame) / static_cast<float>(attackFrames);
+            else if (frame >= fadeStart)
+                shape *= static_cast<float>(frames - frame) / static_cast<float>(frames - fadeStart);
+
+            __m128 sample = _mm_add_ps(fastSin(phase), _mm_mul_ps(hiss, hissLevel));
+            _mm_storeu_ps(&out[frame * Lanes], _mm_mul_ps(sample, _mm_set1_ps(shape)));
+
+            env *= decayMul;
+        }
+    }
+}
+
+Audio::SSynthParams Audio::ReadSynthParams(const std::string& iniFile) {
+    SSynthParams params;
+
+    CSimpleIniA ini;
+    ini.SetUnicode();
+    if (ini.LoadFile(iniFile.c_str()) < 0)
+        return params;
+
+    auto getFloat = [&](const char* key, float defaultValue) {
+        return static_cast<float>(ini.GetDoubleValue("Synth", key, defaultValue));
+    };
+
+    params.Variants = static_cast<unsigned>(std::clamp(ini.GetLongValue("Synth", "Variants", params.Variants), 1L, 64L));
+    params.LengthMs = std::clamp(getFloat("LengthMs", params.LengthMs), 10.0f, 2000.0f);
+    params.DecayMs = getFloat("DecayMs", params.DecayMs);
+    params.DecayJitter = std::clamp(getFloat("DecayJitter", params.DecayJitter), 0.0f, 0.9f);
+    params.CutoffHz = getFloat("CutoffHz", params.CutoffHz);
+    params.CutoffJitter = std::clamp(getFloat("CutoffJitter", params.CutoffJitter), 0.0f, 0.9f);
+    params.BodyHz = getFloat("BodyHz", params.BodyHz);
+    params.BodyLevel = getFloat("BodyLevel", params.BodyLevel);
+    params.CrackleRate = std::max(getFloat("CrackleRate", params.CrackleRate), 0.0f);
+    params.WhistleLevel = std::clamp(getFloat("WhistleLevel", params.WhistleLevel), 0.0f, 1.0f);
+    params.WhistleHz = std::clamp(getFloat("WhistleHz", params.WhistleHz), 100.0f, 12000.0f);
+    params.WhistleMs = std::clamp(getFloat("WhistleMs", params.WhistleMs), 10.0f, 3000.0f);
+    params.WhistleDrop = std::clamp(getFloat("WhistleDrop", params.WhistleDrop), 0.05f, 1.0f);
+    params.Seed = static_cast<uint32_t>(ini.GetLongValue("Synth", "Seed", params.Seed));
+    return params;
+}
+
+uint32_t Audio::HashSynthParams(const SSynthParams& params) {
+    // FNV-1a over each field, so padding doesn't matter.
+    uint32_t hash = 2166136261u;
+    auto add = [&](const auto& value) {
+        unsigned char bytes[sizeof(value)];
+        memcpy(bytes, &value, sizeof(value));
+        for (unsigned char byte : bytes) {
+            hash = (hash ^ byte) * 16777619u;
+        }
+    };
+
+    add(params.Variants);
+    add(params.LengthMs);
+    add(params.DecayMs);
+    add(params.DecayJitter);
+    add(params.CutoffHz);
+    add(params.CutoffJitter);
+    add(params.BodyHz);
+    add(params.BodyLevel);
+    add(params.CrackleRate);
+    add(params.WhistleLevel);
+    add(params.WhistleHz);
+    add(params.WhistleMs);
+    add(params.WhistleDrop);
+    add(params.Seed);
+    return hash;
+}
+
+std::vector<Audio::SPcm> Audio::SynthesizePops(const SSynthParams& params) {
+    return render(params, params.Variants);
+}
+
+Audio::SPcm Audio::SynthesizeSub(const SSynthParams& params) {
+    SSynthParams subParams = params;
+    subParams.CutoffHz *= 0.5f;
+    subParams.CutoffJitter = 0.0f;
+    subParams.CrackleRate = 0.0f;
+    subParams.LengthMs *= 0.6f;
+    subParams.Seed = params.Seed + 1;
+    return render(subParams, 1)[0];
+}
+
+std::vector<Audio::SPcm> Audio::SynthesizeWhistles(const SSynthParams& params) {
+    if (params.WhistleLevel <= 0.0f)
+        return {};
+
+    const size_t frames = std::max<size_t>(
+        static_cast<size_t>(params.WhistleMs / 1000.0f * MixSampleRate), 1);
+
+    std::mt19937 rng(params.Seed + 2);
+    std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+    float startHz[Lanes];
+    for (auto& hz : startHz) {
+        hz = params.WhistleHz * (1.0f + 0.08f * jitter(rng));
+    }
+
+    std::vector<float> lanes;
+    renderWhistleLanes(params, startHz, rng() | 1, frames, lanes);
+
+    std::vector<SPcm> whistles;
+    for (unsigned lane = 0; lane < WhistleVariants; ++lane) {
+        whistles.push_back(toPcm(lanes, lane, frames, 0.9f * params.WhistleLevel));
+    }
+    return whistles;
+}
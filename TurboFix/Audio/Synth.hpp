@@ -0,0 +1,56 @@
+#pragma once
+#include "Wav.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Audio {
+// Parameters for a procedural backfire sound set, read from the [Synth]
+// section of the sound set's SoundSet.ini.
+struct SSynthParams {
+    // Amount of pops rendered. Each one is a different random burst.
+    unsigned Variants = 16;
+    // Length of a pop.
+    float LengthMs = 250.0f;
+    // Time for the noise to fall to ~37%, randomized per pop by DecayJitter.
+    float DecayMs = 45.0f;
+    float DecayJitter = 0.35f;
+    // Low-pass cutoff of the noise, randomized per pop by CutoffJitter.
+    float CutoffHz = 1400.0f;
+    float CutoffJitter = 0.4f;
+    // Low "thump" under the noise.
+    float BodyHz = 65.0f;
+    float BodyLevel = 0.6f;
+    // Chance per millisecond of a crackle on top of the burst.
+    float CrackleRate = 0.08f;
+    // Turbo whistle played with the loud pops: a tone that glides down while
+    // the turbo spools down, with a bit of hiss. Level is relative to the pops,
+    // 0 leaves the whistle out.
+    float WhistleLevel = 0.35f;
+    float WhistleHz = 2600.0f;
+    float WhistleMs = 450.0f;
+    // Pitch at the end, relative to WhistleHz.
+    float WhistleDrop = 0.55f;
+    uint32_t Seed = 1;
+};
+
+SSynthParams ReadSynthParams(const std::string& iniFile);
+
+// Changes when any parameter changes. Goes in the names of the rendered
+// samples, since backends keep samples by name: an edited sound set gets new ones.
+uint32_t HashSynthParams(const SSynthParams& params);
+
+// Renders params.Variants mono pops at MixSampleRate, each normalized to the
+// same peak. The pops already contain the low end, so there's no separate sub.
+std::vector<SPcm> SynthesizePops(const SSynthParams& params);
+
+// Renders the quiet (no-throttle-lift) variant: the same burst, darker and
+// without crackle.
+SPcm SynthesizeSub(const SSynthParams& params);
+
+// Renders WhistleVariants whistles at MixSampleRate, each a bit different in
+// pitch. Empty when WhistleLevel is 0.
+constexpr unsigned WhistleVariants = 4;
+std::vector<SPcm> SynthesizeWhistles(const SSynthParams& params);
+}
@@ -0,0 +1,83 @@
+#include "VoicePool.hpp"
+
+#include "../Util/Math.hpp"
+
+#include <algorithm>
+
+CVoicePool::CVoicePool(ISoundBackend& backend, unsigned maxVoices, float maxDistance)
+    : mBackend(backend)
+    , mMaxVoices(maxVoices)
+    , mMaxDistance(maxDistance)
+    , mListenerPos{} {
+    mVoices.reserve(maxVoices);
+}
+
+CVoicePool::~CVoicePool() {
+    while (!mVoices.empty()) {
+        release(mVoices.size() - 1);
+    }
+}
+
+void CVoicePool::SetLimits(unsigned maxVoices, float maxDistance) {
+    mMaxVoices = maxVoices;
+    mMaxDistance = maxDistance;
+
+    while (mVoices.size() > mMaxVoices) {
+        release(mVoices.size() - 1);
+    }
+    mStats.Active = static_cast<unsigned>(mVoices.size());
+}
+
+void CVoicePool::Update(const Vector3& listenerPos, const Vector3& listenerRot) {
+    mListenerPos = listenerPos;
+    mBackend.SetListener(listenerPos, RotationToDirection(listenerRot));
+
+    for (size_t i = mVoices.size(); i-- > 0;) {
+        if (!mBackend.IsPlaying(mVoices[i].Voice))
+            release(i);
+    }
+    mStats.Active = static_cast<unsigned>(mVoices.size());
+}
+
+bool CVoicePool::Play(int sample, const Vector3& pos, float volume, float speed) {
+    if (sample < 0 || mMaxVoices == 0 ||
+        Distance(mListenerPos, pos) > mMaxDistance) {
+        ++mStats.Culled;
+        return false;
+    }
+
+    if (mVoices.size() >= mMaxVoices) {
+        auto lowest = std::min_element(mVoices.begin(), mVoices.end(), [this](const SVoice& a, const SVoice& b) {
+            return priority(a.Position, a.Volume) < priority(b.Position, b.Volume);
+        });
+
+        if (priority(lowest->Position, lowest->Volume) > priority(pos, volume)) {
+            ++mStats.Culled;
+            return false;
+        }
+
+        release(lowest - mVoices.begin());
+        ++mStats.Stolen;
+    }
+
+    uint32_t voice = mBackend.Play(sample, pos, volume, speed);
+    if (voice == 0)
+        return false;
+
+    mVoices.push_back({ voice, pos, volume });
+    ++mStats.Played;
+    mStats.Active = static_cast<unsigned>(mVoices.size());
+    return true;
+}
+
+// Roughly how loud it is at the listener. Within the min distance sounds don't get louder.
+float CVoicePool::priority(const Vector3& pos, float volume) const {
+    float distance = std::max(Distance(mListenerPos, pos), mBackend.MinDistance());
+    return volume / distance;
+}
+
+void CVoicePool::release(size_t index) {
+    mBackend.Stop(mVoices[index].Voice);
+    mVoices[index] = mVoices.back();
+    mVoices.pop_back();
+}
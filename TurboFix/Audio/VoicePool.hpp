@@ -0,0 +1,56 @@
+#pragma once
+#include "SoundBackend.hpp"
+
+#include <inc/types.h>
+#include <cstdint>
+#include <vector>
+
+// Limits the amount of sounds playing at once. When full, the voice with the
+// lowest priority (quietest at the listener) is stopped to make room.
+class CVoicePool {
+public:
+    struct SStats {
+        unsigned Active = 0;
+        uint64_t Played = 0;
+        // Requests too far from the listener, or quieter than all playing voices.
+        uint64_t Culled = 0;
+        uint64_t Stolen = 0;
+    };
+
+    CVoicePool(ISoundBackend& backend, unsigned maxVoices, float maxDistance);
+    ~CVoicePool();
+
+    CVoicePool(const CVoicePool&) = delete;
+    CVoicePool& operator=(const CVoicePool&) = delete;
+
+    void SetLimits(unsigned maxVoices, float maxDistance);
+
+    // Call once per tick. Updates the listener and releases finished voices.
+    // listenerRot is a game rotation (degrees), like the camera's.
+    void Update(const Vector3& listenerPos, const Vector3& listenerRot);
+
+    // False if the sound was culled.
+    bool Play(int sample, const Vector3& pos, float volume, float speed = 1.0f);
+
+    const SStats& Stats() const {
+        return mStats;
+    }
+
+private:
+    struct SVoice {
+        uint32_t Voice;
+        Vector3 Position;
+        float Volume;
+    };
+
+    float priority(const Vector3& pos, float volume) const;
+    void release(size_t index);
+
+    ISoundBackend& mBackend;
+    unsigned mMaxVoices;
+    float mMaxDistance;
+
+    Vector3 mListenerPos;
+    std::vector<SVoice> mVoices;
+    SStats mStats;
+};
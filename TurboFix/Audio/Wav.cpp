@@ -0,0 +1,174 @@
+#include "Wav.hpp"
+
+#include "../Util/Logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    template <typename T>
+    bool read(std::ifstream& in, T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    template <typename T>
+    void write(std::ofstream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    constexpr uint16_t FormatPcm = 1;
+    constexpr uint16_t FormatFloat = 3;
+    constexpr uint16_t FormatExtensible = 0xFFFE;
+
+    template <typename T>
+    T load(const uint8_t* bytes) {
+        T value;
+        memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    int16_t floatToPcm16(double value) {
+        return static_cast<int16_t>(std::lround(std::clamp(value, -1.0, 1.0) * 32767.0));
+    }
+
+    // Everything else than 16-bit PCM is converted, the rest of the audio code only knows that.
+    void toPcm16(const std::vector<uint8_t>& data, uint16_t format, uint16_t bitsPerSample,
+        std::vector<int16_t>& samples) {
+        const size_t bytesPerSample = bitsPerSample / 8;
+        samples.resize(data.size() / bytesPerSample);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            const uint8_t* bytes = data.data() + i * bytesPerSample;
+            if (format == FormatFloat) {
+                samples[i] = floatToPcm16(bitsPerSample == 32 ? load<float>(bytes) : load<double>(bytes));
+                continue;
+            }
+            switch (bitsPerSample) {
+                // 8-bit is unsigned.
+                case 8: samples[i] = static_cast<int16_t>((bytes[0] - 128) * 256); break;
+                // Only the high bytes are kept.
+                case 24: samples[i] = static_cast<int16_t>(bytes[1] | bytes[2] << 8); break;
+                case 32: samples[i] = static_cast<int16_t>(bytes[2] | bytes[3] << 8); break;
+            }
+        }
+    }
+}
+
+bool Audio::ReadWav(const std::string& file, SPcm& pcm) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in) {
+        logger.Write(ERROR, "[Wav] Failed to open [%s]", file.c_str());
+        return false;
+    }
+
+    char riff[4], wave[4];
+    uint32_t riffSize;
+    if (!read(in, riff) || !read(in, riffSize) || !read(in, wave) ||
+        memcmp(riff, "RIFF", 4) != 0 || memcmp(wave, "WAVE", 4) != 0) {
+        logger.Write(ERROR, "[Wav] [%s] is not a WAV file", file.c_str());
+        return false;
+    }
+
+    uint16_t format = 0;
+    uint16_t bitsPerSample = 0;
+    bool haveFormat = false;
+
+    char chunkId[4];
+    uint32_t chunkSize;
+    while (read(in, chunkId) && read(in, chunkSize)) {
+        if (memcmp(chunkId, "fmt ", 4) == 0) {
+            if (chunkSize < 16) {
+                logger.Write(ERROR, "[Wav] [%s] has a %u byte format chunk, expected at least 16",
+                    file.c_str(), chunkSize);
+                return false;
+            }
+
+            uint32_t byteRate;
+            uint16_t blockAlign;
+            if (!read(in, format) || !read(in, pcm.Channels) || !read(in, pcm.SampleRate) ||
+                !read(in, byteRate) || !read(in, blockAlign) || !read(in, bitsPerSample))
+                break;
+            uint32_t skip = chunkSize - 16;
+
+            // WAVE_FORMAT_EXTENSIBLE: the actual format is the start of the sub format GUID.
+            if (format == FormatExtensible && chunkSize >= 40) {
+                uint16_t extensionSize, validBits;
+                uint32_t channelMask;
+                if (!read(in, extensionSize) || !read(in, validBits) || !read(in, channelMask) ||
+                    !read(in, format))
+                    break;
+                skip -= 10;
+            }
+            in.seekg(skip + (chunkSize & 1), std::ios::cur);
+            haveFormat = true;
+        }
+        else if (memcmp(chunkId, "data", 4) == 0) {
+            if (!haveFormat) {
+                logger.Write(ERROR, "[Wav] [%s] has audio data before its format", file.c_str());
+                return false;
+            }
+            const bool supported =
+                (format == FormatPcm && (bitsPerSample == 8 || bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32)) ||
+                (format == FormatFloat && (bitsPerSample == 32 || bitsPerSample == 64));
+            if (!supported || pcm.Channels == 0) {
+                logger.Write(ERROR, "[Wav] [%s] is %u-bit format %u, only 8/16/24/32-bit PCM and 32/64-bit float are supported",
+                    file.c_str(), bitsPerSample, format);
+                return false;
+            }
+            // Everything using the samples divides by this.
+            if (pcm.SampleRate == 0) {
+                logger.Write(ERROR, "[Wav] [%s] has a sample rate of 0", file.c_str());
+                return false;
+            }
+
+            if (format == FormatPcm && bitsPerSample == 16) {
+                pcm.Samples.resize(chunkSize / sizeof(int16_t));
+                in.read(reinterpret_cast<char*>(pcm.Samples.data()), pcm.Samples.size() * sizeof(int16_t));
+                pcm.Samples.resize(static_cast<size_t>(in.gcount()) / sizeof(int16_t));
+                return true;
+            }
+
+            std::vector<uint8_t> data(chunkSize);
+            in.read(reinterpret_cast<char*>(data.data()), data.size());
+            data.resize(static_cast<size_t>(in.gcount()));
+            toPcm16(data, format, bitsPerSample, pcm.Samples);
+            return true;
+        }
+        else {
+            in.seekg(chunkSize + (chunkSize & 1), std::ios::cur);
+        }
+    }
+
+    logger.Write(ERROR, "[Wav] [%s] has no audio data", file.c_str());
+    return false;
+}
+
+bool Audio::WriteWav(const std::string& file, const SPcm& pcm) {
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        logger.Write(ERROR, "[Wav] Failed to create [%s]", file.c_str());
+        return false;
+    }
+
+    const uint32_t dataSize = static_cast<uint32_t>(pcm.Samples.size() * sizeof(int16_t));
+    const uint16_t blockAlign = static_cast<uint16_t>(pcm.Channels * sizeof(int16_t));
+
+    out.write("RIFF", 4);
+    write(out, static_cast<uint32_t>(36 + dataSize));
+    out.write("WAVE", 4);
+
+    out.write("fmt ", 4);
+    write(out, static_cast<uint32_t>(16));
+    write(out, static_cast<uint16_t>(1));
+    write(out, pcm.Channels);
+    write(out, pcm.SampleRate);
+    write(out, static_cast<uint32_t>(pcm.SampleRate * blockAlign));
+    write(out, blockAlign);
+    write(out, static_cast<uint16_t>(16));
+
+    out.write("data", 4);
+    write(out, dataSize);
+    out.write(reinterpret_cast<const char*>(pcm.Samples.data()), dataSize);
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Audio {
+// 16-bit PCM, interleaved when there's more than one channel.
+struct SPcm {
+    uint32_t SampleRate = 0;
+    uint16_t Channels = 0;
+    std::vector<int16_t> Samples;
+
+    size_t FrameCount() const {
+        return Channels == 0 ? 0 : Samples.size() / Channels;
+    }
+};
+
+// Reads uncompressed WAV files: 8, 16, 24 or 32-bit PCM, or 32 or 64-bit float,
+// also with WAVE_FORMAT_EXTENSIBLE headers. Converted to 16-bit PCM.
+bool ReadWav(const std::string& file, SPcm& pcm);
+bool WriteWav(const std::string& file, const SPcm& pcm);
+}
@@ -82,6 +82,8 @@ public:
 
         // "Default", "NoSound" or some custom stuff
         std::string SoundSet = "Default";
+        // Index of SoundSet in the loaded sound sets, resolved after loading. Not saved.
+        int SoundSetIndex = 0;
         float Volume = 0.25f;
     } AntiLag;
 
@@ -4,6 +4,7 @@
 #include "Memory/Patches.h"
 #include "Memory/VehicleExtensions.hpp"
 #include "Memory/Versions.hpp"
+#include "Util/BinaryLog.hpp"
 #include "Util/FileVersion.hpp"
 #include "Util/Logger.hpp"
 #include "Util/Paths.hpp"
@@ -96,13 +97,7 @@ BOOL APIENTRY DllMain(HMODULE hInstance, DWORD reason, LPVOID lpReserved) {
         }
         case DLL_PROCESS_DETACH: {
             logger.Write(INFO, "[PATCH] Restore patches");
-            const uint8_t expected = 1;
-            uint8_t actual = 0;
-
-            if (Patches::PatchBoostLimiter(false))
-                actual++;
-
-            if (actual == expected) {
+            if (Patches::RestoreAll()) {
                 logger.Write(INFO, "[PATCH] Script shut down cleanly");
             }
             else {
@@ -111,6 +106,13 @@ BOOL APIENTRY DllMain(HMODULE hInstance, DWORD reason, LPVOID lpReserved) {
 
             Compatibility::Release();
             scriptUnregister(hInstance);
+            BinaryLog::Stop();
+
+            // lpReserved is set when the process is exiting. Its other threads are
+            // gone then, maybe while holding the log's file mutex, so don't wait
+            // for it. The logger's destructor writes what it can.
+            if (lpReserved == nullptr)
+                logger.Flush();
             break;
         }
         default:
@@ -3,25 +3,36 @@
 #include "../Util/Logger.hpp"
 #include <Windows.h>
 #include <Psapi.h>
-#include <sstream>
 
 #include "inc/main.h"
 
 namespace {
-    template<typename Out>
-    void split(const std::string& s, char delim, Out result) {
-        std::stringstream ss;
-        ss.str(s);
-        std::string item;
-        while (std::getline(ss, item, delim)) {
-            *(result++) = item;
-        }
+    struct SModuleRange {
+        const uint8_t* Start;
+        size_t Size;
+    };
+
+    const SModuleRange& moduleRange() {
+        static const SModuleRange range = []() {
+            MODULEINFO modInfo{};
+            GetModuleInformation(GetCurrentProcess(), GetModuleHandle(nullptr), &modInfo, sizeof(MODULEINFO));
+            return SModuleRange{
+                static_cast<const uint8_t*>(modInfo.lpBaseOfDll),
+                static_cast<size_t>(modInfo.SizeOfImage)
+            };
+        }();
+        return range;
     }
 
-    std::vector<std::string> split(const std::string& s, char delim) {
-        std::vector<std::string> elems;
-        ::split(s, delim, std::back_inserter(elems));
-        return elems;
+    void logScan(LogLevel level, const char* prefix, const mem::SPatternScan& scan) {
+        char operand[24] = "no operand";
+        if (scan.HasOperand)
+            snprintf(operand, sizeof(operand), "operand 0x%X", static_cast<uint32_t>(scan.Operand));
+
+        logger.Write(level, "[Sig] %s[%s] offset 0x%llX, %u match(es) (%s), %s, %.3f ms",
+            prefix, scan.Name.c_str(), static_cast<unsigned long long>(scan.Offset), scan.Matches,
+            scan.Matches == 1 ? "unique" : (scan.Matches == 0 ? "not found" : "ambiguous"), operand,
+            scan.ScanTimeMs);
     }
 }
 
@@ -33,32 +44,19 @@ namespace mem {
     uintptr_t(*GetModelInfo)(unsigned int modelHash, int* index) = nullptr;
 
     void init() {
-        auto addr = FindPattern("\x83\xF9\xFF\x74\x31\x4C\x8B\x0D\x00\x00\x00\x00\x44\x8B\xC1\x49\x8B\x41\x08",
-                                                            "xxxxxxxx????xxxxxxx");
+        auto addr = FindPattern(Signatures::GetAddressOfEntity);
         if (!addr) logger.Write(ERROR, "Couldn't find GetAddressOfEntity");
         GetAddressOfEntity = reinterpret_cast<uintptr_t(*)(int)>(addr);
 
         if (g_gameVersion < 58) {
-            addr = FindPattern(
-                "\x0F\xB7\x05\x00\x00\x00\x00"
-                "\x45\x33\xC9\x4C\x8B\xDA\x66\x85\xC0"
-                "\x0F\x84\x00\x00\x00\x00"
-                "\x44\x0F\xB7\xC0\x33\xD2\x8B\xC1\x41\xF7\xF0\x48"
-                "\x8B\x05\x00\x00\x00\x00"
-                "\x4C\x8B\x14\xD0\xEB\x09\x41\x3B\x0A\x74\x54",
-                "xxx????"
-                "xxxxxxxxx"
-                "xx????"
-                "xxxxxxxxxxxx"
-                "xx????"
-                "xxxxxxxxxxx");
+            addr = FindPattern(Signatures::GetModelInfo);
 
             if (!addr) {
                 logger.Write(ERROR, "Couldn't find GetModelInfo");
             }
         }
         else {
-            addr = FindPattern("\xEB\x09\x41\x3B\x0A\x74\x54", "xxxxxxx");
+            addr = FindPattern(Signatures::GetModelInfo58);
             if (!addr) {
                 logger.Write(ERROR, "Couldn't find GetModelInfo (v58+)");
             }
@@ -69,82 +67,56 @@ namespace mem {
     }
 
     uintptr_t FindPattern(const char* pattern, const char* mask) {
-        MODULEINFO modInfo = { nullptr };
-        GetModuleInformation(GetCurrentProcess(), GetModuleHandle(nullptr), &modInfo, sizeof(MODULEINFO));
-
-        const char* start_offset = reinterpret_cast<const char *>(modInfo.lpBaseOfDll);
-        const uintptr_t size = static_cast<uintptr_t>(modInfo.SizeOfImage);
+        return FindPattern(moduleRange().Start, moduleRange().Size, pattern, mask);
+    }
 
-        intptr_t pos = 0;
-        const uintptr_t searchLen = static_cast<uintptr_t>(strlen(mask) - 1);
+    uintptr_t FindPattern(const char* pattStr) {
+        return FindPattern(moduleRange().Start, moduleRange().Size, pattStr);
+    }
 
-        for (const char* retAddress = start_offset; retAddress < start_offset + size; retAddress++) {
-            if (*retAddress == pattern[pos] || mask[pos] == '?') {
-                if (mask[pos + 1] == '\0')
-                    return (reinterpret_cast<uintptr_t>(retAddress) - searchLen);
-                pos++;
-            }
-            else {
-                pos = 0;
-            }
-        }
-        return 0;
+    uintptr_t FindPattern(const Signatures::SSignature& signature) {
+        return FindPattern(moduleRange().Start, moduleRange().Size, signature);
     }
 
     std::vector<uintptr_t> FindPatterns(const char* pattern, const char* mask) {
-        std::vector <uintptr_t> addresses;
-
-        MODULEINFO modInfo = { nullptr };
-        GetModuleInformation(GetCurrentProcess(), GetModuleHandle(nullptr), &modInfo, sizeof(MODULEINFO));
-
-        const char* start_offset = reinterpret_cast<const char *>(modInfo.lpBaseOfDll);
-        const uintptr_t size = static_cast<uintptr_t>(modInfo.SizeOfImage);
-
-        intptr_t pos = 0;
-        const uintptr_t searchLen = static_cast<uintptr_t>(strlen(mask) - 1);
-
-        for (const char* retAddress = start_offset; retAddress < start_offset + size; retAddress++) {
-            if (*retAddress == pattern[pos] || mask[pos] == '?') {
-                if (mask[pos + 1] == '\0')
-                    addresses.push_back(reinterpret_cast<uintptr_t>(retAddress) - searchLen);
-                pos++;
-            }
-            else {
-                pos = 0;
-            }
-        }
-        return addresses;
+        return FindPatterns(moduleRange().Start, moduleRange().Size, pattern, mask);
     }
 
-    uintptr_t FindPattern(const char* pattStr) {
-        std::vector<std::string> bytesStr = split(pattStr, ' ');
-
-        MODULEINFO modInfo{};
-        GetModuleInformation(GetCurrentProcess(), GetModuleHandle(nullptr), &modInfo, sizeof(MODULEINFO));
+    void WriteScanReport(const std::string& file, const std::string& header) {
+        SScanReport previous;
+        bool compare = ReadScanReport(file, previous) && !previous.Scans.empty();
+        if (compare)
+            logger.Write(INFO, "[Sig] Comparing with previous report [%s]", previous.Header.c_str());
 
-        auto* start_offset = static_cast<uint8_t*>(modInfo.lpBaseOfDll);
-        const auto size = static_cast<uintptr_t>(modInfo.SizeOfImage);
+        SScanReport current{ header, GetScanReport() };
 
-        uintptr_t pos = 0;
-        const uintptr_t searchLen = bytesStr.size();
-        std::vector<uint8_t> bytes;
-        // Thanks Zolika for the performance improvement!
-        for (const auto& str : bytesStr) {
-            if (str == "??" || str == "?") bytes.push_back(0);
-            else bytes.push_back(static_cast<uint8_t>(std::strtoul(str.c_str(), nullptr, 16)));
+        double totalTimeMs = 0.0;
+        for (const auto& scan : current.Scans) {
+            totalTimeMs += scan.ScanTimeMs;
+            logScan(scan.Matches == 1 ? DEBUG : (scan.Matches == 0 ? ERROR : WARN), "", scan);
         }
 
-        for (auto* retAddress = start_offset; retAddress < start_offset + size; retAddress++) {
-            if (bytesStr[pos] == "??" || bytesStr[pos] == "?" ||
-                *retAddress == bytes[pos]) {
-                if (pos + 1 == bytesStr.size())
-                    return (reinterpret_cast<uintptr_t>(retAddress) - searchLen + 1);
-                pos++;
-            }
-            else {
-                pos = 0;
+        if (compare) {
+            for (const auto& change : DiffScanReports(previous, current)) {
+                switch (change.Kind) {
+                    case SScanChange::EKind::Added:
+                        logger.Write(INFO, "[Sig] [%s] New signature", change.After.Name.c_str());
+                        break;
+                    case SScanChange::EKind::Removed:
+                        logger.Write(INFO, "[Sig] [%s] No longer scanned", change.Before.Name.c_str());
+                        break;
+                    case SScanChange::EKind::Changed:
+                        logScan(INFO, "Was: ", change.Before);
+                        logScan(change.After.Matches == 1 ? INFO : WARN, "Now: ", change.After);
+                        break;
+                }
             }
         }
-        return 0;
+
+        logger.Write(INFO, "[Sig] %llu signatures scanned in %.3f ms",
+            static_cast<unsigned long long>(current.Scans.size()), totalTimeMs);
+
+        if (!SaveScanReport(file, current))
+            logger.Write(ERROR, "[Sig] Couldn't write [%s]", file.c_str());
     }
 }
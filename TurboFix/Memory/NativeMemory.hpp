@@ -1,12 +1,22 @@
 #pragma once
+#include "PatternScan.hpp"
+
 #include <cstdint>
+#include <string>
 #include <vector>
 
 namespace mem {
 void init();
-uintptr_t FindPattern(const char* pattern, const char* mask); 
+
+// Scans the game's image. The range based ones are in PatternScan.hpp.
+uintptr_t FindPattern(const char* pattern, const char* mask);
 uintptr_t FindPattern(const char* pattStr);
+uintptr_t FindPattern(const Signatures::SSignature& signature);
 std::vector<uintptr_t> FindPatterns(const char* pattern, const char* mask);
+
+// Writes the recorded scans to file, and logs differences with the previous report in that file.
+void WriteScanReport(const std::string& file, const std::string& header);
+
 extern uintptr_t(*GetAddressOfEntity)(int entity);
 extern uintptr_t(*GetModelInfo)(unsigned int modelHash, int* index);
 }
@@ -207,7 +207,7 @@ const struct CVehicleHandlingData_1604 {
 } hOffsets1604 = {};
 
 // 1032
-const struct CWheel {
+struct CWheel {
     // Wheel stuff:
     // 20: offset from body?
     // 30: Similar-ish?
@@ -3,6 +3,8 @@
 #include "PatternInfo.h"
 #include "../Util/Logger.hpp"
 #include "../Util/String.hpp"
+#include <chrono>
+#include <cstring>
 #include <string>
 #include <utility>
 
@@ -18,7 +20,9 @@ public:
         , mAttempts(0)
         , mPatched(false)
         , mAddress(0)
-        , mTemp(0) { }
+        , mTemp(0)
+        , mResolved(false)
+        , mScanTimeMs(0.0) { }
 
     Patcher(std::string name, PatternInfo& pattern) 
         : Patcher(std::move(name), pattern, false) { }
@@ -35,10 +39,10 @@ public:
             return true;
         }
 
-        mTemp = Apply();
+        uintptr_t address = Apply();
 
-        if (mTemp) {
-            mAddress = mTemp;
+        if (address) {
+            mAddress = address;
             mPatched = true;
             mAttempts = 0;
 
@@ -85,20 +89,66 @@ public:
         return false;
     }
 
-    uintptr_t Test() const {
-        auto addr = mem::FindPattern(mPattern.Pattern, mPattern.Mask);
-        if (addr)
-            logger.Write(DEBUG, "[Patch] Test: [%s] found at 0x%p", mName.c_str(), addr);
-        else
-            logger.Write(ERROR, "[Patch] Test: [%s] not found", mName.c_str());
+    // Scans for the pattern once. Later calls (and Apply) re-use the resolved address.
+    uintptr_t Test() {
+        if (mResolved)
+            return mTemp;
+
+        auto tStart = std::chrono::steady_clock::now();
+        // Named, so the signature report matches Signatures.hpp.
+        auto addr = mem::FindPattern(Signatures::SSignature{ mName.c_str(), mPattern.Pattern, mPattern.Mask, Signatures::NoOperand });
+        auto tEnd = std::chrono::steady_clock::now();
+        mScanTimeMs = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+        mResolved = true;
+
+        if (addr) {
+            mTemp = addr + mPattern.Offset;
+            logger.Write(DEBUG, "[Patch] Test: [%s] found at 0x%p (%.3f ms)", mName.c_str(), mTemp, mScanTimeMs);
+        }
+        else {
+            mTemp = 0;
+            logger.Write(ERROR, "[Patch] Test: [%s] not found (%.3f ms)", mName.c_str(), mScanTimeMs);
+        }
+
+        return mTemp;
+    }
+
+    // Checks the resolved address still has the code the pattern describes,
+    // so nothing else (e.g. another mod) has already changed it.
+    bool Validate() const {
+        if (!mTemp)
+            return false;
 
-        return addr;
+        auto code = reinterpret_cast<const uint8_t*>(mTemp - mPattern.Offset);
+        const size_t len = strlen(mPattern.Mask);
+        for (size_t i = 0; i < len; ++i) {
+            if (mPattern.Mask[i] != '?' && code[i] != static_cast<uint8_t>(mPattern.Pattern[i]))
+                return false;
+        }
+        return true;
     }
 
     bool Patched() const {
         return mPatched;
     }
 
+    const std::string& Name() const {
+        return mName;
+    }
+
+    // 0 when not (yet) found.
+    uintptr_t Address() const {
+        return mTemp;
+    }
+
+    bool Resolved() const {
+        return mResolved;
+    }
+
+    double ScanTimeMs() const {
+        return mScanTimeMs;
+    }
+
 protected:
     const std::string mName;
     PatternInfo& mPattern;
@@ -108,23 +158,24 @@ protected:
     int mAttempts;
     bool mPatched;
     uintptr_t mAddress;
+    // Resolved address (pattern + offset), shared by Test and Apply.
     uintptr_t mTemp;
+    bool mResolved;
+    double mScanTimeMs;
 
-    virtual uintptr_t Apply() {
-        uintptr_t address;
-        if (mTemp != NULL) {
-            address = mTemp;
-        }
-        else {
-            address = mem::FindPattern(mPattern.Pattern, mPattern.Mask);
-            if (address) {
-                address += mPattern.Offset;
-                logger.Write(DEBUG, "[Patch] [%s] found at 0x%p", mName.c_str(), address);
-            }
-            else {
-                logger.Write(ERROR, "[Patch] [%s] not found", mName.c_str());
-            }
+    uintptr_t resolve() {
+        if (!Test())
+            return 0;
+
+        if (!Validate()) {
+            logger.Write(ERROR, "[Patch] [%s] Unexpected code at 0x%p", mName.c_str(), mTemp);
+            return 0;
         }
+        return mTemp;
+    }
+
+    virtual uintptr_t Apply() {
+        uintptr_t address = resolve();
 
         if (address) {
             memcpy(mPattern.Data.data(), (void*)address, mPattern.Data.size());
@@ -145,20 +196,7 @@ public:
 
 protected:
     uintptr_t Apply() override {
-        uintptr_t address;
-        if (mTemp != NULL) {
-            address = mTemp;
-        }
-        else {
-            address = mem::FindPattern(mPattern.Pattern, mPattern.Mask);
-            if (address) {
-                address += mPattern.Offset;
-                logger.Write(DEBUG, "[Patch] [%s] found at 0x%p", mName.c_str(), address);
-            }
-            else {
-                logger.Write(ERROR, "[Patch] [%s] not found", mName.c_str());
-            }
-        }
+        uintptr_t address = resolve();
 
         if (address) {
             uint8_t instrArr[6] =
@@ -2,21 +2,36 @@
 
 #include "Patcher.h"
 #include "PatternInfo.h"
+#include "Signatures.hpp"
 
-// When disabled, shift-up doesn't trigger.
-MemoryPatcher::PatternInfo boostLimiter;
-MemoryPatcher::Patcher BoostLimiterPatcher("Boost Limiter", boostLimiter, true);
+namespace {
+    // When disabled, shift-up doesn't trigger.
+    MemoryPatcher::PatternInfo boostLimiter;
+    MemoryPatcher::Patcher BoostLimiterPatcher("Boost Limiter", boostLimiter, true);
+
+    std::vector<MemoryPatcher::Patcher*> patchers {
+        &BoostLimiterPatcher,
+    };
+
+    bool setPatched(MemoryPatcher::Patcher& patcher, bool enable) {
+        if (enable == patcher.Patched())
+            return true;
+        return enable ? patcher.Patch() : patcher.Restore();
+    }
+}
 
 bool Patches::Error = false;
 
 void Patches::SetPatterns() {
-    boostLimiter = MemoryPatcher::PatternInfo("\xC7\x43\x7C\x00\x00\x80\x3F\x48\x8B\xCE", 
-        "xxxxxxxxxx", {0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90});
+    boostLimiter = MemoryPatcher::PatternInfo(Signatures::BoostLimiter.Pattern,
+        Signatures::BoostLimiter.Mask, {0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90});
 }
 
 bool Patches::Test() {
     bool success = true;
-    success &= 0 != BoostLimiterPatcher.Test();
+    for (auto* patcher : patchers) {
+        success &= 0 != patcher->Test();
+    }
     return success;
 }
 
@@ -24,20 +39,27 @@ bool Patches::PatchBoostLimiter(bool enable) {
     if (Error)
         return false;
 
-    if (enable) {
-        if (!BoostLimiterPatcher.Patched()) {
-            return BoostLimiterPatcher.Patch();
-        }
-        else {
-            return true;
-        }
+    return setPatched(BoostLimiterPatcher, enable);
+}
+
+bool Patches::RestoreAll() {
+    bool success = true;
+    for (auto* patcher : patchers) {
+        success &= setPatched(*patcher, false);
     }
-    else {
-        if (BoostLimiterPatcher.Patched()) {
-            return BoostLimiterPatcher.Restore();
-        }
-        else {
-            return true;
-        }
+    return success;
+}
+
+std::vector<Patches::SPatchStatus> Patches::GetStatus() {
+    std::vector<SPatchStatus> status;
+    for (auto* patcher : patchers) {
+        status.push_back({
+            patcher->Name(),
+            patcher->Address() != 0,
+            patcher->Patched(),
+            patcher->Address(),
+            patcher->ScanTimeMs()
+        });
     }
+    return status;
 }
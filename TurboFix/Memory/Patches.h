@@ -1,8 +1,28 @@
 #pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace Patches {
+    struct SPatchStatus {
+        std::string Name;
+        bool Found;
+        bool Patched;
+        uintptr_t Address;
+        double ScanTimeMs;
+    };
+
     void SetPatterns();
+
+    // Resolves all patch addresses once. False if any aren't found.
     bool Test();
 
     bool PatchBoostLimiter(bool enable);
+
+    // Restores all applied patches. False if any couldn't be restored.
+    bool RestoreAll();
+
+    std::vector<SPatchStatus> GetStatus();
+
     extern bool Error;
 }
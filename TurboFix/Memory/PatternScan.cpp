@@ -0,0 +1,258 @@
+#include "PatternScan.hpp"
+
+#include "../Util/String.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace {
+    template<typename Out>
+    void split(const std::string& s, char delim, Out result) {
+        std::stringstream ss;
+        ss.str(s);
+        std::string item;
+        while (std::getline(ss, item, delim)) {
+            *(result++) = item;
+        }
+    }
+
+    std::vector<std::string> split(const std::string& s, char delim) {
+        std::vector<std::string> elems;
+        ::split(s, delim, std::back_inserter(elems));
+        return elems;
+    }
+
+    struct SPattern {
+        std::vector<uint8_t> Bytes;
+        // 0 for wildcards
+        std::vector<uint8_t> Compare;
+        std::string Text;
+    };
+
+    SPattern parsePattern(const char* pattStr) {
+        SPattern patt;
+        for (const auto& str : split(pattStr, ' ')) {
+            if (str.empty())
+                continue;
+            bool wildcard = str == "??" || str == "?";
+            patt.Bytes.push_back(wildcard ? 0 : static_cast<uint8_t>(std::strtoul(str.c_str(), nullptr, 16)));
+            patt.Compare.push_back(wildcard ? 0 : 1);
+        }
+        patt.Text = pattStr;
+        return patt;
+    }
+
+    SPattern parsePattern(const char* pattern, const char* mask) {
+        SPattern patt;
+        const size_t len = strlen(mask);
+        for (size_t i = 0; i < len; ++i) {
+            bool wildcard = mask[i] == '?';
+            patt.Bytes.push_back(wildcard ? 0 : static_cast<uint8_t>(pattern[i]));
+            patt.Compare.push_back(wildcard ? 0 : 1);
+        }
+        patt.Text = Util::ByteArrayToString(patt.Bytes.data(), patt.Bytes.size());
+        // Display wildcards the same way the string patterns do.
+        for (size_t i = 0; i < len; ++i) {
+            if (!patt.Compare[i])
+                patt.Text.replace(i * 3, 2, "??");
+        }
+        Util::rtrim(patt.Text);
+        return patt;
+    }
+
+    SPattern parsePattern(const Signatures::SSignature& signature) {
+        return signature.Mask ? parsePattern(signature.Pattern, signature.Mask) : parsePattern(signature.Pattern);
+    }
+
+    // Calls onMatch for each match, until it returns false.
+    template <typename Fn>
+    void scan(const uint8_t* start, size_t size, const SPattern& patt, Fn onMatch) {
+        const size_t len = patt.Bytes.size();
+        if (len == 0 || size < len)
+            return;
+
+        const uint8_t* last = start + size - len;
+        for (const uint8_t* curr = start; curr <= last; ++curr) {
+            size_t i = 0;
+            while (i < len && (!patt.Compare[i] || curr[i] == patt.Bytes[i]))
+                ++i;
+            if (i == len && !onMatch(curr))
+                return;
+        }
+    }
+
+    bool scanReportEnabled = false;
+    std::vector<mem::SPatternScan> scanReport;
+
+    void recordScan(const mem::SPatternScan& result) {
+        auto it = std::find_if(scanReport.begin(), scanReport.end(), [&](const auto& other) {
+            return other.Name == result.Name;
+        });
+
+        if (it != scanReport.end())
+            *it = result;
+        else
+            scanReport.push_back(result);
+    }
+
+    // name is the pattern text when the scan isn't for a known signature.
+    uintptr_t findPattern(const uint8_t* start, size_t size, const SPattern& patt,
+                          const char* name, int operand) {
+        uintptr_t address = 0;
+        if (!scanReportEnabled) {
+            scan(start, size, patt, [&](const uint8_t* match) {
+                address = reinterpret_cast<uintptr_t>(match);
+                return false;
+            });
+            return address;
+        }
+
+        // Report mode: don't stop at the first match, to know if the pattern is ambiguous.
+        uint32_t matches = 0;
+        auto tStart = std::chrono::steady_clock::now();
+        scan(start, size, patt, [&](const uint8_t* match) {
+            if (matches++ == 0)
+                address = reinterpret_cast<uintptr_t>(match);
+            return true;
+        });
+        auto tEnd = std::chrono::steady_clock::now();
+
+        mem::SPatternScan result{ name ? name : patt.Text, patt.Text, 0, matches, false, 0,
+            std::chrono::duration<double, std::milli>(tEnd - tStart).count() };
+
+        if (address != 0) {
+            result.Offset = address - reinterpret_cast<uintptr_t>(start);
+            // Skip operands that would fall outside the range.
+            int64_t operandOffset = static_cast<int64_t>(result.Offset) + operand;
+            if (operand != Signatures::NoOperand && operandOffset >= 0 &&
+                static_cast<uint64_t>(operandOffset) + sizeof(int32_t) <= size) {
+                memcpy(&result.Operand, start + operandOffset, sizeof(int32_t));
+                result.HasOperand = true;
+            }
+        }
+        recordScan(result);
+        return address;
+    }
+
+    bool sameScan(const mem::SPatternScan& a, const mem::SPatternScan& b) {
+        return a.Pattern == b.Pattern &&
+            a.Matches == b.Matches &&
+            a.HasOperand == b.HasOperand &&
+            (!a.HasOperand || a.Operand == b.Operand);
+    }
+}
+
+namespace mem {
+    uintptr_t FindPattern(const uint8_t* start, size_t size, const char* pattern, const char* mask) {
+        return findPattern(start, size, parsePattern(pattern, mask), nullptr, Signatures::NoOperand);
+    }
+
+    uintptr_t FindPattern(const uint8_t* start, size_t size, const char* pattStr) {
+        return findPattern(start, size, parsePattern(pattStr), nullptr, Signatures::NoOperand);
+    }
+
+    uintptr_t FindPattern(const uint8_t* start, size_t size, const Signatures::SSignature& signature) {
+        return findPattern(start, size, parsePattern(signature), signature.Name, signature.Operand);
+    }
+
+    std::vector<uintptr_t> FindPatterns(const uint8_t* start, size_t size, const char* pattern, const char* mask) {
+        std::vector<uintptr_t> addresses;
+        scan(start, size, parsePattern(pattern, mask), [&](const uint8_t* match) {
+            addresses.push_back(reinterpret_cast<uintptr_t>(match));
+            return true;
+        });
+        return addresses;
+    }
+
+    void SetScanReport(bool enable) {
+        scanReportEnabled = enable;
+        if (enable)
+            scanReport.clear();
+    }
+
+    const std::vector<SPatternScan>& GetScanReport() {
+        return scanReport;
+    }
+
+    bool ReadScanReport(const std::string& file, SScanReport& report) {
+        std::ifstream inFile(file);
+        if (!inFile.is_open())
+            return false;
+
+        report = SScanReport{};
+        for (std::string line; std::getline(inFile, line);) {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            if (line.rfind("# ", 0) == 0) {
+                report.Header = line.substr(2);
+                continue;
+            }
+
+            auto fields = ::split(line, '|');
+            if (fields.size() < 6)
+                continue;
+
+            SPatternScan scan{};
+            scan.Name = fields[0];
+            scan.Pattern = fields[1];
+            scan.Offset = static_cast<uintptr_t>(std::strtoull(fields[2].c_str(), nullptr, 16));
+            scan.Matches = static_cast<uint32_t>(std::strtoul(fields[3].c_str(), nullptr, 10));
+            scan.HasOperand = !fields[4].empty();
+            scan.Operand = static_cast<int32_t>(std::strtoul(fields[4].c_str(), nullptr, 16));
+            scan.ScanTimeMs = std::strtod(fields[5].c_str(), nullptr);
+            report.Scans.push_back(scan);
+        }
+        return true;
+    }
+
+    bool SaveScanReport(const std::string& file, const SScanReport& report) {
+        std::ofstream outFile(file, std::ofstream::out | std::ofstream::trunc);
+        if (!outFile.is_open())
+            return false;
+
+        outFile << "# " << report.Header << "\n";
+        for (const auto& scan : report.Scans) {
+            char operand[16] = "";
+            if (scan.HasOperand)
+                snprintf(operand, sizeof(operand), "%X", static_cast<uint32_t>(scan.Operand));
+
+            char line[96];
+            snprintf(line, sizeof(line), "|%llX|%u|%s|%.3f",
+                static_cast<unsigned long long>(scan.Offset), scan.Matches, operand, scan.ScanTimeMs);
+            outFile << scan.Name << "|" << scan.Pattern << line << "\n";
+        }
+        return true;
+    }
+
+    std::vector<SScanChange> DiffScanReports(const SScanReport& before, const SScanReport& after) {
+        std::map<std::string, const SPatternScan*> remaining;
+        for (const auto& scan : before.Scans) {
+            remaining[scan.Name] = &scan;
+        }
+
+        std::vector<SScanChange> changes;
+        for (const auto& scan : after.Scans) {
+            auto it = remaining.find(scan.Name);
+            if (it == remaining.end()) {
+                changes.push_back({ SScanChange::EKind::Added, {}, scan });
+                continue;
+            }
+
+            if (!sameScan(*it->second, scan))
+                changes.push_back({ SScanChange::EKind::Changed, *it->second, scan });
+            remaining.erase(it);
+        }
+
+        for (const auto& scan : before.Scans) {
+            if (remaining.count(scan.Name))
+                changes.push_back({ SScanChange::EKind::Removed, scan, {} });
+        }
+        return changes;
+    }
+}
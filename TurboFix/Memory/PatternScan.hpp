@@ -0,0 +1,60 @@
+#pragma once
+#include "Signatures.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Pattern scanning on an arbitrary memory range, and the signature report.
+// No game or Windows dependencies, so tools/SigScan can scan a dumped image
+// with the same code.
+namespace mem {
+struct SPatternScan {
+    std::string Name;
+    std::string Pattern;
+    // Offset from the start of the range, 0 when not found.
+    uintptr_t Offset;
+    // 1 is unique, anything above is ambiguous.
+    uint32_t Matches;
+    // Operand at the first match, when the signature has one.
+    bool HasOperand;
+    int32_t Operand;
+    double ScanTimeMs;
+};
+
+struct SScanReport {
+    std::string Header;
+    std::vector<SPatternScan> Scans;
+};
+
+struct SScanChange {
+    enum class EKind {
+        Added,
+        Removed,
+        // Match count, operand or pattern differ. Moved code alone isn't a change.
+        Changed,
+    };
+
+    EKind Kind;
+    SPatternScan Before;
+    SPatternScan After;
+};
+
+uintptr_t FindPattern(const uint8_t* start, size_t size, const char* pattStr);
+uintptr_t FindPattern(const uint8_t* start, size_t size, const char* pattern, const char* mask);
+uintptr_t FindPattern(const uint8_t* start, size_t size, const Signatures::SSignature& signature);
+std::vector<uintptr_t> FindPatterns(const uint8_t* start, size_t size, const char* pattern, const char* mask);
+
+// When enabled, every FindPattern call also counts all matches in the range and
+// records the result, so signatures can be checked against a new game build.
+void SetScanReport(bool enable);
+const std::vector<SPatternScan>& GetScanReport();
+
+// Report files have one "name|pattern|offset|matches|operand|ms" line per scan.
+bool ReadScanReport(const std::string& file, SScanReport& report);
+bool SaveScanReport(const std::string& file, const SScanReport& report);
+
+// Matched by name, in the order of after, then anything only in before.
+std::vector<SScanChange> DiffScanReports(const SScanReport& before, const SScanReport& after);
+}
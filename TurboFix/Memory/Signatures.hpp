@@ -0,0 +1,171 @@
+#pragma once
+#include <climits>
+
+// Every code signature the script scans for. Shared with tools/SigScan, so a
+// dumped game image can be checked against the same set, so keep this free of
+// game and Windows dependencies.
+// Signatures that changed with a game version have one entry per variant.
+namespace Signatures {
+    // The signature is used for its address only.
+    constexpr int NoOperand = INT_MIN;
+
+    struct SSignature {
+        const char* Name;
+        // "48 8B ? ?" style when Mask is nullptr, raw bytes otherwise.
+        const char* Pattern;
+        // 'x' to compare, '?' to skip.
+        const char* Mask;
+        // Where the instruction's 32-bit operand (usually a struct offset) is, relative to the match.
+        int Operand;
+    };
+
+    // NativeMemory
+    inline constexpr SSignature GetAddressOfEntity{ "GetAddressOfEntity",
+        "\x83\xF9\xFF\x74\x31\x4C\x8B\x0D\x00\x00\x00\x00\x44\x8B\xC1\x49\x8B\x41\x08",
+        "xxxxxxxx????xxxxxxx", NoOperand };
+
+    inline constexpr SSignature GetModelInfo{ "GetModelInfo (before v58)",
+        "\x0F\xB7\x05\x00\x00\x00\x00"
+        "\x45\x33\xC9\x4C\x8B\xDA\x66\x85\xC0"
+        "\x0F\x84\x00\x00\x00\x00"
+        "\x44\x0F\xB7\xC0\x33\xD2\x8B\xC1\x41\xF7\xF0\x48"
+        "\x8B\x05\x00\x00\x00\x00"
+        "\x4C\x8B\x14\xD0\xEB\x09\x41\x3B\x0A\x74\x54",
+        "xxx????"
+        "xxxxxxxxx"
+        "xx????"
+        "xxxxxxxxxxxx"
+        "xx????"
+        "xxxxxxxxxxx", NoOperand };
+
+    // The function starts 0x2C before the match.
+    inline constexpr SSignature GetModelInfo58{ "GetModelInfo (v58+)",
+        "\xEB\x09\x41\x3B\x0A\x74\x54", "xxxxxxx", NoOperand };
+
+    // TurboScript. The function starts 0x39 before the match.
+    inline constexpr SSignature GetExhaust{ "CVehicle::GetExhaust",
+        "48 8B D9 44 0F 29 48 ? 48 8B 41 20 48 8B 80 ? ? ? ? 48 8B 00", nullptr, NoOperand };
+
+    // Patches
+    inline constexpr SSignature BoostLimiter{ "Boost Limiter",
+        "\xC7\x43\x7C\x00\x00\x80\x3F\x48\x8B\xCE", "xxxxxxxxxx", NoOperand };
+
+    // VehicleExtensions
+    inline constexpr SSignature HoverTransform{ "Hover Transform",
+        "\xF3\x0F\x11\xB3\x00\x00\x00\x00\x44\x88\x00\x00\x00\x00\x00\x48\x85\xC9",
+        "xxxx????xx?????xxx", 4 };
+
+    inline constexpr SSignature Gear{ "Gear",
+        "\x48\x8D\x8F\x00\x00\x00\x00\x4C\x8B\xC3\xF3\x0F\x11\x7C\x24",
+        "xxx????xxxxxxxx", 3 };
+
+    inline constexpr SSignature RPM{ "RPM",
+        "\x76\x03\x0F\x28\xF0\xF3\x44\x0F\x10\x93",
+        "xxxxxxxxxx", 10 };
+
+    inline constexpr SSignature Steering{ "Steering",
+        "\x74\x0A\xF3\x0F\x11\xB3\x1C\x09\x00\x00\xEB\x25", "xxxxxx????xx", 6 };
+
+    inline constexpr SSignature Wheels{ "Wheels",
+        "\x3B\xB7\x48\x0B\x00\x00\x7D\x0D", "xx????xx", 2 };
+
+    inline constexpr SSignature WheelFlags{ "Wheel Flags",
+        "\x75\x11\x48\x8b\x01\x8b\x88", "xxxxxxx", 7 };
+
+    inline constexpr SSignature WheelCompression{ "Wheel Compression",
+        "\x45\x0f\x57\xc9\xf3\x0f\x11\x83\x60\x01\x00\x00\xf3\x0f\x5c", "xxx?xxx???xxxxx", 8 };
+
+    inline constexpr SSignature WheelSteering1737{ "Wheel Steering (b1737+)",
+        "\x0F\x2F\x81\xBC\x01\x00\x00" "\x0F\x97\xC0" "\xEB\x00" "\xD1\x00", "xx???xx" "xxx" "x?" "x?", 3 };
+
+    inline constexpr SSignature WheelSteering{ "Wheel Steering (before b1737)",
+        "\x0F\x2F\x81\xBC\x01\x00\x00" "\x0F\x97\xC0\xEB\xDA", "xx???xx" "xxxxx", 3 };
+
+    inline constexpr SSignature RocketBoostActive{ "Rocket Boost Active",
+        "3A 91 ? ? ? ? 74 ? 84 D2", nullptr, 2 };
+
+    inline constexpr SSignature RocketBoostCharge{ "Rocket Boost Charge",
+        "\x48\x8B\x47\x00\xF3\x44\x0F\x10\x9F\x00\x00\x00\x00", "xxx?xxxxx????", 9 };
+
+    inline constexpr SSignature FuelLevel{ "Fuel Level",
+        "\x74\x26\x0F\x57\xC9", "xxxxx", 8 };
+
+    inline constexpr SSignature DriveForce1604{ "Drive Force (b1604+)",
+        "\xF3\x0F\x10\x8F\xA4\x08\x00\x00\xF3\x0F\x5E\xF0\x41\x0F\x2F\xCA", "xxxx????xxx?xxx?", 4 };
+
+    inline constexpr SSignature Turbo1604{ "Turbo (b1604+)",
+        "\xF3\x0F\x10\x9F\xD4\x08\x00\x00\x0F\x2F\xDF\x73\x0A", "xxxx????xxxxx", 4 };
+
+    inline constexpr SSignature Turbo{ "Turbo (before b1604)",
+        "\xF3\x0F\x10\x8F\x68\x08\x00\x00\x88\x4D\x8C\x0F\x2F\xCF", "xxxx????xxx???", 4 };
+
+    inline constexpr SSignature Handling{ "Handling",
+        "\x3C\x03\x0F\x85\x00\x00\x00\x00\x48\x8B\x41\x20\x48\x8B\x88", "xxxx????xxxxxxx", 0x16 };
+
+    // Or "8A 96 ? ? ? ? 0F B6 C8 84 D2 41", +10 or something (+31 is the engine starting bit), (0x928 starting addr)
+    inline constexpr SSignature LightStates{ "Light States",
+        "FD 02 DB 08 98 ? ? ? ? 48 8B 5C 24 30", nullptr, -4 };
+
+    inline constexpr SSignature Handbrake2060{ "Handbrake (b2060+)",
+        "8A C2 24 01 C0 E0 04 08 81", nullptr, 19 };
+
+    inline constexpr SSignature Handbrake{ "Handbrake (before b2060)",
+        "\x44\x88\xA3\x00\x00\x00\x00\x45\x8A\xF4", "xxx????xxx", 3 };
+
+    inline constexpr SSignature DirtLevel{ "Dirt Level",
+        "\x0F\x29\x7C\x24\x30\x0F\x85\xE3\x00\x00\x00\xF3\x0F\x10\xB9\x68\x09\x00\x00",
+        "xx???xx????xxxx????", 0xF };
+
+    inline constexpr SSignature EngineTemp{ "Engine Temperature",
+        "\xF3\x0F\x11\x9B\xDC\x09\x00\x00\x0F\x84\xB1\x00\x00\x00", "xxxx????xxx???", 4 };
+
+    inline constexpr SSignature DashSpeed{ "Dashboard Speed",
+        "\xF3\x0F\x10\x8F\x10\x0A\x00\x00\xF3\x0F\x59\x05\x5E\x30\x8D\x00", "xxxx????xxxx????", 4 };
+
+    inline constexpr SSignature ModelType{ "Model Type",
+        "\x8B\x83\x38\x0B\x00\x00\x83\xE8\x08\x83\xF8\x02", "xx????xx?xxx", 2 };
+
+    inline constexpr SSignature VehicleFlags{ "Vehicle Flags",
+        "\x48\x85\xC0\x74\x3C\x8B\x80\x00\x00\x00\x00\xC1\xE8\x0F", "xxxxxxx????xxx", 7 };
+
+    inline constexpr SSignature SteeringMult{ "Steering Multiplier",
+        "\x0F\xBA\xAB\xEC\x01\x00\x00\x09\x0F\x2F\xB3\x40\x01\x00\x00\x48\x8B\x83\x20\x01\x00\x00",
+        "xx?????xxx???xxxx?????", 11 };
+
+    inline constexpr SSignature WheelHealth{ "Wheel Health",
+        "\x75\x24\xF3\x0F\x10\x81\xE0\x01\x00\x00\xF3\x0F\x5C\xC1", "xxxxx???xxxx??", 6 };
+
+    inline constexpr SSignature All[] = {
+        GetAddressOfEntity,
+        GetModelInfo,
+        GetModelInfo58,
+        GetExhaust,
+        BoostLimiter,
+        HoverTransform,
+        Gear,
+        RPM,
+        Steering,
+        Wheels,
+        WheelFlags,
+        WheelCompression,
+        WheelSteering1737,
+        WheelSteering,
+        RocketBoostActive,
+        RocketBoostCharge,
+        FuelLevel,
+        DriveForce1604,
+        Turbo1604,
+        Turbo,
+        Handling,
+        LightStates,
+        Handbrake2060,
+        Handbrake,
+        DirtLevel,
+        EngineTemp,
+        DashSpeed,
+        ModelType,
+        VehicleFlags,
+        SteeringMult,
+        WheelHealth,
+    };
+}
@@ -1,14 +1,19 @@
 #include "VehicleExtensions.hpp"
 
 #include "NativeMemory.hpp"
+#include "Signatures.hpp"
 #include "Versions.hpp"
 #include "Offsets.hpp"
 #include "../Util/Logger.hpp"
 
 #include <inc/main.h>
 
+#include <algorithm>
+#include <atomic>
 #include <vector>
 #include <functional>
+#include <mutex>
+#include <type_traits>
 
 // <= b1493: 8  (Top gear = 7)
 // >= b1604: 11 (Top gear = 10)
@@ -21,576 +26,769 @@ namespace {
         return static_cast<T>((T{} < val) - (val < T{}));
     }
 
-    int rocketBoostActiveOffset = 0;
-    int rocketBoostChargeOffset = 0;
-    int hoverTransformRatioOffset = 0;
-    int hoverTransformRatioLerpOffset = 0;
-    int fuelLevelOffset = 0;
-    int nextGearOffset = 0;
-    int currentGearOffset = 0;
-    int topGearOffset = 0;
-    int gearRatiosOffset = 0;
-    int driveForceOffset = 0;
-    int initialDriveMaxFlatVelOffset = 0;
-    int driveMaxFlatVelOffset = 0;
-    int currentRPMOffset = 0;
-    int clutchOffset = 0;
-    int throttleOffset = 0;
-    int turboOffset = 0;
-    int arenaBoostOffset = 0;
-    int handlingOffset = 0;
-    int lightStatesOffset = 0;
-    int steeringAngleInputOffset = 0;
-    int steeringAngleOffset = 0;
-    int throttlePOffset = 0;
-    int brakePOffset = 0;
-    int handbrakeOffset = 0;
-    int dirtLevelOffset = 0;
-    int engineTempOffset = 0;
-    int dashSpeedOffset = 0;
-    int wheelsPtrOffset = 0;
-    int numWheelsOffset = 0;
-    int modelTypeOffset = 0;
-    int vehicleModelInfoOffset = 0x020;
-    int vehicleFlagsOffset = 0;
-
-    int steeringMultOffset = 0;
-
-    // Wheel stuff
-    int wheelHealthOffset = 0;
-    int wheelSuspensionCompressionOffset = 0;
-    int wheelSteeringAngleOffset = 0;
-    int wheelAngularVelocityOffset = 0;
-    int wheelTractionVectorLengthOffset = 0;
-    int wheelPowerOffset = 0;
-    int wheelBrakeOffset = 0;
-    int wheelFlagsOffset = 0;
-    int wheelDownforceOffset = 0;
-}
-
-void VehicleExtensions::ChangeVersion(int version) {
-    g_gameVersion = static_cast<eGameVersion>(version);
-    if (g_gameVersion >= G_VER_1_0_1604_0_STEAM) {
-        g_numGears = 11;
-    }
-}
-
-uint8_t VehicleExtensions::GearsAvailable() {
-    return g_numGears;
-}
-
-/*
- * Offsets/patterns done by me might need revision, but they've been checked 
- * against b1180.2 and b877.1 and are okay.
- */
-void VehicleExtensions::Init() {
-    mem::init();
-
-    uintptr_t addr = mem::FindPattern("3A 91 ? ? ? ? 74 ? 84 D2");
-    rocketBoostActiveOffset = addr == 0 ? 0 : *(int*)(addr + 2);
-    logger.Write(rocketBoostActiveOffset == 0 ? WARN : DEBUG, "Rocket Boost Active Offset: 0x%X", rocketBoostActiveOffset);
-
-    addr = mem::FindPattern("\x48\x8B\x47\x00\xF3\x44\x0F\x10\x9F\x00\x00\x00\x00", "xxx?xxxxx????");
-    rocketBoostChargeOffset = addr == 0 ? 0 : *(int*)(addr + 9);
-    logger.Write(rocketBoostChargeOffset == 0 ? WARN : DEBUG, "Rocket Boost Charge Offset: 0x%X", rocketBoostChargeOffset);
-
-    // Unknown
-    addr = mem::FindPattern("\xF3\x0F\x11\xB3\x00\x00\x00\x00\x44\x88\x00\x00\x00\x00\x00\x48\x85\xC9",
-        "xxxx????xx?????xxx");
-    hoverTransformRatioOffset = addr == 0 ? 0 : *(int*)(addr + 4);
-    logger.Write(hoverTransformRatioOffset == 0 ? WARN : DEBUG, "Hover Transform Active Offset: 0x%X", hoverTransformRatioOffset);
-
-    //addr = mem::FindPattern("\xF3\x0F\x11\xB3\x00\x00\x00\x00\x44\x88\x00\x00\x00\x00\x00\x48\x85\xC9",
-    //    "xxxx????xx?????xxx");
-    hoverTransformRatioLerpOffset = addr == 0 ? 0 : *(int*)(addr + 4) + 0x28;
-    logger.Write(hoverTransformRatioLerpOffset == 0 ? WARN : DEBUG, "Hover Transform Ratio Offset: 0x%X", hoverTransformRatioLerpOffset);
-
-    addr = mem::FindPattern("\x74\x26\x0F\x57\xC9", "xxxxx");
-    fuelLevelOffset = addr == 0 ? 0 : *(int*)(addr + 8);
-    logger.Write(fuelLevelOffset == 0 ? WARN : DEBUG, "Fuel Level Offset: 0x%X", fuelLevelOffset);
+    // Offset that's only looked up when it's first used.
+    // -1: Not resolved yet, 0: Not found.
+    // Resolved exactly once, also when first used from multiple threads at the same time.
+    class CLazyOffset {
+    public:
+        CLazyOffset(const char* name, int(*resolve)())
+            : mOffset(-1)
+            , mName(name)
+            , mResolve(resolve) {
+            All().push_back(this);
+        }
 
-    addr = mem::FindPattern("\x48\x8D\x8F\x00\x00\x00\x00\x4C\x8B\xC3\xF3\x0F\x11\x7C\x24",
-                            "xxx????xxxxxxxx");
-    nextGearOffset = addr == 0 ? 0 : *(int*)(addr + 3);
-    logger.Write(nextGearOffset == 0 ? WARN : DEBUG, "Next Gear Offset: 0x%X", nextGearOffset);
+        int Get() {
+            int offset = mOffset.load(std::memory_order_acquire);
+            if (offset < 0) {
+                std::call_once(mResolved, [this]() { resolve(); });
+                offset = mOffset.load(std::memory_order_acquire);
+            }
+            return offset;
+        }
 
-    currentGearOffset = addr == 0 ? 0 : *(int*)(addr + 3) + 2;
-    logger.Write(currentGearOffset == 0 ? WARN : DEBUG, "Current Gear Offset: 0x%X", currentGearOffset);
+        static std::vector<CLazyOffset*>& All() {
+            static std::vector<CLazyOffset*> offsets;
+            return offsets;
+        }
 
-    topGearOffset = addr == 0 ? 0 : *(int*)(addr + 3) + 6;
-    logger.Write(topGearOffset == 0 ? WARN : DEBUG, "Top Gear Offset: 0x%X", topGearOffset);
+    private:
+        void resolve() {
+            int offset = mResolve();
+            logger.Write(offset == 0 ? WARN : DEBUG, "%s Offset: 0x%X", mName, offset);
+            mOffset.store(offset, std::memory_order_release);
+        }
 
-    gearRatiosOffset = addr == 0 ? 0 : *(int*)(addr + 3) + 8;
-    logger.Write(gearRatiosOffset == 0 ? WARN : DEBUG, "Gear Ratios Offset: 0x%X", gearRatiosOffset);
+        std::atomic<int> mOffset;
+        std::once_flag mResolved;
+        const char* mName;
+        int(*mResolve)();
+    };
 
-    if (g_gameVersion >= G_VER_1_0_1604_0_STEAM) {
-        addr = mem::FindPattern("\xF3\x0F\x10\x8F\xA4\x08\x00\x00\xF3\x0F\x5E\xF0\x41\x0F\x2F\xCA", "xxxx????xxx?xxx?");
-        driveForceOffset = addr == 0 ? 0 : *(int*)(addr + 4);
+    int operand(uintptr_t addr, const Signatures::SSignature& signature) {
+        return *reinterpret_cast<int*>(addr + signature.Operand);
     }
-    else {
-        driveForceOffset = addr == 0 ? 0 : *(int*)(addr + 3) + 0x28;
-    }
-    logger.Write(driveForceOffset == 0 ? WARN : DEBUG, "Drive Force Offset: 0x%X", driveForceOffset);
-
-    initialDriveMaxFlatVelOffset = driveForceOffset == 0 ? 0 : driveForceOffset + 0x04;
-    logger.Write(initialDriveMaxFlatVelOffset == 0 ? WARN : DEBUG, "Initial Drive Max Flat Velocity Offset: 0x%X", initialDriveMaxFlatVelOffset);
-
-    driveMaxFlatVelOffset = driveForceOffset == 0 ? 0 : driveForceOffset + 0x08;
-    logger.Write(driveMaxFlatVelOffset == 0 ? WARN : DEBUG, "Drive Max Flat Velocity Offset: 0x%X", driveMaxFlatVelOffset);
 
-    addr = mem::FindPattern("\x76\x03\x0F\x28\xF0\xF3\x44\x0F\x10\x93",
-                            "xxxxxxxxxx");
-    currentRPMOffset = addr == 0 ? 0 : *(int*)(addr + 10);
-    logger.Write(currentRPMOffset == 0 ? WARN : DEBUG, "RPM Offset: 0x%X", currentRPMOffset);
-
-    clutchOffset = addr == 0 ? 0 : *(int*)(addr + 10) + 0xC;
-    logger.Write(clutchOffset == 0 ? WARN : DEBUG, "Clutch Offset: 0x%X", clutchOffset);
-
-    throttleOffset = addr == 0 ? 0 : *(int*)(addr + 10) + 0x10;
-    logger.Write(throttleOffset == 0 ? WARN : DEBUG, "Throttle Offset: 0x%X", throttleOffset);
-
-    if (g_gameVersion >= G_VER_1_0_1604_0_STEAM) {
-        addr = mem::FindPattern("\xF3\x0F\x10\x9F\xD4\x08\x00\x00\x0F\x2F\xDF\x73\x0A", "xxxx????xxxxx");
+    // Patterns shared by multiple offsets are only scanned once.
+    uintptr_t hoverTransformAddr() {
+        // Unknown
+        static uintptr_t addr = mem::FindPattern(Signatures::HoverTransform);
+        return addr;
     }
-    else {
-        addr = mem::FindPattern("\xF3\x0F\x10\x8F\x68\x08\x00\x00\x88\x4D\x8C\x0F\x2F\xCF",
-            "xxxx????xxx???");
-    }
-    turboOffset = addr == 0 ? 0 : *(int*)(addr + 4);
-    logger.Write(turboOffset == 0 ? WARN : DEBUG, "Turbo Offset: 0x%X", turboOffset);
 
-    if (g_gameVersion >= G_VER_1_0_1604_0_STEAM) {
-        // TODO: pattern
-        arenaBoostOffset = turboOffset + 0x30;
+    uintptr_t gearAddr() {
+        static uintptr_t addr = mem::FindPattern(Signatures::Gear);
+        return addr;
     }
-    else {
-        arenaBoostOffset = 0;
-    }
-
-    addr = mem::FindPattern("\x3C\x03\x0F\x85\x00\x00\x00\x00\x48\x8B\x41\x20\x48\x8B\x88",
-                            "xxxx????xxxxxxx");
-    handlingOffset = addr == 0 ? 0 : *(int*)(addr + 0x16);
-    logger.Write(handlingOffset == 0 ? WARN : DEBUG, "Handling Offset: 0x%X", handlingOffset);
-
-    addr = mem::FindPattern("FD 02 DB 08 98 ? ? ? ? 48 8B 5C 24 30");
-    lightStatesOffset = addr == 0 ? 0 : *(int*)(addr - 4) - 1;
-    logger.Write(lightStatesOffset == 0 ? WARN : DEBUG, "Light States Offset: 0x%X", lightStatesOffset);
-    // Or "8A 96 ? ? ? ? 0F B6 C8 84 D2 41", +10 or something (+31 is the engine starting bit), (0x928 starting addr)
 
-    addr = mem::FindPattern("\x74\x0A\xF3\x0F\x11\xB3\x1C\x09\x00\x00\xEB\x25", "xxxxxx????xx");
-    steeringAngleInputOffset = addr == 0 ? 0 : *(int*)(addr + 6);
-    logger.Write(steeringAngleInputOffset == 0 ? WARN : DEBUG, "Steering Input Offset: 0x%X", steeringAngleInputOffset);
-
-    steeringAngleOffset = addr == 0 ? 0 : *(int*)(addr + 6) + 8;
-    logger.Write(steeringAngleOffset == 0 ? WARN : DEBUG, "Steering Angle Offset: 0x%X", steeringAngleOffset);
+    uintptr_t rpmAddr() {
+        static uintptr_t addr = mem::FindPattern(Signatures::RPM);
+        return addr;
+    }
 
-    throttlePOffset = addr == 0 ? 0 : *(int*)(addr + 6) + 0x10;
-    logger.Write(throttlePOffset == 0 ? WARN : DEBUG, "ThrottleP Offset: 0x%X", throttlePOffset);
+    uintptr_t steeringAddr() {
+        static uintptr_t addr = mem::FindPattern(Signatures::Steering);
+        return addr;
+    }
 
-    brakePOffset = addr == 0 ? 0 : *(int*)(addr + 6) + 0x14;
-    logger.Write(brakePOffset == 0 ? WARN : DEBUG, "BrakeP Offset: 0x%X", brakePOffset);
+    uintptr_t wheelsAddr() {
+        static uintptr_t addr = mem::FindPattern(Signatures::Wheels);
+        return addr;
+    }
 
-    if (g_gameVersion >= G_VER_1_0_2060_0_STEAM) {
-        addr = mem::FindPattern("8A C2 24 01 C0 E0 04 08 81");
-        handbrakeOffset = addr == 0 ? 0 : *(int*)(addr + 19);
+    uintptr_t wheelFlagsAddr() {
+        static uintptr_t addr = mem::FindPattern(Signatures::WheelFlags);
+        return addr;
     }
-    else {
-        addr = mem::FindPattern("\x44\x88\xA3\x00\x00\x00\x00\x45\x8A\xF4", "xxx????xxx");
-        handbrakeOffset = addr == 0 ? 0 : *(int*)(addr + 3);
+
+    uintptr_t wheelCompressionAddr() {
+        static uintptr_t addr = mem::FindPattern(Signatures::WheelCompression);
+        return addr;
     }
-    logger.Write(handbrakeOffset == 0 ? WARN : DEBUG, "Handbrake Offset: 0x%X", handbrakeOffset);
 
-    addr = mem::FindPattern("\x0F\x29\x7C\x24\x30\x0F\x85\xE3\x00\x00\x00\xF3\x0F\x10\xB9\x68\x09\x00\x00", 
-                            "xx???xx????xxxx????");
-    dirtLevelOffset = addr == 0 ? 0 : *(int*)(addr + 0xF);
-    logger.Write(dirtLevelOffset == 0 ? WARN : DEBUG, "Dirt Level Offset: 0x%X", dirtLevelOffset);
+    // Both versions have the operand in the same place.
+    uintptr_t wheelSteeringAddr() {
+        static uintptr_t addr = g_gameVersion >= G_VER_1_0_1737_0_STEAM ?
+            mem::FindPattern(Signatures::WheelSteering1737) :
+            mem::FindPattern(Signatures::WheelSteering);
+        return addr;
+    }
 
-    addr = mem::FindPattern("\xF3\x0F\x11\x9B\xDC\x09\x00\x00\x0F\x84\xB1\x00\x00\x00",
-                            "xxxx????xxx???");
-    engineTempOffset = addr == 0 ? 0 : *(int*)(addr + 4);
-    logger.Write(engineTempOffset == 0 ? WARN : DEBUG, "Engine Temperature Offset: 0x%X", engineTempOffset);
+    CLazyOffset rocketBoostActiveOffset("Rocket Boost Active", []() {
+        uintptr_t addr = mem::FindPattern(Signatures::RocketBoostActive);
+        return addr == 0 ? 0 : operand(addr, Signatures::RocketBoostActive);
+    });
+
+    CLazyOffset rocketBoostChargeOffset("Rocket Boost Charge", []() {
+        uintptr_t addr = mem::FindPattern(Signatures::RocketBoostCharge);
+        return addr == 0 ? 0 : operand(addr, Signatures::RocketBoostCharge);
+    });
+
+    CLazyOffset hoverTransformRatioOffset("Hover Transform Active", []() {
+        uintptr_t addr = hoverTransformAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::HoverTransform);
+    });
+
+    CLazyOffset hoverTransformRatioLerpOffset("Hover Transform Ratio", []() {
+        uintptr_t addr = hoverTransformAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::HoverTransform) + 0x28;
+    });
+
+    CLazyOffset fuelLevelOffset("Fuel Level", []() {
+        uintptr_t addr = mem::FindPattern(Signatures::FuelLevel);
+        return addr == 0 ? 0 : operand(addr, Signatures::FuelLevel);
+    });
+
+    CLazyOffset nextGearOffset("Next Gear", []() {
+        uintptr_t addr = gearAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::Gear);
+    });
+
+    CLazyOffset currentGearOffset("Current Gear", []() {
+        uintptr_t addr = gearAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::Gear) + 2;
+    });
+
+    CLazyOffset topGearOffset("Top Gear", []() {
+        uintptr_t addr = gearAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::Gear) + 6;
+    });
+
+    CLazyOffset gearRatiosOffset("Gear Ratios", []() {
+        uintptr_t addr = gearAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::Gear) + 8;
+    });
+
+    CLazyOffset driveForceOffset("Drive Force", []() {
+        if (g_gameVersion >= G_VER_1_0_1604_0_STEAM) {
+            uintptr_t addr = mem::FindPattern(Signatures::DriveForce1604);
+            return addr == 0 ? 0 : operand(addr, Signatures::DriveForce1604);
+        }
+        uintptr_t addr = gearAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::Gear) + 0x28;
+    });
+
+    CLazyOffset initialDriveMaxFlatVelOffset("Initial Drive Max Flat Velocity", []() {
+        int offset = driveForceOffset.Get();
+        return offset == 0 ? 0 : offset + 0x04;
+    });
+
+    CLazyOffset driveMaxFlatVelOffset("Drive Max Flat Velocity", []() {
+        int offset = driveForceOffset.Get();
+        return offset == 0 ? 0 : offset + 0x08;
+    });
+
+    CLazyOffset currentRPMOffset("RPM", []() {
+        uintptr_t addr = rpmAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::RPM);
+    });
+
+    CLazyOffset clutchOffset("Clutch", []() {
+        uintptr_t addr = rpmAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::RPM) + 0xC;
+    });
+
+    CLazyOffset throttleOffset("Throttle", []() {
+        uintptr_t addr = rpmAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::RPM) + 0x10;
+    });
+
+    CLazyOffset turboOffset("Turbo", []() {
+        const auto& signature = g_gameVersion >= G_VER_1_0_1604_0_STEAM ?
+            Signatures::Turbo1604 : Signatures::Turbo;
+        uintptr_t addr = mem::FindPattern(signature);
+        return addr == 0 ? 0 : operand(addr, signature);
+    });
+
+    CLazyOffset arenaBoostOffset("Arena Boost", []() {
+        // TODO: pattern
+        int offset = turboOffset.Get();
+        if (g_gameVersion >= G_VER_1_0_1604_0_STEAM && offset != 0)
+            return offset + 0x30;
+        return 0;
+    });
+
+    CLazyOffset handlingOffset("Handling", []() {
+        uintptr_t addr = mem::FindPattern(Signatures::Handling);
+        return addr == 0 ? 0 : operand(addr, Signatures::Handling);
+    });
+
+    CLazyOffset lightStatesOffset("Light States", []() {
+        uintptr_t addr = mem::FindPattern(Signatures::LightStates);
+        return addr == 0 ? 0 : operand(addr, Signatures::LightStates) - 1;
+    });
+
+    CLazyOffset steeringAngleInputOffset("Steering Input", []() {
+        uintptr_t addr = steeringAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::Steering);
+    });
+
+    CLazyOffset steeringAngleOffset("Steering Angle", []() {
+        uintptr_t addr = steeringAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::Steering) + 8;
+    });
+
+    CLazyOffset throttlePOffset("ThrottleP", []() {
+        uintptr_t addr = steeringAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::Steering) + 0x10;
+    });
+
+    CLazyOffset brakePOffset("BrakeP", []() {
+        uintptr_t addr = steeringAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::Steering) + 0x14;
+    });
+
+    CLazyOffset handbrakeOffset("Handbrake", []() {
+        const auto& signature = g_gameVersion >= G_VER_1_0_2060_0_STEAM ?
+            Signatures::Handbrake2060 : Signatures::Handbrake;
+        uintptr_t addr = mem::FindPattern(signature);
+        return addr == 0 ? 0 : operand(addr, signature);
+    });
+
+    CLazyOffset dirtLevelOffset("Dirt Level", []() {
+        uintptr_t addr = mem::FindPattern(Signatures::DirtLevel);
+        return addr == 0 ? 0 : operand(addr, Signatures::DirtLevel);
+    });
+
+    CLazyOffset engineTempOffset("Engine Temperature", []() {
+        uintptr_t addr = mem::FindPattern(Signatures::EngineTemp);
+        return addr == 0 ? 0 : operand(addr, Signatures::EngineTemp);
+    });
+
+    CLazyOffset dashSpeedOffset("Dashboard Speed", []() {
+        uintptr_t addr = mem::FindPattern(Signatures::DashSpeed);
+        return addr == 0 ? 0 : operand(addr, Signatures::DashSpeed);
+    });
+
+    CLazyOffset modelTypeOffset("Model Type", []() {
+        uintptr_t addr = mem::FindPattern(Signatures::ModelType);
+        return addr == 0 ? 0 : operand(addr, Signatures::ModelType);
+    });
+
+    CLazyOffset wheelsPtrOffset("Wheels Pointer", []() {
+        uintptr_t addr = wheelsAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::Wheels) - 8;
+    });
+
+    CLazyOffset numWheelsOffset("Wheel Count", []() {
+        uintptr_t addr = wheelsAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::Wheels);
+    });
 
-    addr = mem::FindPattern("\xF3\x0F\x10\x8F\x10\x0A\x00\x00\xF3\x0F\x59\x05\x5E\x30\x8D\x00", 
-                            "xxxx????xxxx????");
-    dashSpeedOffset = addr == 0 ? 0 : *(int*)(addr + 4);
-    logger.Write(dashSpeedOffset == 0 ? WARN : DEBUG, "Dashboard Speed Offset: 0x%X", dashSpeedOffset);
+    int vehicleModelInfoOffset = 0x020;
 
-    addr = mem::FindPattern("\x8B\x83\x38\x0B\x00\x00\x83\xE8\x08\x83\xF8\x02", "xx????xx?xxx");
-    modelTypeOffset = addr == 0 ? 0 : *(int*)(addr + 2);
-    logger.Write(modelTypeOffset == 0 ? WARN : DEBUG, "Model Type Offset: 0x%X", modelTypeOffset);
+    CLazyOffset vehicleFlagsOffset("Vehicle Flags", []() {
+        uintptr_t addr = mem::FindPattern(Signatures::VehicleFlags);
+        return addr == 0 ? 0 : operand(addr, Signatures::VehicleFlags);
+    });
 
-    addr = mem::FindPattern("\x3B\xB7\x48\x0B\x00\x00\x7D\x0D", "xx????xx");
-    wheelsPtrOffset = addr == 0 ? 0 : *(int*)(addr + 2) - 8;
-    logger.Write(wheelsPtrOffset == 0 ? WARN : DEBUG, "Wheels Pointer Offset: 0x%X", wheelsPtrOffset);
+    CLazyOffset steeringMultOffset("Steering Multiplier", []() {
+        uintptr_t addr = mem::FindPattern(Signatures::SteeringMult);
+        return addr == 0 ? 0 : operand(addr, Signatures::SteeringMult);
+    });
 
-    numWheelsOffset = addr == 0 ? 0 : *(int*)(addr + 2);
-    logger.Write(numWheelsOffset == 0 ? WARN : DEBUG, "Wheel Count Offset: 0x%X", numWheelsOffset);
+    // Wheel stuff
+    CLazyOffset wheelFlagsOffset("Wheel Flags", []() {
+        uintptr_t addr = wheelFlagsAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::WheelFlags);
+    });
 
-    addr = mem::FindPattern("\x48\x85\xC0\x74\x3C\x8B\x80\x00\x00\x00\x00\xC1\xE8\x0F", "xxxxxxx????xxx");
-    vehicleFlagsOffset = addr == 0 ? 0 : *(int*)(addr + 7);
-    logger.Write(vehicleFlagsOffset == 0 ? WARN : DEBUG, "Vehicle Flags Offset: 0x%X", vehicleFlagsOffset);
+    CLazyOffset wheelDownforceOffset("Wheel Downforce", []() {
+        uintptr_t addr = wheelFlagsAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::WheelFlags) + 0x1C;
+    });
 
-    addr = mem::FindPattern("\x0F\xBA\xAB\xEC\x01\x00\x00\x09\x0F\x2F\xB3\x40\x01\x00\x00\x48\x8B\x83\x20\x01\x00\x00", 
-                            "xx?????xxx???xxxx?????");
-    steeringMultOffset = addr == 0 ? 0 : *(int*)(addr + 11);
-    logger.Write(steeringMultOffset == 0 ? WARN : DEBUG, "Steering Multiplier Offset: 0x%X", steeringMultOffset);
+    // wheelHealthOffset + float = tyre health
+    CLazyOffset wheelHealthOffset("Wheel Health", []() {
+        uintptr_t addr = mem::FindPattern(Signatures::WheelHealth);
+        return addr == 0 ? 0 : operand(addr, Signatures::WheelHealth);
+    });
+
+    CLazyOffset wheelSuspensionCompressionOffset("Wheel Suspension Compression", []() {
+        uintptr_t addr = wheelCompressionAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::WheelCompression);
+    });
+
+    CLazyOffset wheelAngularVelocityOffset("Wheel Angular Velocity", []() {
+        uintptr_t addr = wheelCompressionAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::WheelCompression) + 0xc;
+    });
+
+    CLazyOffset wheelSteeringAngleOffset("Wheel Steering Angle", []() {
+        uintptr_t addr = wheelSteeringAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::WheelSteering);
+    });
+
+    CLazyOffset wheelBrakeOffset("Wheel Brake", []() {
+        uintptr_t addr = wheelSteeringAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::WheelSteering) + 0x4;
+    });
+
+    CLazyOffset wheelPowerOffset("Wheel Power", []() {
+        uintptr_t addr = wheelSteeringAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::WheelSteering) + 0x8;
+    });
+
+    CLazyOffset wheelTractionVectorLengthOffset("Wheel Traction Vector Length", []() {
+        uintptr_t addr = wheelSteeringAddr();
+        return addr == 0 ? 0 : operand(addr, Signatures::WheelSteering) - 0x14;
+    });
+
+    // Wheel pointer array and wheel count, with a single entity lookup.
+    uint8_t getWheels(Vehicle handle, uint64_t& wheelPtr) {
+        wheelPtr = 0;
+        int ptrOffset = wheelsPtrOffset.Get();
+        int numOffset = numWheelsOffset.Get();
+        auto address = VehicleExtensions::GetAddress(handle);
+        if (address == nullptr || ptrOffset == 0 || numOffset == 0)
+            return 0;
+
+        wheelPtr = *reinterpret_cast<uint64_t*>(address + ptrOffset);
+        return static_cast<uint8_t>(*reinterpret_cast<int*>(address + numOffset));
+    }
+}
 
-    addr = mem::FindPattern("\x75\x11\x48\x8b\x01\x8b\x88", "xxxxxxx");
-    wheelFlagsOffset = addr == 0 ? 0 : *(int*)(addr + 7);
-    logger.Write(wheelFlagsOffset == 0 ? WARN : DEBUG, "Wheel Flags Offset: 0x%X", wheelFlagsOffset);
+void VehicleExtensions::ChangeVersion(int version) {
+    g_gameVersion = static_cast<eGameVersion>(version);
+    if (g_gameVersion >= G_VER_1_0_1604_0_STEAM) {
+        g_numGears = 11;
+    }
+}
 
-    wheelDownforceOffset = addr == 0 ? 0 : *(int*)(addr + 7) + 0x1C;
-    logger.Write(wheelDownforceOffset == 0 ? WARN : DEBUG, "Wheel Downforce Offset: 0x%X", wheelDownforceOffset);
+uint8_t VehicleExtensions::GearsAvailable() {
+    return g_numGears;
+}
 
+/*
+ * Offsets/patterns done by me might need revision, but they've been checked 
+ * against b1180.2 and b877.1 and are okay.
+ *
+ * The snapshot offsets are read every tick by every instance, so they're resolved
+ * here instead of on entering the first car. Everything else is looked up on first
+ * use, so only the ones actually used are scanned for.
+ */
+void VehicleExtensions::Init() {
+    mem::init();
 
-    addr = mem::FindPattern("\x75\x24\xF3\x0F\x10\x81\xE0\x01\x00\x00\xF3\x0F\x5C\xC1", "xxxxx???xxxx??");
-    wheelHealthOffset = addr == 0 ? 0 : *(int*)(addr + 6);
-    logger.Write(wheelHealthOffset == 0 ? WARN : DEBUG, "Wheel Health Offset: 0x%X", wheelHealthOffset);
+    for (auto* offset : { &currentRPMOffset, &throttleOffset, &throttlePOffset, &currentGearOffset, &turboOffset }) {
+        offset->Get();
+    }
+}
 
-    // wheelHealthOffset + float = tyre health
+void VehicleExtensions::ResolveOffsets() {
+    for (auto* offset : CLazyOffset::All()) {
+        offset->Get();
+    }
+}
 
-    addr = mem::FindPattern("\x45\x0f\x57\xc9\xf3\x0f\x11\x83\x60\x01\x00\x00\xf3\x0f\x5c", "xxx?xxx???xxxxx");
-    wheelSuspensionCompressionOffset = addr == 0 ? 0 : *(int*)(addr + 8);
-    logger.Write(wheelSuspensionCompressionOffset == 0 ? WARN : DEBUG, "Wheel Suspension Compression Offset: 0x%X", wheelSuspensionCompressionOffset);
+BYTE *VehicleExtensions::GetAddress(Vehicle handle) {
+    return reinterpret_cast<BYTE *>(mem::GetAddressOfEntity(handle));
+}
 
-    wheelAngularVelocityOffset = addr == 0 ? 0 : (*(int*)(addr + 8)) + 0xc;
-    logger.Write(wheelAngularVelocityOffset == 0 ? WARN : DEBUG, "Wheel Angular Velocity Offset: 0x%X", wheelAngularVelocityOffset);
+SVehicleSnapshot VehicleExtensions::GetSnapshot(Vehicle handle) {
+    SVehicleSnapshot snapshot{};
+    snapshot.Address = GetAddress(handle);
+    if (snapshot.Address == nullptr)
+        return snapshot;
 
-    if (g_gameVersion >= G_VER_1_0_1737_0_STEAM) {
-        addr = mem::FindPattern("\x0F\x2F\x81\xBC\x01\x00\x00" "\x0F\x97\xC0" "\xEB\x00" "\xD1\x00", "xx???xx" "xxx" "x?" "x?");
-    }
-    else {
-        addr = mem::FindPattern("\x0F\x2F\x81\xBC\x01\x00\x00" "\x0F\x97\xC0\xEB\xDA", "xx???xx" "xxxxx");
-    }
-    wheelSteeringAngleOffset = addr == 0 ? 0 : *(int*)(addr + 3);
-    logger.Write(wheelSteeringAngleOffset == 0 ? WARN : DEBUG, "Wheel Steering Angle Offset: 0x%X", wheelSteeringAngleOffset);
+    auto read = [&](CLazyOffset& lazyOffset, auto& field) {
+        int offset = lazyOffset.Get();
+        if (offset != 0)
+            field = *reinterpret_cast<std::remove_reference_t<decltype(field)>*>(snapshot.Address + offset);
+    };
 
-    wheelBrakeOffset = addr == 0 ? 0 : (*(int*)(addr + 3)) + 0x4;
-    logger.Write(wheelBrakeOffset == 0 ? WARN : DEBUG, "Wheel Brake Offset: 0x%X", wheelBrakeOffset);
+    read(currentRPMOffset, snapshot.RPM);
+    read(throttleOffset, snapshot.Throttle);
+    read(throttlePOffset, snapshot.ThrottleP);
+    read(currentGearOffset, snapshot.GearCurr);
+    read(turboOffset, snapshot.Turbo);
+    return snapshot;
+}
 
-    wheelPowerOffset = addr == 0 ? 0 : (*(int*)(addr + 3)) + 0x8;
-    logger.Write(wheelPowerOffset == 0 ? WARN : DEBUG, "Wheel Power Offset: 0x%X", wheelPowerOffset);
+void VehicleExtensions::ApplySnapshot(const SVehicleSnapshot& original, const SVehicleSnapshot& updated) {
+    if (updated.Address == nullptr || updated.Address != original.Address)
+        return;
 
-    wheelTractionVectorLengthOffset = addr == 0 ? 0 : (*(int*)(addr + 3)) - 0x14;
-    logger.Write(wheelTractionVectorLengthOffset == 0 ? WARN : DEBUG, "Wheel Traction Vector Length Offset: 0x%X", wheelTractionVectorLengthOffset);
-}
+    auto write = [&](CLazyOffset& lazyOffset, const auto& originalField, const auto& updatedField) {
+        int offset = lazyOffset.Get();
+        if (offset != 0 && originalField != updatedField)
+            *reinterpret_cast<std::remove_const_t<std::remove_reference_t<decltype(updatedField)>>*>(updated.Address + offset) = updatedField;
+    };
 
-BYTE *VehicleExtensions::GetAddress(Vehicle handle) {
-    return reinterpret_cast<BYTE *>(mem::GetAddressOfEntity(handle));
+    write(currentRPMOffset, original.RPM, updated.RPM);
+    write(throttleOffset, original.Throttle, updated.Throttle);
+    write(throttlePOffset, original.ThrottleP, updated.ThrottleP);
+    write(currentGearOffset, original.GearCurr, updated.GearCurr);
+    write(turboOffset, original.Turbo, updated.Turbo);
 }
 
 bool VehicleExtensions::GetRocketBoostActive(Vehicle handle) {
-    if (rocketBoostActiveOffset == 0) return false;
-    return *reinterpret_cast<bool *>(GetAddress(handle) + rocketBoostActiveOffset);
+    int offset = rocketBoostActiveOffset.Get();
+    if (offset == 0) return false;
+    return *reinterpret_cast<bool *>(GetAddress(handle) + offset);
 }
 
 void VehicleExtensions::SetRocketBoostActive(Vehicle handle, bool val) {
-    if (rocketBoostActiveOffset == 0) return;
-    *reinterpret_cast<bool *>(GetAddress(handle) + rocketBoostActiveOffset) = val;
+    int offset = rocketBoostActiveOffset.Get();
+    if (offset == 0) return;
+    *reinterpret_cast<bool *>(GetAddress(handle) + offset) = val;
 }
 
 float VehicleExtensions::GetRocketBoostCharge(Vehicle handle) {
-    if (rocketBoostChargeOffset == 0) return 0.0f;
-    return *reinterpret_cast<float *>(GetAddress(handle) + rocketBoostChargeOffset);
+    int offset = rocketBoostChargeOffset.Get();
+    if (offset == 0) return 0.0f;
+    return *reinterpret_cast<float *>(GetAddress(handle) + offset);
 }
 
 void VehicleExtensions::SetRocketBoostCharge(Vehicle handle, float value) {
-    if (rocketBoostChargeOffset == 0) return;
-    *reinterpret_cast<float *>(GetAddress(handle) + rocketBoostChargeOffset) = value;
+    int offset = rocketBoostChargeOffset.Get();
+    if (offset == 0) return;
+    *reinterpret_cast<float *>(GetAddress(handle) + offset) = value;
 }
 
 float VehicleExtensions::GetHoverTransformRatio(Vehicle handle) {
-    if (hoverTransformRatioOffset == 0) return false;
-    return *reinterpret_cast<float *>(GetAddress(handle) + hoverTransformRatioOffset);
+    int offset = hoverTransformRatioOffset.Get();
+    if (offset == 0) return false;
+    return *reinterpret_cast<float *>(GetAddress(handle) + offset);
 }
 
 void VehicleExtensions::SetHoverTransformRatio(Vehicle handle, float value) {
-    if (hoverTransformRatioOffset == 0) return;
-    *reinterpret_cast<float *>(GetAddress(handle) + hoverTransformRatioOffset) = value;
+    int offset = hoverTransformRatioOffset.Get();
+    if (offset == 0) return;
+    *reinterpret_cast<float *>(GetAddress(handle) + offset) = value;
 }
 
 float VehicleExtensions::GetHoverTransformRatioLerp(Vehicle handle) {
-    if (hoverTransformRatioLerpOffset == 0) return 0.0f;
-    return *reinterpret_cast<float *>(GetAddress(handle) + hoverTransformRatioLerpOffset);
+    int offset = hoverTransformRatioLerpOffset.Get();
+    if (offset == 0) return 0.0f;
+    return *reinterpret_cast<float *>(GetAddress(handle) + offset);
 }
 
 void VehicleExtensions::SetHoverTransformRatioLerp(Vehicle handle, float value) {
-    if (hoverTransformRatioLerpOffset == 0) return;
-    *reinterpret_cast<float *>(GetAddress(handle) + hoverTransformRatioLerpOffset) = value;
+    int offset = hoverTransformRatioLerpOffset.Get();
+    if (offset == 0) return;
+    *reinterpret_cast<float *>(GetAddress(handle) + offset) = value;
 }
 
 float VehicleExtensions::GetFuelLevel(Vehicle handle) {
-    if (fuelLevelOffset == 0) return 0.0f;
-    return *reinterpret_cast<float *>(GetAddress(handle) + fuelLevelOffset);
+    int offset = fuelLevelOffset.Get();
+    if (offset == 0) return 0.0f;
+    return *reinterpret_cast<float *>(GetAddress(handle) + offset);
 }
 
 void VehicleExtensions::SetFuelLevel(Vehicle handle, float value) {
-    if (fuelLevelOffset == 0) return;
-    *reinterpret_cast<float *>(GetAddress(handle) + fuelLevelOffset) = value;
+    int offset = fuelLevelOffset.Get();
+    if (offset == 0) return;
+    *reinterpret_cast<float *>(GetAddress(handle) + offset) = value;
 }
 
 uint16_t VehicleExtensions::GetGearNext(Vehicle handle) {
-    if (nextGearOffset == 0) return 0;
-    return *reinterpret_cast<const uint16_t *>(GetAddress(handle) + nextGearOffset);
+    int offset = nextGearOffset.Get();
+    if (offset == 0) return 0;
+    return *reinterpret_cast<const uint16_t *>(GetAddress(handle) + offset);
 }
 
 void VehicleExtensions::SetGearNext(Vehicle handle, uint16_t value) {
-    if (nextGearOffset == 0) return;
-    *reinterpret_cast<uint16_t *>(GetAddress(handle) + nextGearOffset) = value;
+    int offset = nextGearOffset.Get();
+    if (offset == 0) return;
+    *reinterpret_cast<uint16_t *>(GetAddress(handle) + offset) = value;
 }
 
 uint16_t VehicleExtensions::GetGearCurr(Vehicle handle) {
-    if (currentGearOffset == 0) return 0;
-    return *reinterpret_cast<const uint16_t *>(GetAddress(handle) + currentGearOffset);
+    int offset = currentGearOffset.Get();
+    if (offset == 0) return 0;
+    return *reinterpret_cast<const uint16_t *>(GetAddress(handle) + offset);
 }
 
 void VehicleExtensions::SetGearCurr(Vehicle handle, uint16_t value) {
-    if (currentGearOffset == 0) return;
-    *reinterpret_cast<uint16_t *>(GetAddress(handle) + currentGearOffset) = value;
+    int offset = currentGearOffset.Get();
+    if (offset == 0) return;
+    *reinterpret_cast<uint16_t *>(GetAddress(handle) + offset) = value;
 }
 
 uint8_t VehicleExtensions::GetTopGear(Vehicle handle) {
-    if (topGearOffset == 0) return 0;
-    return *reinterpret_cast<uint8_t *>(GetAddress(handle) + topGearOffset);
+    int offset = topGearOffset.Get();
+    if (offset == 0) return 0;
+    return *reinterpret_cast<uint8_t *>(GetAddress(handle) + offset);
 }
 
 void VehicleExtensions::SetTopGear(Vehicle handle, uint8_t value) {
-    if (topGearOffset == 0) return;
-    *reinterpret_cast<uint8_t *>(GetAddress(handle) + topGearOffset) = value;
+    int offset = topGearOffset.Get();
+    if (offset == 0) return;
+    *reinterpret_cast<uint8_t *>(GetAddress(handle) + offset) = value;
 }
 
 float* VehicleExtensions::GetGearRatioPtr(Vehicle handle, uint8_t gear) {
-    if (gearRatiosOffset == 0) return nullptr;
+    int offset = gearRatiosOffset.Get();
+    if (offset == 0) return nullptr;
     return reinterpret_cast<float*>(
-        GetAddress(handle) + gearRatiosOffset + gear * sizeof(float));
+        GetAddress(handle) + offset + gear * sizeof(float));
 }
 
 std::vector<float> VehicleExtensions::GetGearRatios(Vehicle handle) {
-    if (gearRatiosOffset == 0) return {};
+    int offset = gearRatiosOffset.Get();
+    if (offset == 0) return {};
     auto address = GetAddress(handle);
     std::vector<float> ratios(GetTopGear(handle) + 1);
     for (int gear = 0; gear < GetTopGear(handle) + 1; ++gear) {
-        ratios[gear] = *reinterpret_cast<float *>(address + gearRatiosOffset + gear * sizeof(float));
+        ratios[gear] = *reinterpret_cast<float *>(address + offset + gear * sizeof(float));
     }
     return ratios;
 }
 
 void VehicleExtensions::SetGearRatios(Vehicle handle, const std::vector<float>& values) {
-    if (gearRatiosOffset == 0) return;
+    int offset = gearRatiosOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
     for (uint8_t gear = 0; gear < values.size(); ++gear) {
-        *reinterpret_cast<float *>(address + gearRatiosOffset + gear * sizeof(float)) = values[gear];
+        *reinterpret_cast<float *>(address + offset + gear * sizeof(float)) = values[gear];
     }
 }
 
 float VehicleExtensions::GetDriveForce(Vehicle handle) {
-    if (driveForceOffset == 0) return 0.0f;
-    return *reinterpret_cast<float *>(GetAddress(handle) + driveForceOffset);
+    int offset = driveForceOffset.Get();
+    if (offset == 0) return 0.0f;
+    return *reinterpret_cast<float *>(GetAddress(handle) + offset);
 }
 
 void VehicleExtensions::SetDriveForce(Vehicle handle, float value) {
-    if (driveForceOffset == 0) return;
-    *reinterpret_cast<float *>(GetAddress(handle) + driveForceOffset) = value;
+    int offset = driveForceOffset.Get();
+    if (offset == 0) return;
+    *reinterpret_cast<float *>(GetAddress(handle) + offset) = value;
 }
 
 float VehicleExtensions::GetInitialDriveMaxFlatVel(Vehicle handle) {
-    if (initialDriveMaxFlatVelOffset == 0) return 0.0f;
-    return *reinterpret_cast<float *>(GetAddress(handle) + initialDriveMaxFlatVelOffset);
+    int offset = initialDriveMaxFlatVelOffset.Get();
+    if (offset == 0) return 0.0f;
+    return *reinterpret_cast<float *>(GetAddress(handle) + offset);
 }
 
 void VehicleExtensions::SetInitialDriveMaxFlatVel(Vehicle handle, float value) {
-    if (initialDriveMaxFlatVelOffset == 0) return;
-    *reinterpret_cast<float *>(GetAddress(handle) + initialDriveMaxFlatVelOffset) = value;
+    int offset = initialDriveMaxFlatVelOffset.Get();
+    if (offset == 0) return;
+    *reinterpret_cast<float *>(GetAddress(handle) + offset) = value;
 }
 
 float VehicleExtensions::GetDriveMaxFlatVel(Vehicle handle) {
-    if (driveMaxFlatVelOffset == 0) return 0.0f;
-    return *reinterpret_cast<float *>(GetAddress(handle) + driveMaxFlatVelOffset);
+    int offset = driveMaxFlatVelOffset.Get();
+    if (offset == 0) return 0.0f;
+    return *reinterpret_cast<float *>(GetAddress(handle) + offset);
 }
 
 void VehicleExtensions::SetDriveMaxFlatVel(Vehicle handle, float value) {
-    if (driveMaxFlatVelOffset == 0) return;
-    *reinterpret_cast<float *>(GetAddress(handle) + driveMaxFlatVelOffset) = value;
+    int offset = driveMaxFlatVelOffset.Get();
+    if (offset == 0) return;
+    *reinterpret_cast<float *>(GetAddress(handle) + offset) = value;
 }
 
 float VehicleExtensions::GetCurrentRPM(Vehicle handle) {
-    if (currentRPMOffset == 0) return 0.0f;
-    return *reinterpret_cast<const float *>(GetAddress(handle) + currentRPMOffset);
+    int offset = currentRPMOffset.Get();
+    if (offset == 0) return 0.0f;
+    return *reinterpret_cast<const float *>(GetAddress(handle) + offset);
 }
 
 void VehicleExtensions::SetCurrentRPM(Vehicle handle, float value) {
-    if (currentRPMOffset == 0) return;
-    *reinterpret_cast<float *>(GetAddress(handle) + currentRPMOffset) = value;
+    int offset = currentRPMOffset.Get();
+    if (offset == 0) return;
+    *reinterpret_cast<float *>(GetAddress(handle) + offset) = value;
 }
 
 float VehicleExtensions::GetClutch(Vehicle handle) {
-    if (clutchOffset == 0) return 0.0f;
+    int offset = clutchOffset.Get();
+    if (offset == 0) return 0.0f;
     auto address = GetAddress(handle);
-    return address == nullptr ? 0 : *reinterpret_cast<const float *>(address + clutchOffset);
+    return address == nullptr ? 0 : *reinterpret_cast<const float *>(address + offset);
 }
 
 void VehicleExtensions::SetClutch(Vehicle handle, float value) {
-    if (clutchOffset == 0) return;
+    int offset = clutchOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
-    *reinterpret_cast<float *>(address + clutchOffset) = value;
+    *reinterpret_cast<float *>(address + offset) = value;
 }
 
 float VehicleExtensions::GetThrottle(Vehicle handle) {
-    if (throttleOffset == 0) return 0.0f;
+    int offset = throttleOffset.Get();
+    if (offset == 0) return 0.0f;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<float *>(address + throttleOffset);
+    return *reinterpret_cast<float *>(address + offset);
 }
 
 void VehicleExtensions::SetThrottle(Vehicle handle, float value) {
-    if (throttleOffset == 0) return;
+    int offset = throttleOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
-    *reinterpret_cast<float *>(address + throttleOffset) = value;
+    *reinterpret_cast<float *>(address + offset) = value;
 }
 
 float VehicleExtensions::GetTurbo(Vehicle handle) {
-    if (turboOffset == 0) return 0.0f;
+    int offset = turboOffset.Get();
+    if (offset == 0) return 0.0f;
     auto address = GetAddress(handle);
-    return address == nullptr ? 0 : *reinterpret_cast<const float *>(address + turboOffset);
+    return address == nullptr ? 0 : *reinterpret_cast<const float *>(address + offset);
 }
 
 void VehicleExtensions::SetTurbo(Vehicle handle, float value) {
-    if (turboOffset == 0) return;
+    int offset = turboOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
-    *reinterpret_cast<float *>(address + turboOffset) = value;
+    *reinterpret_cast<float *>(address + offset) = value;
 }
 
 float VehicleExtensions::GetArenaBoost(Vehicle handle) {
-    if (arenaBoostOffset == 0) return 0.0f;
+    int offset = arenaBoostOffset.Get();
+    if (offset == 0) return 0.0f;
     auto address = GetAddress(handle);
-    return address == nullptr ? 0 : *reinterpret_cast<const float*>(address + arenaBoostOffset);
+    return address == nullptr ? 0 : *reinterpret_cast<const float*>(address + offset);
 }
 
 void VehicleExtensions::SetArenaBoost(Vehicle handle, float value) {
-    if (arenaBoostOffset == 0) return;
+    int offset = arenaBoostOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
-    *reinterpret_cast<float*>(address + arenaBoostOffset) = value;
+    *reinterpret_cast<float*>(address + offset) = value;
 }
 
 uint64_t VehicleExtensions::GetHandlingPtr(Vehicle handle) {
-    if (handlingOffset == 0) return 0;
+    int offset = handlingOffset.Get();
+    if (offset == 0) return 0;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<uint64_t*>(address + handlingOffset);
+    return *reinterpret_cast<uint64_t*>(address + offset);
 }
 
 void VehicleExtensions::SetHandlingPtr(Vehicle handle, uint64_t value) {
-    if (handlingOffset == 0) return;
+    int offset = handlingOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
     if (address == 0) return;
-    *reinterpret_cast<uint64_t*>(address + handlingOffset) = value;
+    *reinterpret_cast<uint64_t*>(address + offset) = value;
 }
 
 uint32_t VehicleExtensions::GetLightStates(Vehicle handle) {
-    if (lightStatesOffset == 0) return 0;
+    int offset = lightStatesOffset.Get();
+    if (offset == 0) return 0;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<uint32_t*>(address + lightStatesOffset);
+    return *reinterpret_cast<uint32_t*>(address + offset);
 }
 
 void VehicleExtensions::SetLightStates(Vehicle handle, uint32_t value) {
-    if (lightStatesOffset == 0) return;
+    int offset = lightStatesOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
-    *reinterpret_cast<uint32_t*>(address + lightStatesOffset) = value;
+    *reinterpret_cast<uint32_t*>(address + offset) = value;
 }
 
 float VehicleExtensions::GetSteeringInputAngle(Vehicle handle) {
-    if (steeringAngleInputOffset == 0) return 0;
+    int offset = steeringAngleInputOffset.Get();
+    if (offset == 0) return 0;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<float *>(address + steeringAngleInputOffset);
+    return *reinterpret_cast<float *>(address + offset);
 }
 
 void VehicleExtensions::SetSteeringInputAngle(Vehicle handle, float value) {
-    if (steeringAngleInputOffset == 0) return;
+    int offset = steeringAngleInputOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
-    *reinterpret_cast<float *>(address + steeringAngleInputOffset) = value;
+    *reinterpret_cast<float *>(address + offset) = value;
 }
 
 float VehicleExtensions::GetSteeringAngle(Vehicle handle) {
-    if (steeringAngleOffset == 0) return 0;
+    int offset = steeringAngleOffset.Get();
+    if (offset == 0) return 0;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<float *>(address + steeringAngleOffset);
+    return *reinterpret_cast<float *>(address + offset);
 }
 
 void VehicleExtensions::SetSteeringAngle(Vehicle handle, float value) {
-    if (steeringAngleOffset == 0) return;
+    int offset = steeringAngleOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
-    *reinterpret_cast<float *>(address + steeringAngleOffset) = value;
+    *reinterpret_cast<float *>(address + offset) = value;
 }
 
 float VehicleExtensions::GetThrottleP(Vehicle handle) {
-    if (throttlePOffset == 0) return 0;
+    int offset = throttlePOffset.Get();
+    if (offset == 0) return 0;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<float *>(address + throttlePOffset);
+    return *reinterpret_cast<float *>(address + offset);
 }
 
 void VehicleExtensions::SetThrottleP(Vehicle handle, float value) {
-    if (throttlePOffset == 0) return;
+    int offset = throttlePOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
-    *reinterpret_cast<float *>(address + throttlePOffset) = value;
+    *reinterpret_cast<float *>(address + offset) = value;
 }
 
 float VehicleExtensions::GetBrakeP(Vehicle handle) {
-    if (brakePOffset == 0) return 0;
+    int offset = brakePOffset.Get();
+    if (offset == 0) return 0;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<float *>(address + brakePOffset);
+    return *reinterpret_cast<float *>(address + offset);
 }
 
 void VehicleExtensions::SetBrakeP(Vehicle handle, float value) {
-    if (brakePOffset == 0) return;
+    int offset = brakePOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
-    *reinterpret_cast<float *>(address + brakePOffset) = value;
+    *reinterpret_cast<float *>(address + offset) = value;
 }
 
 bool VehicleExtensions::GetHandbrake(Vehicle handle) {
-    if (handbrakeOffset == 0) return false;
+    int offset = handbrakeOffset.Get();
+    if (offset == 0) return false;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<bool *>(address + handbrakeOffset);
+    return *reinterpret_cast<bool *>(address + offset);
 }
 
 void VehicleExtensions::SetHandbrake(Vehicle handle, bool value) {
-    if (handbrakeOffset == 0) return;
+    int offset = handbrakeOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
-    *reinterpret_cast<bool*>(address + handbrakeOffset) = value;
+    *reinterpret_cast<bool*>(address + offset) = value;
 }
 
 float VehicleExtensions::GetDirtLevel(Vehicle handle) {
-    if (dirtLevelOffset == 0) return 0;
+    int offset = dirtLevelOffset.Get();
+    if (offset == 0) return 0;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<float *>(address + dirtLevelOffset);
+    return *reinterpret_cast<float *>(address + offset);
 }
 
 float VehicleExtensions::GetEngineTemp(Vehicle handle) {
-    if (engineTempOffset == 0) return 0;
+    int offset = engineTempOffset.Get();
+    if (offset == 0) return 0;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<float *>(address + engineTempOffset);
+    return *reinterpret_cast<float *>(address + offset);
 }
 
 float VehicleExtensions::GetDashSpeed(Vehicle handle) {
-    if (dashSpeedOffset == 0) return 0;
+    int offset = dashSpeedOffset.Get();
+    if (offset == 0) return 0;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<float *>(address + dashSpeedOffset);
+    return *reinterpret_cast<float *>(address + offset);
 }
 
 int VehicleExtensions::GetModelType(Vehicle handle) {
-    if (modelTypeOffset == 0) return 0;
+    int offset = modelTypeOffset.Get();
+    if (offset == 0) return 0;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<int *>(address + modelTypeOffset);
+    return *reinterpret_cast<int *>(address + offset);
 }
 
 uint64_t VehicleExtensions::GetWheelsPtr(Vehicle handle) {
-    if (wheelsPtrOffset == 0) return 0;
+    int offset = wheelsPtrOffset.Get();
+    if (offset == 0) return 0;
     auto address = GetAddress(handle);
-    return *reinterpret_cast<uint64_t *>(address + wheelsPtrOffset);
+    return *reinterpret_cast<uint64_t *>(address + offset);
 }
 
 uint8_t VehicleExtensions::GetNumWheels(Vehicle handle) {
-    if (numWheelsOffset == 0) return 0;
+    int offset = numWheelsOffset.Get();
+    if (offset == 0) return 0;
     auto address = GetAddress(handle);
     if (address == 0) return 0;
-    return *reinterpret_cast<int *>(address + numWheelsOffset);
+    return *reinterpret_cast<int *>(address + offset);
 }
 
 float VehicleExtensions::GetDriveBiasFront(Vehicle handle) {
@@ -632,8 +830,8 @@ Hash VehicleExtensions::GetAIHandling(Vehicle handle) {
 }
 
 std::vector<uint64_t> VehicleExtensions::GetWheelPtrs(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);  // pointer to wheel pointers
-    auto numWheels = GetNumWheels(handle);
+    uint64_t wheelPtr; // pointer to wheel pointers
+    auto numWheels = getWheels(handle, wheelPtr);
     std::vector<uint64_t> wheelPtrs(numWheels);
     for (auto i = 0; i < numWheels; i++) {
         auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * i);
@@ -663,51 +861,55 @@ void VehicleExtensions::SetVisualHeight(Vehicle handle, float height) {
 }
 
 std::vector<float> VehicleExtensions::GetWheelHealths(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+    int offset = wheelHealthOffset.Get();
+    uint64_t wheelPtr;
+    auto numWheels = getWheels(handle, wheelPtr);
 
     std::vector<float> healths(numWheels);
 
-    if (wheelHealthOffset == 0) return healths;
+    if (offset == 0) return healths;
 
     for (auto i = 0; i < numWheels; i++) {
         auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * i);
-        healths[i] = *reinterpret_cast<float *>(wheelAddr + wheelHealthOffset);
+        healths[i] = *reinterpret_cast<float *>(wheelAddr + offset);
     }
     return healths;
 }
 
 void VehicleExtensions::SetWheelsHealth(Vehicle handle, float health) {
-    if (wheelHealthOffset == 0) return;
+    int offset = wheelHealthOffset.Get();
+    if (offset == 0) return;
 
-    auto wheelPtr = GetWheelsPtr(handle);  // pointer to wheel pointers
-    auto numWheels = GetNumWheels(handle);
+    uint64_t wheelPtr; // pointer to wheel pointers
+    auto numWheels = getWheels(handle, wheelPtr);
 
     for (auto i = 0; i < numWheels; i++) {
         auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * i);
-        *reinterpret_cast<float *>(wheelAddr + wheelHealthOffset) = health;
+        *reinterpret_cast<float *>(wheelAddr + offset) = health;
     }
 }
 
 float VehicleExtensions::GetSteeringMultiplier(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+    int offset = steeringMultOffset.Get();
+    uint64_t wheelPtr;
+    auto numWheels = getWheels(handle, wheelPtr);
 
     if (numWheels > 1) {
         auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * 1);
-        return abs(*reinterpret_cast<float*>(wheelAddr + steeringMultOffset));
+        return abs(*reinterpret_cast<float*>(wheelAddr + offset));
     }
     return 1.0f;
 }
 
 void VehicleExtensions::SetSteeringMultiplier(Vehicle handle, float value) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+    int offset = steeringMultOffset.Get();
+    uint64_t wheelPtr;
+    auto numWheels = getWheels(handle, wheelPtr);
 
     for (int i = 0; i<numWheels; i++) {
         auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * i);
-        float sign = Sign(*reinterpret_cast<float*>(wheelAddr + steeringMultOffset));
-        *reinterpret_cast<float*>(wheelAddr + steeringMultOffset) = value * sign;
+        float sign = Sign(*reinterpret_cast<float*>(wheelAddr + offset));
+        *reinterpret_cast<float*>(wheelAddr + offset) = value * sign;
     }
 }
 
@@ -756,31 +958,33 @@ std::vector<Vector3> VehicleExtensions::GetWheelLastContactCoords(Vehicle handle
 }
 
 std::vector<float> VehicleExtensions::GetWheelCompressions(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+    int offset = wheelSuspensionCompressionOffset.Get();
+    uint64_t wheelPtr;
+    auto numWheels = getWheels(handle, wheelPtr);
 
     std::vector<float> compressions(numWheels);
 
-    if (wheelSuspensionCompressionOffset == 0) return compressions;
+    if (offset == 0) return compressions;
 
     for (auto i = 0; i < numWheels; i++) {
         auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * i);
-        compressions[i] = *reinterpret_cast<float *>(wheelAddr + wheelSuspensionCompressionOffset);
+        compressions[i] = *reinterpret_cast<float *>(wheelAddr + offset);
     }
     return compressions;
 }
 
 std::vector<float> VehicleExtensions::GetWheelSteeringAngles(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+    int offset = wheelSteeringAngleOffset.Get();
+    uint64_t wheelPtr;
+    auto numWheels = getWheels(handle, wheelPtr);
 
     std::vector<float> angles(numWheels);
 
-    if (wheelSteeringAngleOffset == 0) return angles;
+    if (offset == 0) return angles;
 
     for (auto i = 0; i < numWheels; i++) {
         auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * i);
-        angles[i] = *reinterpret_cast<float *>(wheelAddr + wheelSteeringAngleOffset);
+        angles[i] = *reinterpret_cast<float *>(wheelAddr + offset);
     }
     return angles;
 }
@@ -849,144 +1053,143 @@ std::vector<WheelDimensions> VehicleExtensions::GetWheelDimensions(Vehicle handl
 }
 
 std::vector<float> VehicleExtensions::GetWheelRotationSpeeds(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+    int offset = wheelAngularVelocityOffset.Get();
+    uint64_t wheelPtr;
+    auto numWheels = getWheels(handle, wheelPtr);
     std::vector<float> speeds(numWheels);
 
-    if (wheelAngularVelocityOffset == 0) return speeds;
+    if (offset == 0) return speeds;
 
     for (auto i = 0; i < numWheels; i++) {
         auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * i);
-        speeds[i] = -*reinterpret_cast<float *>(wheelAddr + wheelAngularVelocityOffset);
+        speeds[i] = -*reinterpret_cast<float *>(wheelAddr + offset);
     }
     return speeds;
 }
 
 void VehicleExtensions::SetWheelRotationSpeed(Vehicle handle, uint8_t index, float value) {
+    int offset = wheelAngularVelocityOffset.Get();
     if (index > GetNumWheels(handle)) return;
-    if (wheelAngularVelocityOffset == 0) return;
+    if (offset == 0) return;
 
     auto wheelPtr = GetWheelsPtr(handle);
 
     auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * index);
-    *reinterpret_cast<float*>(wheelAddr + wheelAngularVelocityOffset) = value;
-}
-
-std::vector<float> VehicleExtensions::GetTyreSpeeds(Vehicle handle) {
-    int numWheels = GetNumWheels(handle);
-    std::vector<float> rotationSpeed = GetWheelRotationSpeeds(handle);
-    std::vector<WheelDimensions> dimensionsSet = GetWheelDimensions(handle);
-    std::vector<float> wheelSpeeds(numWheels);
-
-    for (int i = 0; i < numWheels; i++) {
-        wheelSpeeds[i] = rotationSpeed[i] * dimensionsSet[i].TyreRadius;
-    }
-    return wheelSpeeds;
+    *reinterpret_cast<float*>(wheelAddr + offset) = value;
 }
 
 void VehicleExtensions::SetWheelTractionVectorLength(Vehicle handle, uint8_t index, float value) {
+    int offset = wheelTractionVectorLengthOffset.Get();
     if (index > GetNumWheels(handle)) return;
-    if (wheelTractionVectorLengthOffset == 0) return;
+    if (offset == 0) return;
 
     auto wheelPtr = GetWheelsPtr(handle);
 
     auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * index);
-    *reinterpret_cast<float *>(wheelAddr + wheelTractionVectorLengthOffset) = value;
+    *reinterpret_cast<float *>(wheelAddr + offset) = value;
 }
 
 std::vector<float> VehicleExtensions::GetWheelTractionVectorLength(Vehicle handle) {
-    auto numWheels = GetNumWheels(handle);
+    int offset = wheelTractionVectorLengthOffset.Get();
+    uint64_t wheelPtr;
+    auto numWheels = getWheels(handle, wheelPtr);
     std::vector<float> values(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
 
-    if (wheelTractionVectorLengthOffset == 0) return values;
+    if (offset == 0) return values;
 
     for (auto i = 0; i < numWheels; i++) {
         auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * i);
-        values[i] = (-*reinterpret_cast<float *>(wheelAddr + wheelTractionVectorLengthOffset));
+        values[i] = (-*reinterpret_cast<float *>(wheelAddr + offset));
     }
     return values;
 }
 
 std::vector<float> VehicleExtensions::GetWheelPower(Vehicle handle) {
-    auto numWheels = GetNumWheels(handle);
-    auto wheelPtr = GetWheelsPtr(handle);
+    int offset = wheelPowerOffset.Get();
+    uint64_t wheelPtr;
+    auto numWheels = getWheels(handle, wheelPtr);
 
     std::vector<float> values(numWheels);
 
-    if (wheelPowerOffset == 0) return values;
+    if (offset == 0) return values;
 
     for (auto i = 0; i < numWheels; ++i) {
         auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * i);
-        values[i] = *reinterpret_cast<float *>(wheelAddr + wheelPowerOffset);
+        values[i] = *reinterpret_cast<float *>(wheelAddr + offset);
     }
     return values;
 }
 
 void VehicleExtensions::SetWheelPower(Vehicle handle, uint8_t index, float value) {
+    int offset = wheelPowerOffset.Get();
     if (index > GetNumWheels(handle)) return;
-    if (wheelPowerOffset == 0) return;
+    if (offset == 0) return;
 
     auto wheelPtr = GetWheelsPtr(handle);
 
     auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * index);
-    *reinterpret_cast<float *>(wheelAddr + wheelPowerOffset) = value;
+    *reinterpret_cast<float *>(wheelAddr + offset) = value;
 }
 
 std::vector<float> VehicleExtensions::GetWheelBrakePressure(Vehicle handle) {
-    const auto numWheels = GetNumWheels(handle);
+    int offset = wheelBrakeOffset.Get();
+    uint64_t wheelPtr;
+    auto numWheels = getWheels(handle, wheelPtr);
     std::vector<float> values(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
 
-    if (wheelBrakeOffset == 0) return values;
+    if (offset == 0) return values;
 
     for (auto i = 0; i < numWheels; ++i) {
         auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * i);
-        values[i] = *reinterpret_cast<float *>(wheelAddr + wheelBrakeOffset);
+        values[i] = *reinterpret_cast<float *>(wheelAddr + offset);
     }
     return values;
 }
 
 void VehicleExtensions::SetWheelBrakePressure(Vehicle handle, uint8_t index, float value) {
+    int offset = wheelBrakeOffset.Get();
     if (index > GetNumWheels(handle)) return;
-    if (wheelBrakeOffset == 0) return;
+    if (offset == 0) return;
 
     auto wheelPtr = GetWheelsPtr(handle);
 
     auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * index);
-    *reinterpret_cast<float *>(wheelAddr + wheelBrakeOffset) = value;
+    *reinterpret_cast<float *>(wheelAddr + offset) = value;
 }
 
 bool VehicleExtensions::IsWheelPowered(Vehicle handle, uint8_t index) {
+    int offset = wheelFlagsOffset.Get();
     if (index > GetNumWheels(handle)) return false;
-    if (wheelFlagsOffset == 0) return false;
+    if (offset == 0) return false;
 
     auto wheelPtr = GetWheelsPtr(handle);
     auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * index);
-    auto wheelFlags = *reinterpret_cast<uint32_t *>(wheelAddr + wheelFlagsOffset);
+    auto wheelFlags = *reinterpret_cast<uint32_t *>(wheelAddr + offset);
     return wheelFlags & 0x10;
 }
 
 std::vector<uint16_t> VehicleExtensions::GetWheelFlags(Vehicle handle) {
-    const auto numWheels = GetNumWheels(handle);
+    int offset = wheelFlagsOffset.Get();
+    uint64_t wheelPtr;
+    auto numWheels = getWheels(handle, wheelPtr);
     std::vector<uint16_t> flags(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
 
-    if (wheelFlagsOffset == 0) return flags;
+    if (offset == 0) return flags;
 
     for (auto i = 0; i < numWheels; ++i) {
         auto wheelAddr = *reinterpret_cast<uint64_t *>(wheelPtr + 0x008 * i);
-        flags[i] = *reinterpret_cast<uint16_t *>(wheelAddr + wheelFlagsOffset);
+        flags[i] = *reinterpret_cast<uint16_t *>(wheelAddr + offset);
     }
     return flags;
 }
 
 std::vector<float> VehicleExtensions::GetWheelDownforces(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+    int offset = wheelDownforceOffset.Get();
+    uint64_t wheelPtr;
+    auto numWheels = getWheels(handle, wheelPtr);
     std::vector<float> dfs(numWheels);
 
-    if (wheelDownforceOffset == 0) return dfs;
+    if (offset == 0) return dfs;
 
     for (auto i = 0; i < numWheels; i++) {
         auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * i);
@@ -996,7 +1199,8 @@ std::vector<float> VehicleExtensions::GetWheelDownforces(Vehicle handle) {
 }
 
 uint64_t VehicleExtensions::GetWheelHandlingPtr(Vehicle handle, uint8_t index) {
-    if (handlingOffset == 0) return 0;
+    int offset = handlingOffset.Get();
+    if (offset == 0) return 0;
 
     auto wheelPtr = GetWheelsPtr(handle);
     auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * index);
@@ -1005,7 +1209,8 @@ uint64_t VehicleExtensions::GetWheelHandlingPtr(Vehicle handle, uint8_t index) {
 }
 
 void VehicleExtensions::SetWheelHandlingPtr(Vehicle handle, uint8_t index, uint64_t value) {
-    if (handlingOffset == 0) return;
+    int offset = handlingOffset.Get();
+    if (offset == 0) return;
     auto address = GetAddress(handle);
     if (address == 0) return;
 
@@ -1015,7 +1220,61 @@ void VehicleExtensions::SetWheelHandlingPtr(Vehicle handle, uint8_t index, uint6
     *reinterpret_cast<uint64_t*>(wheelAddr + 0x120) = value;
 }
 
+void VehicleExtensions::GetWheelStates(Vehicle handle, SWheelStates& states, uint32_t fields) {
+    uint64_t wheelPtr;
+    auto numWheels = getWheels(handle, wheelPtr);
+    if (numWheels > SWheelStates::MaxWheels) {
+        LOG_WARN("[VExt] Vehicle %d has %u wheels, only reading the first %u",
+            handle, static_cast<unsigned>(numWheels), static_cast<unsigned>(SWheelStates::MaxWheels));
+    }
+    states.Count = std::min(numWheels, SWheelStates::MaxWheels);
+
+    if (fields & WheelTyreSpeed)
+        fields |= WheelRotationSpeed | WheelTyreRadius;
+
+    auto requested = [fields](uint32_t field, CLazyOffset& offset) {
+        return (fields & field) ? offset.Get() : 0;
+    };
+
+    const int healthOffset = requested(WheelHealth, wheelHealthOffset);
+    const int compressionOffset = requested(WheelCompression, wheelSuspensionCompressionOffset);
+    const int steeringAngleOffset = requested(WheelSteeringAngle, wheelSteeringAngleOffset);
+    const int angularVelocityOffset = requested(WheelRotationSpeed, wheelAngularVelocityOffset);
+    const int powerOffset = requested(WheelPower, wheelPowerOffset);
+    const int brakeOffset = requested(WheelBrakePressure, wheelBrakeOffset);
+    const int tractionVectorLengthOffset = requested(WheelTractionVectorLength, wheelTractionVectorLengthOffset);
+    const int flagsOffset = requested(WheelFlags, wheelFlagsOffset);
+    const int downforceOffset = requested(WheelDownforce, wheelDownforceOffset);
+
+    auto readFloat = [](uint64_t wheelAddr, int offset) {
+        return offset == 0 ? 0.0f : *reinterpret_cast<float*>(wheelAddr + offset);
+    };
+
+    for (uint8_t i = 0; i < states.Count; ++i) {
+        auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * i);
+        SWheelState& wheel = states.Wheels[i];
+        wheel = SWheelState{};
+        wheel.Address = wheelAddr;
+        if (!wheelAddr)
+            continue;
+
+        wheel.Health = readFloat(wheelAddr, healthOffset);
+        wheel.Compression = readFloat(wheelAddr, compressionOffset);
+        wheel.SteeringAngle = readFloat(wheelAddr, steeringAngleOffset);
+        wheel.RotationSpeed = -readFloat(wheelAddr, angularVelocityOffset);
+        if (fields & WheelTyreRadius)
+            wheel.TyreRadius = *reinterpret_cast<float*>(wheelAddr + 0x110);
+        wheel.TyreSpeed = wheel.RotationSpeed * wheel.TyreRadius;
+        wheel.Power = readFloat(wheelAddr, powerOffset);
+        wheel.BrakePressure = readFloat(wheelAddr, brakeOffset);
+        wheel.TractionVectorLength = -readFloat(wheelAddr, tractionVectorLengthOffset);
+        wheel.Downforce = downforceOffset == 0 ? 0.0f : *reinterpret_cast<float*>(wheelAddr + 0x220);
+        wheel.Flags = flagsOffset == 0 ? 0 : *reinterpret_cast<uint16_t*>(wheelAddr + flagsOffset);
+    }
+}
+
 std::vector<uint32_t> VehicleExtensions::GetVehicleFlags(Vehicle handle) {
+    int offset = vehicleFlagsOffset.Get();
     auto address = GetAddress(handle);
 
     if (!address)
@@ -1025,7 +1284,7 @@ std::vector<uint32_t> VehicleExtensions::GetVehicleFlags(Vehicle handle) {
 
     auto pCVehicleModelInfo = *(uint64_t*)(address + vehicleModelInfoOffset);
     for (uint8_t i = 0; i < 6; i++) {
-        offs[i] = *(uint32_t*)(pCVehicleModelInfo + vehicleFlagsOffset + sizeof(uint32_t) * i);
+        offs[i] = *(uint32_t*)(pCVehicleModelInfo + offset + sizeof(uint32_t) * i);
     }
     return offs;
 }
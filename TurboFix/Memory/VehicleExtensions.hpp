@@ -1,5 +1,6 @@
 #pragma once
 #include <inc/types.h>
+#include <array>
 #include <vector>
 #include <cstdint>
 
@@ -9,14 +10,78 @@ struct WheelDimensions {
     float TyreWidth;
 };
 
+// Per-tick copy of the fields the script reads, so the entity address
+// is only looked up once. Fields stay 0 when their offset isn't found.
+struct SVehicleSnapshot {
+    BYTE* Address;
+    float RPM;
+    float Throttle;
+    float ThrottleP;
+    uint16_t GearCurr;
+    float Turbo;
+};
+
+// Per-wheel fields, see the matching wheel getters for their meaning.
+// Fields stay 0 when their offset isn't found.
+struct SWheelState {
+    uint64_t Address;
+    float Health;
+    float Compression;
+    float SteeringAngle;
+    float RotationSpeed;
+    float TyreRadius;
+    float TyreSpeed;
+    float Power;
+    float BrakePressure;
+    float TractionVectorLength;
+    float Downforce;
+    uint16_t Flags;
+};
+
+// Fields for GetWheelStates to read. Only the offsets of requested fields are resolved.
+enum EWheelField : uint32_t {
+    WheelHealth = 1 << 0,
+    WheelCompression = 1 << 1,
+    WheelSteeringAngle = 1 << 2,
+    WheelRotationSpeed = 1 << 3,
+    WheelTyreRadius = 1 << 4,
+    // Also reads RotationSpeed and TyreRadius.
+    WheelTyreSpeed = 1 << 5,
+    WheelPower = 1 << 6,
+    WheelBrakePressure = 1 << 7,
+    WheelTractionVectorLength = 1 << 8,
+    WheelDownforce = 1 << 9,
+    WheelFlags = 1 << 10,
+    WheelAll = 0xFFFFFFFF,
+};
+
+// Fixed-capacity, so it can live on the stack and be re-used every tick.
+struct SWheelStates {
+    static constexpr uint8_t MaxWheels = 10;
+
+    std::array<SWheelState, MaxWheels> Wheels;
+    uint8_t Count;
+
+    const SWheelState* begin() const { return Wheels.data(); }
+    const SWheelState* end() const { return Wheels.data() + Count; }
+};
+
 class VehicleExtensions {
 public:
     static void ChangeVersion(int version);
 
+    // Also resolves the offsets GetSnapshot reads.
     static void Init();
 
+    // Other offsets are resolved on first use. This resolves all of them at once.
+    static void ResolveOffsets();
+
     static BYTE* GetAddress(Vehicle handle);
 
+    static SVehicleSnapshot GetSnapshot(Vehicle handle);
+    // Only writes the fields in updated that changed compared to original.
+    static void ApplySnapshot(const SVehicleSnapshot& original, const SVehicleSnapshot& updated);
+
     // <  1604:  8 gears
     // >= 1604: 11 gears
     static uint8_t GearsAvailable();
@@ -165,9 +230,6 @@ public:
     static std::vector<float> GetWheelRotationSpeeds(Vehicle handle);
     // For forward, use negative speed.
     static void SetWheelRotationSpeed(Vehicle handle, uint8_t index, float value);
-    // Unit: m/s, at the tyres. This probably doesn't work well for popped tyres.
-    static std::vector<float> GetTyreSpeeds(Vehicle handle);
-
     // How much smoke and skidmarks the wheels/tires are generating.
     static std::vector<float> GetWheelTractionVectorLength(Vehicle handle);
     static void SetWheelTractionVectorLength(Vehicle handle, uint8_t index, float value);
@@ -191,6 +253,11 @@ public:
     static uint64_t GetWheelHandlingPtr(Vehicle handle, uint8_t index);
     static void SetWheelHandlingPtr(Vehicle handle, uint8_t index, uint64_t value);
 
+    // Reads the requested wheel fields (EWheelField) in one pass, without allocating.
+    // TyreSpeed is in m/s, at the tyres. This probably doesn't work well for popped tyres.
+    // Vehicles with more than SWheelStates::MaxWheels wheels only get the first ones, with a warning.
+    static void GetWheelStates(Vehicle handle, SWheelStates& states, uint32_t fields = WheelAll);
+
     static std::vector<uint32_t> GetVehicleFlags(Vehicle handle);
 private:
     VehicleExtensions() = default;
@@ -0,0 +1,50 @@
+#include "EffectScheduler.hpp"
+
+CEffectScheduler::~CEffectScheduler() {
+    Clear();
+}
+
+void CEffectScheduler::After(int now, int delayMs, Action action) {
+    push({ now + delayMs, 0, 0, nullptr, std::move(action) });
+}
+
+void CEffectScheduler::Until(int now, int timeoutMs, Condition done, Action cleanup) {
+    // First checked on the next tick.
+    push({ now + 1, 0, now + timeoutMs, std::move(done), std::move(cleanup) });
+}
+
+void CEffectScheduler::Update(int gameTime) {
+    // Conditions that aren't met yet are checked again next tick, not in this loop.
+    std::vector<SEvent> waiting;
+
+    while (!mEvents.empty() && mEvents.top().DueTime <= gameTime) {
+        SEvent event = mEvents.top();
+        mEvents.pop();
+
+        if (event.Done && gameTime < event.Deadline && !event.Done()) {
+            event.DueTime = gameTime + 1;
+            waiting.push_back(std::move(event));
+            continue;
+        }
+
+        event.Run();
+    }
+
+    for (auto& event : waiting) {
+        push(std::move(event));
+    }
+}
+
+void CEffectScheduler::Clear() {
+    while (!mEvents.empty()) {
+        SEvent event = mEvents.top();
+        mEvents.pop();
+        if (event.Done)
+            event.Run();
+    }
+}
+
+void CEffectScheduler::push(SEvent event) {
+    event.Sequence = mSequence++;
+    mEvents.push(std::move(event));
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+// Runs delayed effect actions from the script tick, so effects never have to
+// WAIT() on the script fiber. Times are game time (MISC::GET_GAME_TIMER), so
+// pending effects also pause with the game.
+class CEffectScheduler {
+public:
+    using Action = std::function<void()>;
+    using Condition = std::function<bool()>;
+
+    CEffectScheduler() = default;
+    // Runs pending cleanups, see Clear.
+    ~CEffectScheduler();
+
+    CEffectScheduler(const CEffectScheduler&) = delete;
+    CEffectScheduler& operator=(const CEffectScheduler&) = delete;
+
+    // Runs action once gameTime reaches now + delayMs.
+    void After(int now, int delayMs, Action action);
+
+    // Checks done every tick, and runs cleanup once it returns true or timeoutMs passed.
+    // Meant for stopping looped effects, so cleanup also runs when the scheduler is cleared.
+    void Until(int now, int timeoutMs, Condition done, Action cleanup);
+
+    // Call once per tick.
+    void Update(int gameTime);
+
+    // Drops pending After actions, and runs pending Until cleanups right away.
+    void Clear();
+
+    size_t Pending() const {
+        return mEvents.size();
+    }
+
+private:
+    struct SEvent {
+        int DueTime;
+        // Keeps events due at the same time in the order they were added.
+        uint64_t Sequence;
+        // Until only
+        int Deadline;
+        Condition Done;
+        Action Run;
+    };
+
+    struct SLater {
+        bool operator()(const SEvent& a, const SEvent& b) const {
+            if (a.DueTime != b.DueTime)
+                return a.DueTime > b.DueTime;
+            return a.Sequence > b.Sequence;
+        }
+    };
+
+    void push(SEvent event);
+
+    // Min-heap on due time
+    std::priority_queue<SEvent, std::vector<SEvent>, SLater> mEvents;
+    uint64_t mSequence = 0;
+};
@@ -0,0 +1,14 @@
+#include "ExhaustCache.hpp"
+
+const std::vector<SExhaustTransform>* CExhaustCache::Find(Hash model, int exhaustMod) const {
+    auto it = mCache.find(key(model, exhaustMod));
+    if (it == mCache.end())
+        return nullptr;
+    return &it->second;
+}
+
+const std::vector<SExhaustTransform>& CExhaustCache::Store(Hash model, int exhaustMod, std::vector<SExhaustTransform> exhausts) {
+    auto& entry = mCache[key(model, exhaustMod)];
+    entry = std::move(exhausts);
+    return entry;
+}
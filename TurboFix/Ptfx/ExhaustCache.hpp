@@ -0,0 +1,32 @@
+#pragma once
+#include <inc/types.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Where the flames go, relative to the vehicle.
+struct SExhaustTransform {
+    Vector3 Offset;
+    // Degrees, like the particle natives take.
+    Vector3 Rotation;
+};
+
+// Exhaust positions only change with the model and the installed exhaust mod,
+// so they're worked out once per combination.
+class CExhaustCache {
+public:
+    // nullptr when the combination hasn't been stored yet.
+    const std::vector<SExhaustTransform>* Find(Hash model, int exhaustMod) const;
+    const std::vector<SExhaustTransform>& Store(Hash model, int exhaustMod, std::vector<SExhaustTransform> exhausts);
+
+    size_t Size() const {
+        return mCache.size();
+    }
+
+private:
+    static uint64_t key(Hash model, int exhaustMod) {
+        return static_cast<uint64_t>(model) << 32 | static_cast<uint32_t>(exhaustMod);
+    }
+
+    std::unordered_map<uint64_t, std::vector<SExhaustTransform>> mCache;
+};
@@ -0,0 +1,56 @@
+#include "ParticleBudget.hpp"
+
+#include <algorithm>
+
+void CParticleBudget::SetLimits(unsigned maxPerFrame, float lodDistance, float maxDistance) {
+    mMaxPerFrame = maxPerFrame;
+    mLodDistance = lodDistance;
+    mMaxDistance = maxDistance;
+}
+
+CParticleBudget::ELod CParticleBudget::GetLod(float distance) {
+    if (distance > mMaxDistance) {
+        ++mStats.Culled;
+        return ELod::Culled;
+    }
+    if (distance > mLodDistance)
+        return ELod::Reduced;
+    return ELod::Full;
+}
+
+float CParticleBudget::Priority(float distance, bool onScreen, bool player) {
+    float priority = 1.0f / std::max(distance, 1.0f);
+    if (!onScreen)
+        priority *= 0.25f;
+    // The player's own vehicle always goes first.
+    if (player)
+        priority += 1000.0f;
+    return priority;
+}
+
+void CParticleBudget::Request(float priority, FireFn fire) {
+    mRequests.push_back({ priority, std::move(fire) });
+}
+
+void CParticleBudget::Flush() {
+    mStats.LastFrameRequests = static_cast<unsigned>(mRequests.size());
+    mStats.LastFrameEffects = 0;
+    if (mRequests.empty())
+        return;
+
+    // Requests start a varying number of effects, so it's not known up front how many fit.
+    std::sort(mRequests.begin(), mRequests.end(), [](const SRequest& a, const SRequest& b) {
+        return a.Priority > b.Priority;
+    });
+
+    unsigned effects = 0;
+    size_t fired = 0;
+    for (; fired < mRequests.size() && effects < mMaxPerFrame; ++fired) {
+        effects += std::max(mRequests[fired].Fire(mMaxPerFrame - effects), 1u);
+    }
+
+    mStats.LastFrameEffects = effects;
+    mStats.Spawned += effects;
+    mStats.Dropped += mRequests.size() - fired;
+    mRequests.clear();
+}
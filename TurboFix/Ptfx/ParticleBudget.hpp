@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Limits the backfire effects started per frame, over all vehicles. Requests,
+// one per exhaust, are collected while the script instances tick, and the ones
+// with the highest priority are fired in Flush until the effects run out.
+// Distant vehicles get less detail, or nothing.
+class CParticleBudget {
+public:
+    enum class ELod {
+        // All exhausts, with the extra flame layers
+        Full,
+        // One exhaust, base flame only
+        Reduced,
+        Culled,
+    };
+
+    struct SStats {
+        // Effects started
+        uint64_t Spawned = 0;
+        // Requests over the per-frame budget
+        uint64_t Dropped = 0;
+        // Requests too far away
+        uint64_t Culled = 0;
+        unsigned LastFrameRequests = 0;
+        unsigned LastFrameEffects = 0;
+    };
+
+    // Starts at most maxEffects effects, at least one, and returns how many.
+    // Scheduled ones, like a delayed flame, count in the frame they're requested.
+    using FireFn = std::function<unsigned(unsigned maxEffects)>;
+
+    // maxPerFrame: effects, not requests. 0 disables effects.
+    void SetLimits(unsigned maxPerFrame, float lodDistance, float maxDistance);
+
+    // Counts a culled request when it returns Culled.
+    ELod GetLod(float distance);
+
+    // Roughly how noticeable the effect is: nearby and on-screen first.
+    static float Priority(float distance, bool onScreen, bool player);
+
+    // fire is called from Flush, in the same tick.
+    void Request(float priority, FireFn fire);
+
+    // Call once per tick, after all script instances ticked.
+    void Flush();
+
+    const SStats& Stats() const {
+        return mStats;
+    }
+
+private:
+    struct SRequest {
+        float Priority;
+        FireFn Fire;
+    };
+
+    unsigned mMaxPerFrame = 16;
+    float mLodDistance = 40.0f;
+    float mMaxDistance = 150.0f;
+
+    std::vector<SRequest> mRequests;
+    SStats mStats;
+};
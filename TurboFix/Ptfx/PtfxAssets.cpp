@@ -0,0 +1,93 @@
+#include "PtfxAssets.hpp"
+
+#include "../Util/Logger.hpp"
+
+#include <inc/natives.h>
+#include <array>
+
+namespace {
+    constexpr size_t AssetCount = static_cast<size_t>(PtfxAssets::EAsset::Count);
+
+    const std::array<const char*, AssetCount> assetNames = {
+        "weap_sm_bom",
+        "veh_sanctus",
+        "turbo_flame",
+    };
+
+    // Loaded assets are checked again every so often, in case the game dropped them.
+    constexpr int RecheckIntervalMs = 1000;
+    // Requested assets are polled every tick until they load, or for this long.
+    constexpr int RequestTimeoutMs = 5000;
+    // After that they're likely not installed (turbo_flame is optional), so
+    // they're only requested and checked again this often.
+    constexpr int MissingRetryMs = 10000;
+
+    std::array<bool, AssetCount> loaded{};
+    std::array<bool, AssetCount> missing{};
+    std::array<int, AssetCount> requestTime{};
+    std::array<int, AssetCount> lastCheckTime{};
+    unsigned references = 0;
+}
+
+void PtfxAssets::Acquire() {
+    if (references++ > 0)
+        return;
+
+    int gameTime = MISC::GET_GAME_TIMER();
+    for (size_t i = 0; i < assetNames.size(); ++i) {
+        STREAMING::REQUEST_NAMED_PTFX_ASSET(assetNames[i]);
+        requestTime[i] = gameTime;
+    }
+    LOG_DEBUG("[Ptfx] Requested assets");
+}
+
+void PtfxAssets::Release() {
+    if (references == 0 || --references > 0)
+        return;
+
+    for (size_t i = 0; i < assetNames.size(); ++i) {
+        STREAMING::REMOVE_NAMED_PTFX_ASSET(assetNames[i]);
+        loaded[i] = false;
+        missing[i] = false;
+    }
+    LOG_DEBUG("[Ptfx] Removed assets");
+}
+
+void PtfxAssets::Update() {
+    if (references == 0)
+        return;
+
+    int gameTime = MISC::GET_GAME_TIMER();
+    for (size_t i = 0; i < assetNames.size(); ++i) {
+        if (!loaded[i] && !missing[i] && gameTime - requestTime[i] >= RequestTimeoutMs) {
+            missing[i] = true;
+            LOG_WARN("[Ptfx] [%s] didn't load in %d ms, retrying every %d ms",
+                assetNames[i], RequestTimeoutMs, MissingRetryMs);
+        }
+
+        int interval = loaded[i] ? RecheckIntervalMs : (missing[i] ? MissingRetryMs : 0);
+        if (gameTime - lastCheckTime[i] < interval)
+            continue;
+        lastCheckTime[i] = gameTime;
+
+        bool wasLoaded = loaded[i];
+        loaded[i] = STREAMING::HAS_NAMED_PTFX_ASSET_LOADED(assetNames[i]);
+        if (loaded[i]) {
+            missing[i] = false;
+            continue;
+        }
+
+        STREAMING::REQUEST_NAMED_PTFX_ASSET(assetNames[i]);
+        // Dropped by the game: poll every tick again until it's back.
+        if (wasLoaded)
+            requestTime[i] = gameTime;
+    }
+}
+
+bool PtfxAssets::Loaded(EAsset asset) {
+    return loaded[static_cast<size_t>(asset)];
+}
+
+unsigned PtfxAssets::References() {
+    return references;
+}
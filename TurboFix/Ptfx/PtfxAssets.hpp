@@ -0,0 +1,25 @@
+#pragma once
+
+// Streams the particle assets the backfire effects use, for all script
+// instances together. Assets are requested when the first instance acquires
+// them, and removed when the last one releases them.
+namespace PtfxAssets {
+    enum class EAsset {
+        WeapSmBom,
+        VehSanctus,
+        TurboFlame,
+        Count
+    };
+
+    void Acquire();
+    void Release();
+
+    // Call once per tick. Polls assets that are still streaming in, and retries
+    // ones that didn't load every few seconds.
+    void Update();
+
+    // Cached from the last Update, doesn't call any natives.
+    bool Loaded(EAsset asset);
+
+    unsigned References();
+}
@@ -6,17 +6,36 @@
 #include "Constants.hpp"
 #include "Compatibility.h"
 #include "SoundSet.hpp"
-
+#include "StressTest.hpp"
+#include "Audio/AudioThread.hpp"
+#include "Audio/Decode.hpp"
+#include "Audio/Mix.hpp"
+#include "Audio/SoundSetLoader.hpp"
+#include "Audio/SoundBackend.hpp"
+#include "Audio/Synth.hpp"
+
+#include "Memory/NativeMemory.hpp"
 #include "Memory/Patches.h"
+#include "Memory/Versions.hpp"
+#include "Ptfx/PtfxAssets.hpp"
+#include "Util/AllocTracker.hpp"
+#include "Util/BinaryLog.hpp"
 #include "Util/Logger.hpp"
 #include "Util/Paths.hpp"
+#include "Util/Profiler.hpp"
 #include "Util/String.hpp"
+#include "Util/UI.hpp"
 
 #include <inc/natives.h>
 #include <inc/main.h>
 #include <fmt/format.h>
+#include <simpleini/SimpleIni.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <memory>
 #include <filesystem>
+#include <thread>
 
 
 using namespace TurboFix;
@@ -30,7 +49,51 @@ namespace {
     std::vector<CConfig> configs;
     std::vector<SSoundSet> soundSets;
 
+    // Shared by all script instances, so sound sets only need to be loaded once.
+    std::unique_ptr<ISoundBackend> soundBackend;
+    std::unique_ptr<CAudioThread> audio;
+    // Uses soundBackend, so it's destroyed before it. Loader jobs only call the
+    // backend through CSoundSetLoader::CJob, which stops them before that.
+    std::unique_ptr<CSoundSetLoader> soundSetLoader;
+
+    // Shared by all script instances, flushed every tick in UpdatePtfx.
+    CParticleBudget particleBudget;
+
     bool initialized = false;
+
+    // So playback doesn't need to look up sound sets by name.
+    void resolveSoundSetIndex(CConfig& config, bool warn) {
+        auto soundSetIt = std::find_if(soundSets.begin(), soundSets.end(), [&](const auto& soundSet) {
+            return soundSet.Name == config.AntiLag.SoundSet;
+        });
+
+        if (soundSetIt != soundSets.end()) {
+            config.AntiLag.SoundSetIndex = static_cast<int>(soundSetIt - soundSets.begin());
+        }
+        else {
+            if (warn) {
+                logger.Write(WARN, "[%s] Sound set [%s] not found, using [%s]",
+                    config.Name.c_str(), config.AntiLag.SoundSet.c_str(), soundSets[0].Name.c_str());
+            }
+            config.AntiLag.SoundSetIndex = 0;
+        }
+    }
+
+    void resolveSoundSetIndices() {
+        if (soundSets.empty())
+            return;
+
+        for (auto& config : configs) {
+            resolveSoundSetIndex(config, true);
+        }
+
+        // Their copies of the default config, already warned about above.
+        if (playerScriptInst)
+            resolveSoundSetIndex(playerScriptInst->DefaultConfig(), false);
+        for (const auto& inst : npcScriptInsts) {
+            resolveSoundSetIndex(inst->DefaultConfig(), false);
+        }
+    }
 }
 
 void TurboFix::ScriptMain() {
@@ -59,10 +122,26 @@ void TurboFix::ScriptInit() {
     settings->Load();
     logger.Write(INFO, "Settings loaded");
 
+    if (settings->Debug.SignatureReport)
+        mem::SetScanReport(true);
+
+    if (settings->Debug.BinaryLog) {
+        BinaryLog::Start(Paths::GetModuleFolder(Paths::GetOurModuleHandle()) +
+            Constants::ModDir + "\\" +
+            Paths::GetModuleNameWithoutExtension(Paths::GetOurModuleHandle()) + ".blog");
+    }
+
+    soundBackend = Audio::CreateSoundBackend(settings->Audio.Backend,
+        Paths::GetModuleFolder(Paths::GetOurModuleHandle()) + Constants::ModDir + "\\recording.wav");
+    audio = std::make_unique<CAudioThread>(*soundBackend,
+        std::max(settings->Audio.MaxVoices, 0), settings->Audio.MaxDistance);
+    soundSetLoader = std::make_unique<CSoundSetLoader>(
+        std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u));
+
     TurboFix::LoadConfigs();
     TurboFix::LoadSoundSets();
 
-    playerScriptInst = std::make_shared<CTurboScript>(*settings, configs, soundSets);
+    playerScriptInst = std::make_shared<CTurboScript>(*settings, configs, soundSets, *audio, particleBudget);
 
     if (!Patches::Test()) {
         logger.Write(ERROR, "[PATCH] Test failed");
@@ -73,8 +152,21 @@ void TurboFix::ScriptInit() {
     }
 
     VehicleExtensions::Init();
+    CTurboScript::InitPatterns();
     Compatibility::Setup();
 
+    if (settings->Debug.SignatureReport) {
+        // Offsets are otherwise only scanned for when first used.
+        VehicleExtensions::ResolveOffsets();
+        const std::string reportPath =
+            Paths::GetModuleFolder(Paths::GetOurModuleHandle()) +
+            Constants::ModDir +
+            "\\signatures.txt";
+        mem::WriteScanReport(reportPath, fmt::format("{} ({})",
+            eGameVersionToString(getGameVersion()), Paths::GetRunningExecutablePath()));
+        mem::SetScanReport(false);
+    }
+
     scriptMenu = std::make_unique<CScriptMenu<CTurboScript>>(settingsMenuPath,
         []() {
             // OnInit
@@ -92,14 +184,26 @@ void TurboFix::ScriptInit() {
 
 void TurboFix::ScriptTick() {
     while (true) {
-        playerScriptInst->Tick();
-        scriptMenu->Tick(*playerScriptInst);
-        UpdateNPC();
+        StressTest::Update();
+        {
+            PROFILE_ZONE(ScriptTick);
+            playerScriptInst->Tick();
+            scriptMenu->Tick(*playerScriptInst);
+            UpdateNPC();
+            UpdateAudio();
+            UpdateSoundSets();
+            UpdatePtfx();
+        }
+        if (Profiler::UpdateTrace())
+            UI::Notify("Trace saved", true);
+        if constexpr (AllocTracker::Enabled)
+            AllocTracker::EndFrame(settings->Debug.AllocBudget);
         WAIT(0);
     }
 }
 
 void TurboFix::UpdateNPC() {
+    PROFILE_ZONE(NPC);
     std::vector<std::shared_ptr<CTurboScriptNPC>> instsToDelete;
 
     std::vector<Vehicle> allVehicles(1024);
@@ -117,10 +221,14 @@ void TurboFix::UpdateNPC() {
         });
 
         if (it == npcScriptInsts.end()) {
-            npcScriptInsts.push_back(std::make_shared<CTurboScriptNPC>(vehicle, *settings, configs, soundSets));
+            npcScriptInsts.push_back(std::make_shared<CTurboScriptNPC>(vehicle, *settings, configs, soundSets, *audio, particleBudget));
             auto npcScriptInst = npcScriptInsts.back();
 
             npcScriptInst->UpdateActiveConfig(false);
+            BINLOG(DEBUG, "[NPC] Added vehicle %d, model 0x%08X, config [%s], %u instance(s)",
+                vehicle, ENTITY::GET_ENTITY_MODEL(vehicle),
+                npcScriptInst->ActiveConfig() ? npcScriptInst->ActiveConfig()->Name.c_str() : "None",
+                static_cast<unsigned>(npcScriptInsts.size()));
         }
     }
 
@@ -137,10 +245,32 @@ void TurboFix::UpdateNPC() {
     }
 
     for (const auto& inst : instsToDelete) {
+        Vehicle vehicle = inst->GetVehicle();
+        bool exists = ENTITY::DOES_ENTITY_EXIST(vehicle);
+        BINLOG(DEBUG, "[NPC] Removing vehicle %d, exists: %d, dead: %d, player's: %d",
+            vehicle, exists, exists && ENTITY::IS_ENTITY_DEAD(vehicle, 0),
+            vehicle == playerScriptInst->GetVehicle());
         npcScriptInsts.erase(std::remove(npcScriptInsts.begin(), npcScriptInsts.end(), inst), npcScriptInsts.end());
     }
 }
 
+void TurboFix::UpdateAudio() {
+    PROFILE_ZONE(Audio);
+    Vector3 camPos = CAM::GET_FINAL_RENDERED_CAM_COORD();
+    Vector3 camRot = CAM::GET_FINAL_RENDERED_CAM_ROT(0);
+    audio->SetListener(camPos, camRot);
+}
+
+void TurboFix::UpdatePtfx() {
+    PROFILE_ZONE(PtfxFlush);
+    PtfxAssets::Update();
+
+    // Instances that get removed in UpdateNPC didn't tick, so all requests are still valid.
+    particleBudget.SetLimits(std::max(settings->Ptfx.MaxPerFrame, 0),
+        settings->Ptfx.LodDistance, settings->Ptfx.MaxDistance);
+    particleBudget.Flush();
+}
+
 void TurboFix::UpdateActiveConfigs() {
     if (playerScriptInst)
         playerScriptInst->UpdateActiveConfig(true);
@@ -170,7 +300,16 @@ const std::vector<SSoundSet>& TurboFix::GetSoundSets() {
     return soundSets;
 }
 
+CAudioThread& TurboFix::GetAudio() {
+    return *audio;
+}
+
+const CParticleBudget& TurboFix::GetParticleBudget() {
+    return particleBudget;
+}
+
 uint32_t TurboFix::LoadConfigs() {
+    PROFILE_ZONE(LoadConfigs);
     namespace fs = std::filesystem;
 
     const std::string configsPath =
@@ -215,10 +354,189 @@ uint32_t TurboFix::LoadConfigs() {
 
     logger.Write(INFO, "Configs loaded: %d", configs.size());
 
+    resolveSoundSetIndices();
     TurboFix::UpdateActiveConfigs();
     return static_cast<unsigned>(configs.size());
 }
 
+namespace {
+    struct SSoundSetFiles {
+        std::string Sub;
+        std::vector<std::string> Pops;
+    };
+
+    // What's in the sound set's SoundSet.ini, if it has one.
+    struct SSoundSetInfo {
+        bool Synth = false;
+        bool Premix = true;
+        // Set when [Files] lists the sounds, instead of going by file name.
+        bool HasManifest = false;
+        SSoundSetFiles Files;
+    };
+
+    SSoundSetInfo readSoundSetInfo(const std::filesystem::path& path) {
+        SSoundSetInfo info;
+        const std::string soundSetIni = (path / "SoundSet.ini").string();
+        if (!std::filesystem::exists(soundSetIni))
+            return info;
+
+        CSimpleIniA ini;
+        ini.SetUnicode();
+        if (ini.LoadFile(soundSetIni.c_str()) < 0)
+            return info;
+
+        info.Synth = Util::strcmpwi(ini.GetValue("SoundSet", "Type", ""), "Synth");
+        info.Premix = ini.GetBoolValue("SoundSet", "Premix", true);
+
+        // [Files]
+        // Sub = sub.ogg
+        // Pops = pop_a.ogg, pop_b.ogg
+        std::string sub = ini.GetValue("Files", "Sub", "");
+        std::string pops = ini.GetValue("Files", "Pops", "");
+        if (!sub.empty() && !pops.empty()) {
+            info.HasManifest = true;
+            info.Files.Sub = (path / sub).string();
+            for (const auto& pop : Util::split(pops, ',')) {
+                std::string file = Util::trim_copy(pop);
+                if (!file.empty())
+                    info.Files.Pops.push_back((path / file).string());
+            }
+        }
+        return info;
+    }
+
+    // Single pass over the folder for EX_POP_SUB and EX_POP_<n>, in any supported format.
+    SSoundSetFiles scanSoundSetFiles(const std::filesystem::path& path) {
+        SSoundSetFiles files;
+        std::vector<std::pair<unsigned, std::string>> pops;
+
+        for (const auto& file : std::filesystem::directory_iterator(path)) {
+            const auto& filePath = file.path();
+            const std::string extension = Util::to_lower(filePath.extension().string());
+            const auto& extensions = Audio::AudioExtensions();
+            if (std::find(extensions.begin(), extensions.end(), extension) == extensions.end())
+                continue;
+
+            const std::string stem = Util::to_lower(filePath.stem().string());
+            const std::string popPrefix = "ex_pop_";
+            if (stem.rfind(popPrefix, 0) != 0)
+                continue;
+
+            const std::string suffix = stem.substr(popPrefix.size());
+            if (suffix == "sub") {
+                files.Sub = filePath.string();
+            }
+            else if (!suffix.empty() && std::all_of(suffix.begin(), suffix.end(), [](unsigned char c) { return std::isdigit(c); })) {
+                pops.emplace_back(static_cast<unsigned>(std::stoul(suffix)), filePath.string());
+            }
+        }
+
+        std::sort(pops.begin(), pops.end());
+        for (const auto& [index, file] : pops) {
+            files.Pops.push_back(file);
+        }
+        return files;
+    }
+
+    // Each pop is mixed with the sub, so a loud pop plays as a single sound.
+    // False if any of the files can't be mixed, the layers are then played separately.
+    bool premixSoundSet(const SSoundSetFiles& files, const CSoundSetLoader::CJob& job, SSoundSet& soundSet) {
+        Audio::SPcm sub;
+        if (!Audio::ReadAudio(files.Sub, sub))
+            return false;
+
+        // Decoded already, so the backend doesn't need to read it again.
+        int subId = job.Backend([&]() { return soundBackend->AddSample(files.Sub, sub); });
+        if (subId < 0)
+            return false;
+
+        std::vector<int> mixedPops;
+        for (const auto& popFile : files.Pops) {
+            Audio::SPcm pop;
+            if (!Audio::ReadAudio(popFile, pop))
+                return false;
+
+            const Audio::SPcm mixed = Audio::Mix(pop, sub, Audio::MixSampleRate);
+            int id = job.Backend([&]() { return soundBackend->AddSample(popFile + "+" + files.Sub, mixed); });
+            if (id < 0)
+                return false;
+            mixedPops.push_back(id);
+        }
+
+        soundSet.Pops = mixedPops;
+        soundSet.Sub = subId;
+        soundSet.Premixed = true;
+        return true;
+    }
+
+    bool synthesizeSoundSet(const std::string& soundSetIni, const CSoundSetLoader::CJob& job, SSoundSet& soundSet) {
+        const Audio::SSynthParams params = Audio::ReadSynthParams(soundSetIni);
+        // Backends keep samples by name, so edited parameters need new names.
+        const uint32_t hash = Audio::HashSynthParams(params);
+
+        soundSet.Pops.clear();
+        const auto pops = Audio::SynthesizePops(params);
+        for (size_t i = 0; i < pops.size(); ++i) {
+            int id = job.Backend([&]() {
+                return soundBackend->AddSample(fmt::format("{}:SYNTH_POP_{}_{:08x}", soundSet.Name, i, hash), pops[i]);
+            });
+            if (id < 0)
+                return false;
+            soundSet.Pops.push_back(id);
+        }
+
+        const Audio::SPcm sub = Audio::SynthesizeSub(params);
+        soundSet.Sub = job.Backend([&]() {
+            return soundBackend->AddSample(fmt::format("{}:SYNTH_SUB_{:08x}", soundSet.Name, hash), sub);
+        });
+        if (soundSet.Sub < 0)
+            return false;
+
+        soundSet.Whistles.clear();
+        const auto whistles = Audio::SynthesizeWhistles(params);
+        for (size_t i = 0; i < whistles.size(); ++i) {
+            int id = job.Backend([&]() {
+                return soundBackend->AddSample(fmt::format("{}:SYNTH_WHISTLE_{}_{:08x}", soundSet.Name, i, hash), whistles[i]);
+            });
+            if (id < 0)
+                return false;
+            soundSet.Whistles.push_back(id);
+        }
+
+        soundSet.EffectCount = static_cast<unsigned>(soundSet.Pops.size());
+        soundSet.Premixed = true;
+        soundSet.Synth = true;
+        return true;
+    }
+
+    // Runs on a loader thread.
+    bool loadSoundSet(const SSoundSetFiles& files, bool premix, const CSoundSetLoader::CJob& job, SSoundSet& soundSet) {
+        if (premix) {
+            if (premixSoundSet(files, job, soundSet))
+                return true;
+            if (job.Stale())
+                return false;
+            logger.Write(WARN, "[%s] Couldn't pre-mix sounds, playing layers separately", soundSet.Name.c_str());
+        }
+
+        int sub = job.Backend([&]() { return soundBackend->LoadSample(files.Sub); });
+        if (sub < 0)
+            return false;
+
+        std::vector<int> pops;
+        for (const auto& popFile : files.Pops) {
+            int id = job.Backend([&]() { return soundBackend->LoadSample(popFile); });
+            if (id < 0)
+                return false;
+            pops.push_back(id);
+        }
+
+        soundSet.Pops = pops;
+        soundSet.Sub = sub;
+        return true;
+    }
+}
+
 uint32_t TurboFix::LoadSoundSets() {
     namespace fs = std::filesystem;
 
@@ -229,6 +547,7 @@ uint32_t TurboFix::LoadSoundSets() {
 
     logger.Write(DEBUG, "Clearing and reloading sound sets");
 
+    soundSetLoader->Clear();
     soundSets.clear();
 
     if (!(fs::exists(fs::path(soundSetsPath)) && fs::is_directory(fs::path(soundSetsPath)))) {
@@ -243,30 +562,70 @@ uint32_t TurboFix::LoadSoundSets() {
             continue;
         }
 
-        if (!std::filesystem::exists(path / "EX_POP_SUB.wav")) {
-            logger.Write(WARN, "Skipping [%s] - missing a required sound file (EX_POP_SUB.wav).", path.stem().string().c_str());
+        const std::string name = path.stem().string();
+        const SSoundSetInfo info = readSoundSetInfo(path);
+
+        // Sound sets are added right away, so configs can refer to them. They stay
+        // silent (Sub = -1) until their loader job finishes, see UpdateSoundSets.
+        if (info.Synth) {
+            const std::string soundSetIni = (path / "SoundSet.ini").string();
+            soundSets.push_back(SSoundSet{ name, 0 });
+            soundSetLoader->Queue(soundSets.size() - 1, soundSets.back(), [soundSetIni](SSoundSet& soundSet, const CSoundSetLoader::CJob& job) {
+                return synthesizeSoundSet(soundSetIni, job, soundSet);
+            });
             continue;
         }
 
-        unsigned sfxCount = 0;
-        while (std::filesystem::exists(path / fmt::format("EX_POP_{}.wav", sfxCount))) {
-            ++sfxCount;
+        SSoundSetFiles files = info.HasManifest ? info.Files : scanSoundSetFiles(path);
+
+        if (files.Sub.empty()) {
+            logger.Write(WARN, "Skipping [%s] - missing a required sound file (EX_POP_SUB).", name.c_str());
+            continue;
         }
 
-        // Shouldn't really happen since there's a check for EX_POP_0.wav.
-        if (sfxCount == 0) {
-            logger.Write(WARN, "Skipping [%s] - No sound files found.", path.stem().string().c_str());
+        if (files.Pops.empty()) {
+            logger.Write(WARN, "Skipping [%s] - No sound files found.", name.c_str());
             continue;
         }
 
-        soundSets.push_back(SSoundSet{ fs::path(dirEntry).stem().string(), sfxCount });
-        logger.Write(DEBUG, "Added sound set [%s] with %d sounds", path.stem().string().c_str(), sfxCount);
+        soundSets.push_back(SSoundSet{ name, static_cast<unsigned>(files.Pops.size()) });
+        soundSetLoader->Queue(soundSets.size() - 1, soundSets.back(), [files, premix = info.Premix](SSoundSet& soundSet, const CSoundSetLoader::CJob& job) {
+            return loadSoundSet(files, premix, job, soundSet);
+        });
     }
 
     logger.Write(DEBUG, "Added sound set [NoSound]");
     soundSets.push_back(SSoundSet{ "NoSound", 0 });
 
-    logger.Write(INFO, "Sound sets loaded: %d", soundSets.size());
+    logger.Write(INFO, "Sound sets found: %d, loading in the background", soundSets.size());
+
+    resolveSoundSetIndices();
     
     return static_cast<unsigned>(soundSets.size());
 }
+
+void TurboFix::UpdateSoundSets() {
+    PROFILE_ZONE(SoundSets);
+    for (auto& result : soundSetLoader->TakeFinished()) {
+        if (result.Index >= soundSets.size())
+            continue;
+
+        const std::string& name = result.SoundSet.Name;
+        if (!result.Loaded) {
+            // Kept, so the indices of the others stay valid. It just doesn't play anything.
+            logger.Write(WARN, "[%s] Failed to load sound files.", name.c_str());
+            continue;
+        }
+
+        logger.Write(DEBUG, "Added sound set [%s] with %d %ssounds%s (loaded in %.3f ms)", name.c_str(),
+            result.SoundSet.EffectCount,
+            result.SoundSet.Synth ? "synthesized " : "",
+            result.SoundSet.Premixed && !result.SoundSet.Synth ? ", pre-mixed" : "",
+            result.LoadTimeMs);
+        soundSets[result.Index] = std::move(result.SoundSet);
+    }
+}
+
+size_t TurboFix::GetPendingSoundSets() {
+    return soundSetLoader->Pending();
+}
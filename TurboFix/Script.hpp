@@ -7,6 +7,8 @@ namespace TurboFix {
     void ScriptInit();
     void ScriptTick();
     void UpdateNPC();
+    void UpdateAudio();
+    void UpdatePtfx();
     void UpdateActiveConfigs();
     std::vector<CScriptMenu<CTurboScript>::CSubmenu> BuildMenu();
 
@@ -15,7 +17,13 @@ namespace TurboFix {
     uint64_t GetNPCScriptCount();
     const std::vector<CConfig>& GetConfigs();
     const std::vector<SSoundSet>& GetSoundSets();
+    CAudioThread& GetAudio();
+    const CParticleBudget& GetParticleBudget();
 
     uint32_t LoadConfigs();
+    // Only finds the sound sets, their sounds are loaded in the background.
     uint32_t LoadSoundSets();
+    // Picks up sound sets that finished loading. Call every tick.
+    void UpdateSoundSets();
+    size_t GetPendingSoundSets();
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Util/Profiler.hpp"
+
 #include <menu.h>
 #include <string>
 
@@ -50,6 +52,7 @@ public:
     }
 
     void Tick(T& scriptContext) {
+        PROFILE_ZONE(Menu);
         mMenuBase.CheckKeys();
 
         for (auto& submenu : mSubmenus) {
@@ -21,7 +21,19 @@ void CScriptSettings::Load() {
     SI_Error result = ini.LoadFile(mSettingsFile.c_str());
     CHECK_LOG_SI_ERROR(result, "load");
 
+    Audio.Backend = ini.GetValue("Audio", "Backend", Audio.Backend.c_str());
+    Audio.MaxVoices = ini.GetLongValue("Audio", "MaxVoices", Audio.MaxVoices);
+    Audio.MaxDistance = static_cast<float>(ini.GetDoubleValue("Audio", "MaxDistance", Audio.MaxDistance));
+
+    Ptfx.MaxPerFrame = ini.GetLongValue("Ptfx", "MaxPerFrame", Ptfx.MaxPerFrame);
+    Ptfx.LodDistance = static_cast<float>(ini.GetDoubleValue("Ptfx", "LodDistance", Ptfx.LodDistance));
+    Ptfx.MaxDistance = static_cast<float>(ini.GetDoubleValue("Ptfx", "MaxDistance", Ptfx.MaxDistance));
+
     Debug.NPCDetails = ini.GetBoolValue("Debug", "NPCDetails", false);
+    Debug.SignatureReport = ini.GetBoolValue("Debug", "SignatureReport", false);
+    Debug.BinaryLog = ini.GetBoolValue("Debug", "BinaryLog", false);
+    Debug.TraceSeconds = ini.GetLongValue("Debug", "TraceSeconds", Debug.TraceSeconds);
+    Debug.AllocBudget = ini.GetLongValue("Debug", "AllocBudget", Debug.AllocBudget);
 }
 
 void CScriptSettings::Save() {
@@ -30,7 +42,19 @@ void CScriptSettings::Save() {
     SI_Error result = ini.LoadFile(mSettingsFile.c_str());
     CHECK_LOG_SI_ERROR(result, "load");
 
+    ini.SetValue("Audio", "Backend", Audio.Backend.c_str());
+    ini.SetLongValue("Audio", "MaxVoices", Audio.MaxVoices);
+    ini.SetDoubleValue("Audio", "MaxDistance", Audio.MaxDistance);
+
+    ini.SetLongValue("Ptfx", "MaxPerFrame", Ptfx.MaxPerFrame);
+    ini.SetDoubleValue("Ptfx", "LodDistance", Ptfx.LodDistance);
+    ini.SetDoubleValue("Ptfx", "MaxDistance", Ptfx.MaxDistance);
+
     ini.SetBoolValue("Debug", "NPCDetails", Debug.NPCDetails);
+    ini.SetBoolValue("Debug", "SignatureReport", Debug.SignatureReport);
+    ini.SetBoolValue("Debug", "BinaryLog", Debug.BinaryLog);
+    ini.SetLongValue("Debug", "TraceSeconds", Debug.TraceSeconds);
+    ini.SetLongValue("Debug", "AllocBudget", Debug.AllocBudget);
 
     result = ini.SaveFile(mSettingsFile.c_str());
     CHECK_LOG_SI_ERROR(result, "save");
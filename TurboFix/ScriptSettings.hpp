@@ -12,8 +12,42 @@ public:
 
     } Main;
 
+    struct {
+        // "IrrKlang", "Null" (no sound) or "Recording" (to a WAV file, for testing)
+        std::string Backend = "IrrKlang";
+
+        // Sounds playing at once, over all vehicles.
+        int MaxVoices = 16;
+        // Sounds further away from the camera aren't played.
+        float MaxDistance = 150.0f;
+    } Audio;
+
+    struct {
+        // Backfire effects started per frame, over all vehicles. Closest first.
+        // An exhaust starts 1 to 3: the flame, a delayed second flame and a long flame.
+        int MaxPerFrame = 16;
+        // Further away, vehicles only get a single flame on one exhaust.
+        float LodDistance = 40.0f;
+        // Further away, no flames at all.
+        float MaxDistance = 150.0f;
+    } Ptfx;
+
     struct {
         bool NPCDetails = false;
+
+        // Count matches and time every signature on startup, and compare with the last report.
+        bool SignatureReport = false;
+
+        // Record structured messages (NPC instances, etc.) to TurboFix.blog instead of the
+        // text log, decoded with tools/BinaryLogDecoder. Needs a restart to change.
+        bool BinaryLog = false;
+
+        // Length of a trace started from the profiler menu.
+        int TraceSeconds = 10;
+
+        // Builds with TF_ALLOC_TRACKING=1 warn when a tick makes more heap allocations
+        // than this, after warming up. 0 disables the warning.
+        int AllocBudget = 64;
     } Debug;
 
 private:
@@ -1,7 +1,24 @@
 #pragma once
 #include <string>
+#include <vector>
 
 struct SSoundSet {
     std::string Name;
     unsigned EffectCount;
+
+    // Sound backend sample IDs, decoded once when loading the sound set.
+    // Pops has EffectCount entries. Empty/-1 for NoSound.
+    std::vector<int> Pops;
+    int Sub = -1;
+
+    // Pops already contain the sub layer, so loud pops only need one voice.
+    // Disabled with Premix = false in the sound set's SoundSet.ini.
+    bool Premixed = false;
+
+    // Generated from the [Synth] parameters instead of loaded from files
+    // (Type = Synth in SoundSet.ini). Played back with the pitch following RPM and boost.
+    bool Synth = false;
+
+    // Turbo whistles played with loud pops, only synthesized sound sets have them.
+    std::vector<int> Whistles;
 };
@@ -0,0 +1,385 @@
+#include "StressTest.hpp"
+
+#include "Script.hpp"
+#include "Memory/VehicleExtensions.hpp"
+#include "Util/AllocTracker.hpp"
+#include "Util/Logger.hpp"
+#include "Util/Profiler.hpp"
+#include "Util/UI.hpp"
+
+#include <inc/enums.h>
+#include <inc/natives.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+using VExt = VehicleExtensions;
+
+namespace {
+    constexpr std::array<unsigned, 8> steps = { 10, 25, 50, 100, 200, 400, 700, 1024 };
+
+    // Recorded frames per step, after all vehicles spawned.
+    constexpr unsigned FramesPerStep = 300;
+    // Spawning is slow, spread it out over a few frames.
+    constexpr unsigned SpawnsPerFrame = 32;
+    // Fraction of the vehicles despawned or killed every frame.
+    constexpr float ChurnPerFrame = 0.005f;
+    // Killed vehicles stay around for a bit, so the NPC update sees them dead.
+    constexpr unsigned DeadFrames = 10;
+
+    constexpr unsigned GridSize = 32;
+    constexpr float GridSpacing = 6.0f;
+
+    // Vehicles are blown up away from the grid, so the blast doesn't take out
+    // their neighbours too. Enough spots for everything churned in DeadFrames.
+    constexpr unsigned BlastSpots = 64;
+    constexpr float BlastSpacing = 50.0f;
+    constexpr float BlastDistance = 100.0f;
+    // One throttle-on, throttle-off cycle.
+    constexpr float ProfileCycleSec = 3.0f;
+    constexpr float ProfileOnFraction = 0.6f;
+
+    enum class EState {
+        Idle,
+        Loading,
+        Running,
+    };
+
+    struct SVehicle {
+        Vehicle Handle;
+        // Offset into the profile, so they don't all lift at once.
+        float Phase;
+    };
+
+    struct SDeadVehicle {
+        Vehicle Handle;
+        unsigned FramesLeft;
+    };
+
+    struct SFrame {
+        double ScriptUs;
+        double NPCUs;
+        // All Turbo zones of the frame, one per instance.
+        double TurboUs;
+        uint64_t TurboRuns;
+    };
+
+    EState state = EState::Idle;
+    Hash model = 0;
+    Vector3 origin{};
+
+    std::vector<SVehicle> vehicles;
+    std::vector<SDeadVehicle> deadVehicles;
+    unsigned nextSlot = 0;
+    unsigned nextBlastSpot = 0;
+    bool poolFull = false;
+    // Tracked vehicles that died or disappeared without being churned.
+    unsigned lostVehicles = 0;
+
+    size_t stepIndex = 0;
+    // Set once the step reached its target. Churned vehicles are topped up while recording.
+    bool stepFilled = false;
+    unsigned stepFrame = 0;
+    std::vector<SFrame> stepFrames;
+    // Turbo zone totals as of the previous Update.
+    Profiler::SZoneStats lastTurbo{};
+
+    float churnDebt = 0.0f;
+    uint32_t rngState = 0x12345678;
+
+    std::ofstream csv;
+
+    uint32_t nextRandom() {
+        // xorshift32, good enough to pick vehicles.
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 17;
+        rngState ^= rngState << 5;
+        return rngState;
+    }
+
+    void deleteVehicle(Vehicle handle) {
+        if (!ENTITY::DOES_ENTITY_EXIST(handle))
+            return;
+        ENTITY::SET_ENTITY_AS_MISSION_ENTITY(handle, true, true);
+        VEHICLE::DELETE_VEHICLE(&handle);
+    }
+
+    Vector3 blastSpot() {
+        unsigned spot = nextBlastSpot++ % BlastSpots;
+        const unsigned columns = 8;
+        Vector3 position = origin;
+        position.x += (static_cast<float>(spot % columns) - columns / 2.0f) * BlastSpacing;
+        position.y += GridSize * GridSpacing / 2.0f + BlastDistance + static_cast<float>(spot / columns) * BlastSpacing;
+        return position;
+    }
+
+    bool spawnVehicle() {
+        unsigned slot = nextSlot++ % (GridSize * GridSize);
+        Vector3 position = origin;
+        position.x += (static_cast<float>(slot % GridSize) - GridSize / 2.0f) * GridSpacing;
+        position.y += (static_cast<float>(slot / GridSize) - GridSize / 2.0f) * GridSpacing;
+
+        Vehicle handle = VEHICLE::CREATE_VEHICLE(model, position, 0.0f, false, true, false);
+        if (handle == 0)
+            return false;
+
+        ENTITY::SET_ENTITY_AS_MISSION_ENTITY(handle, true, true);
+        ENTITY::FREEZE_ENTITY_POSITION(handle, true);
+        ENTITY::SET_ENTITY_COLLISION(handle, false, false);
+        VEHICLE::SET_VEHICLE_MOD_KIT(handle, 0);
+        VEHICLE::TOGGLE_VEHICLE_MOD(handle, VehicleToggleModTurbo, true);
+        VEHICLE::SET_VEHICLE_ENGINE_ON(handle, true, true, true);
+
+        float phase = static_cast<float>(nextRandom() % 1000) / 1000.0f * ProfileCycleSec;
+        vehicles.push_back({ handle, phase });
+        return true;
+    }
+
+    // Throttle on while the RPM climbs, then off while it drops: lift-off is what
+    // triggers the anti-lag effects.
+    void applyProfile(const SVehicle& vehicle, float timeSec) {
+        float cycle = std::fmod(timeSec + vehicle.Phase, ProfileCycleSec) / ProfileCycleSec;
+        float throttle;
+        float rpm;
+        if (cycle < ProfileOnFraction) {
+            throttle = 1.0f;
+            rpm = 0.2f + 0.8f * cycle / ProfileOnFraction;
+        }
+        else {
+            throttle = 0.0f;
+            rpm = 1.0f - 0.8f * (cycle - ProfileOnFraction) / (1.0f - ProfileOnFraction);
+        }
+
+        VExt::SetThrottle(vehicle.Handle, throttle);
+        VExt::SetThrottleP(vehicle.Handle, throttle);
+        VExt::SetCurrentRPM(vehicle.Handle, rpm);
+    }
+
+    void churn() {
+        churnDebt += static_cast<float>(vehicles.size()) * ChurnPerFrame;
+        while (churnDebt >= 1.0f && !vehicles.empty()) {
+            churnDebt -= 1.0f;
+
+            size_t index = nextRandom() % vehicles.size();
+            Vehicle handle = vehicles[index].Handle;
+            vehicles[index] = vehicles.back();
+            vehicles.pop_back();
+
+            if (nextRandom() % 2 == 0) {
+                deleteVehicle(handle);
+            }
+            else {
+                Vector3 spot = blastSpot();
+                ENTITY::SET_ENTITY_COORDS(handle, spot, false, false, false, false);
+                VEHICLE::EXPLODE_VEHICLE(handle, false, true);
+                deadVehicles.push_back({ handle, DeadFrames });
+            }
+        }
+
+        for (auto& dead : deadVehicles) {
+            if (--dead.FramesLeft == 0)
+                deleteVehicle(dead.Handle);
+        }
+        deadVehicles.erase(std::remove_if(deadVehicles.begin(), deadVehicles.end(),
+            [](const auto& dead) { return dead.FramesLeft == 0; }), deadVehicles.end());
+    }
+
+    // Only vehicles that are still alive count towards the target. Anything that
+    // died some other way is cleaned up like the churned ones.
+    void pruneVehicles() {
+        for (size_t i = vehicles.size(); i-- > 0;) {
+            Vehicle handle = vehicles[i].Handle;
+            bool exists = ENTITY::DOES_ENTITY_EXIST(handle);
+            if (exists && !ENTITY::IS_ENTITY_DEAD(handle, 0))
+                continue;
+
+            if (exists)
+                deadVehicles.push_back({ handle, DeadFrames });
+            vehicles[i] = vehicles.back();
+            vehicles.pop_back();
+            ++lostVehicles;
+        }
+    }
+
+    // Previous frame: EndFrame and the profiler zones ran after the last Update.
+    void recordFrame(double turboUs, uint64_t turboRuns) {
+        auto script = Profiler::Stats(Profiler::EZone::ScriptTick);
+        auto npc = Profiler::Stats(Profiler::EZone::NPC);
+
+        uint64_t allocs = 0;
+        uint64_t bytes = 0;
+        if constexpr (AllocTracker::Enabled) {
+            // Untagged is last, and includes the spawning done here.
+            for (size_t i = 0; i + 1 < AllocTracker::TagCount(); ++i) {
+                auto stats = AllocTracker::Stats(i);
+                allocs += stats.LastAllocs;
+                bytes += stats.LastBytes;
+            }
+        }
+
+        char line[160];
+        snprintf(line, sizeof(line), "%u,%u,%llu,%llu,%.2f,%.2f,%.2f,%llu,%llu,%u\n",
+            steps[stepIndex], stepFrame, static_cast<unsigned long long>(vehicles.size()),
+            static_cast<unsigned long long>(TurboFix::GetNPCScriptCount()),
+            script.LastUs, npc.LastUs, turboUs,
+            static_cast<unsigned long long>(allocs), static_cast<unsigned long long>(bytes), lostVehicles);
+        csv << line;
+
+        stepFrames.push_back({ script.LastUs, npc.LastUs, turboUs, turboRuns });
+    }
+
+    void finishStep() {
+        std::vector<double> npcUs;
+        double scriptSum = 0.0;
+        double turboSum = 0.0;
+        uint64_t turboRuns = 0;
+        for (const auto& frame : stepFrames) {
+            npcUs.push_back(frame.NPCUs);
+            scriptSum += frame.ScriptUs;
+            turboSum += frame.TurboUs;
+            turboRuns += frame.TurboRuns;
+        }
+        std::sort(npcUs.begin(), npcUs.end());
+
+        double npcSum = 0.0;
+        for (double us : npcUs) {
+            npcSum += us;
+        }
+        double count = static_cast<double>(std::max<size_t>(npcUs.size(), 1));
+        double npcP95 = npcUs.empty() ? 0.0 : npcUs[std::min(npcUs.size() - 1, npcUs.size() * 95 / 100)];
+        double npcMax = npcUs.empty() ? 0.0 : npcUs.back();
+
+        logger.Write(INFO, "[Stress] %u vehicles (target %u): %llu instances, NPC avg %.1f us, p95 %.1f us, max %.1f us, tick avg %.1f us, "
+            "Turbo avg %.1f us per frame, %.3f us per instance",
+            static_cast<unsigned>(vehicles.size()), steps[stepIndex],
+            static_cast<unsigned long long>(TurboFix::GetNPCScriptCount()),
+            npcSum / count, npcP95, npcMax, scriptSum / count,
+            turboSum / count, turboRuns == 0 ? 0.0 : turboSum / static_cast<double>(turboRuns));
+
+        stepFrames.clear();
+        stepFilled = false;
+        stepFrame = 0;
+        ++stepIndex;
+    }
+}
+
+void StressTest::Start(const std::string& csvFile) {
+    if (state != EState::Idle)
+        return;
+
+    csv.open(csvFile, std::ofstream::out | std::ofstream::trunc);
+    if (!csv.is_open()) {
+        logger.Write(ERROR, "[Stress] Couldn't open [%s]", csvFile.c_str());
+        return;
+    }
+    csv << "target,frame,vehicles,instances,script_us,npc_us,turbo_us,allocs,alloc_bytes,lost\n";
+
+    model = MISC::GET_HASH_KEY("sultan");
+    STREAMING::REQUEST_MODEL(model);
+    origin = ENTITY::GET_ENTITY_COORDS(PLAYER::PLAYER_PED_ID(), true);
+
+    stepIndex = 0;
+    stepFilled = false;
+    stepFrame = 0;
+    stepFrames.clear();
+    nextSlot = 0;
+    nextBlastSpot = 0;
+    poolFull = false;
+    lostVehicles = 0;
+    churnDebt = 0.0f;
+    lastTurbo = Profiler::Stats(Profiler::EZone::Turbo);
+    state = EState::Loading;
+    logger.Write(INFO, "[Stress] Started, writing to [%s]", csvFile.c_str());
+}
+
+void StressTest::Stop() {
+    if (state == EState::Idle)
+        return;
+
+    for (const auto& vehicle : vehicles) {
+        deleteVehicle(vehicle.Handle);
+    }
+    for (const auto& dead : deadVehicles) {
+        deleteVehicle(dead.Handle);
+    }
+    vehicles.clear();
+    deadVehicles.clear();
+
+    STREAMING::SET_MODEL_AS_NO_LONGER_NEEDED(model);
+    csv.close();
+    state = EState::Idle;
+    logger.Write(INFO, "[Stress] Stopped after %u of %u steps, %u vehicle(s) lost outside of churn",
+        static_cast<unsigned>(stepIndex), static_cast<unsigned>(steps.size()), lostVehicles);
+}
+
+void StressTest::Update() {
+    if (state == EState::Loading) {
+        if (!STREAMING::HAS_MODEL_LOADED(model))
+            return;
+        state = EState::Running;
+    }
+
+    if (state != EState::Running)
+        return;
+
+    const unsigned target = steps[stepIndex];
+    pruneVehicles();
+
+    // Turbo runs once per instance, so the zone's total tells the frame's cost.
+    auto turbo = Profiler::Stats(Profiler::EZone::Turbo);
+    if (turbo.Count < lastTurbo.Count)
+        lastTurbo = {};
+    double turboUs = turbo.TotalUs - lastTurbo.TotalUs;
+    uint64_t turboRuns = turbo.Count - lastTurbo.Count;
+    lastTurbo = turbo;
+
+    // Top up to the target. Frames only count once it was reached, or the game
+    // ran out of vehicles. Spawning isn't in any profiler zone.
+    unsigned spawned = 0;
+    while (!poolFull && vehicles.size() < target && spawned < SpawnsPerFrame) {
+        if (!spawnVehicle()) {
+            poolFull = true;
+            logger.Write(WARN, "[Stress] Couldn't spawn more than %u vehicles", static_cast<unsigned>(vehicles.size()));
+            break;
+        }
+        ++spawned;
+    }
+
+    if (vehicles.size() >= target || poolFull)
+        stepFilled = true;
+
+    if (stepFilled) {
+        if (stepFrame > 0)
+            recordFrame(turboUs, turboRuns);
+        ++stepFrame;
+
+        if (stepFrame > FramesPerStep) {
+            finishStep();
+            if (stepIndex == steps.size()) {
+                Stop();
+                UI::Notify("Stress test done", true);
+                return;
+            }
+        }
+    }
+
+    churn();
+
+    float timeSec = static_cast<float>(MISC::GET_GAME_TIMER()) / 1000.0f;
+    for (const auto& vehicle : vehicles) {
+        applyProfile(vehicle, timeSec);
+    }
+}
+
+StressTest::SStatus StressTest::Status() {
+    return {
+        state != EState::Idle,
+        static_cast<unsigned>(stepIndex),
+        static_cast<unsigned>(steps.size()),
+        stepIndex < steps.size() ? steps[stepIndex] : 0,
+        static_cast<unsigned>(vehicles.size()),
+        lostVehicles,
+    };
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <string>
+
+// Measures how the NPC script instances scale with the number of turbo vehicles.
+// Spawns frozen turbo vehicles around the player in steps from 10 to 1024, runs
+// them through scripted RPM and throttle profiles, and keeps despawning, killing
+// and respawning some. Killed vehicles are blown up away from the others.
+// Every frame of every step is written to a CSV file.
+namespace StressTest {
+    struct SStatus {
+        bool Running;
+        unsigned Step;
+        unsigned Steps;
+        unsigned Target;
+        // Spawned vehicles that are still alive.
+        unsigned Vehicles;
+        // Vehicles that died or disappeared without being churned.
+        unsigned Lost;
+    };
+
+    void Start(const std::string& csvFile);
+    // Deletes all spawned vehicles. Also called when the last step is done.
+    void Stop();
+
+    // Call once per tick, before the script instances tick.
+    void Update();
+
+    SStatus Status();
+}
@@ -2,10 +2,17 @@
 #include "Script.hpp"
 #include "TurboScript.hpp"
 #include "Constants.hpp"
+#include "StressTest.hpp"
 
 #include "Memory/Patches.h"
+#include "Ptfx/PtfxAssets.hpp"
 #include "ScriptMenuUtils.h"
 
+#include "Util/AllocTracker.hpp"
+#include "Util/BinaryLog.hpp"
+#include "Util/Logger.hpp"
+#include "Util/Paths.hpp"
+#include "Util/Profiler.hpp"
 #include "Util/UI.hpp"
 #include "Util/Math.hpp"
 
@@ -185,8 +192,8 @@ std::vector<CScriptMenu<CTurboScript>::CSubmenu> TurboFix::BuildMenu() {
         for (const auto& soundset : TurboFix::GetSoundSets()) {
             soundSetsStr.push_back(soundset.Name);
         }
-        if (mbCtx.StringArray("Sound set", soundSetsStr, context.SoundSetIndex())) {
-            config->AntiLag.SoundSet = TurboFix::GetSoundSets()[context.SoundSetIndex()].Name;
+        if (mbCtx.StringArray("Sound set", soundSetsStr, config->AntiLag.SoundSetIndex)) {
+            config->AntiLag.SoundSet = TurboFix::GetSoundSets()[config->AntiLag.SoundSetIndex].Name;
         }
         mbCtx.FloatOptionCb("Volume", config->AntiLag.Volume, 0.0f, 2.0f, 0.05f, MenuUtils::GetKbFloat);
     });
@@ -314,6 +321,146 @@ std::vector<CScriptMenu<CTurboScript>::CSubmenu> TurboFix::BuildMenu() {
             { "TurboFix works for all NPC vehicles with the turbo upgrade installed.",
               "This is the number of vehicles the script is working for." });
         mbCtx.BoolOption("NPC Details", TurboFix::GetSettings().Debug.NPCDetails);
+
+        mbCtx.MenuOption("Profiler", "profilermenu",
+            { "Time spent in each part of the script tick." });
+
+        mbCtx.MenuOption("Allocations", "allocationsmenu",
+            { "Heap allocations per tick, for each part of the script tick." });
+
+        auto stressStatus = StressTest::Status();
+        const std::string stressPath =
+            Paths::GetModuleFolder(Paths::GetOurModuleHandle()) + Constants::ModDir + "\\stress.csv";
+        if (mbCtx.Option(stressStatus.Running ?
+                fmt::format("Stop stress test (step {}/{}, {}/{} vehicles)",
+                    stressStatus.Step + 1, stressStatus.Steps, stressStatus.Vehicles, stressStatus.Target) :
+                "Start stress test",
+            { "Spawns turbo vehicles around the player, from 10 up to 1024, and keeps replacing some.",
+              fmt::format("Frame times, allocations and NPC instances for each step go to [{}].", stressPath),
+              "A summary of each step goes to the log.",
+              "Allocations need a build with TF_ALLOC_TRACKING=1." })) {
+            if (stressStatus.Running)
+                StressTest::Stop();
+            else
+                StressTest::Start(stressPath);
+        }
+
+        auto voiceStats = TurboFix::GetAudio().Stats();
+        mbCtx.Option(fmt::format("Sound voices: {}/{}", voiceStats.Active, TurboFix::GetSettings().Audio.MaxVoices),
+            { fmt::format("Played: {}", voiceStats.Played),
+              fmt::format("Culled: {}", voiceStats.Culled),
+              fmt::format("Stolen: {}", voiceStats.Stolen),
+              fmt::format("Dropped commands: {}", TurboFix::GetAudio().Dropped()),
+              "Limits are set in settings_general.ini, [Audio]." });
+
+        mbCtx.Option(fmt::format("Sound sets loading: {}", TurboFix::GetPendingSoundSets()),
+            { "Sound sets are decoded in the background. They're silent until loaded." });
+
+        const auto& ptfxStats = TurboFix::GetParticleBudget().Stats();
+        mbCtx.Option(fmt::format("Ptfx spawned: {}, exhausts dropped: {}", ptfxStats.Spawned, ptfxStats.Dropped),
+            { "Spawned counts effects, up to 3 per exhaust. Dropped and culled count exhausts.",
+              fmt::format("Culled (distance): {}", ptfxStats.Culled),
+              fmt::format("Effects last frame: {}/{}", ptfxStats.LastFrameEffects, TurboFix::GetSettings().Ptfx.MaxPerFrame),
+              fmt::format("Exhausts last frame: {}", ptfxStats.LastFrameRequests),
+              "Limits are set in settings_general.ini, [Ptfx]." });
+
+        mbCtx.Option(fmt::format("Ptfx asset users: {}", PtfxAssets::References()),
+            { fmt::format("weap_sm_bom: {}", PtfxAssets::Loaded(PtfxAssets::EAsset::WeapSmBom) ? "Loaded" : "Not loaded"),
+              fmt::format("veh_sanctus: {}", PtfxAssets::Loaded(PtfxAssets::EAsset::VehSanctus) ? "Loaded" : "Not loaded"),
+              fmt::format("turbo_flame: {}", PtfxAssets::Loaded(PtfxAssets::EAsset::TurboFlame) ? "Loaded" : "Not loaded") });
+
+        mbCtx.Option(fmt::format("Log messages dropped: {}", logger.Dropped()),
+            { "Messages that didn't fit in the log queue.",
+              fmt::format("Binary log: {}, dropped: {}", BinaryLog::Enabled() ? "Recording" : "Off", BinaryLog::Dropped()) });
+
+        for (const auto& patch : Patches::GetStatus()) {
+            std::string state = !patch.Found ? "Not found" : (patch.Patched ? "Patched" : "Intact");
+            mbCtx.Option(fmt::format("Patch: {} ({})", patch.Name, state),
+                { fmt::format("Address: 0x{:X}", patch.Address),
+                  fmt::format("Scan time: {:.3f} ms", patch.ScanTimeMs) });
+        }
+    });
+
+    /* mainmenu -> developermenu -> profilermenu */
+    submenus.emplace_back("profilermenu", [](NativeMenu::Menu& mbCtx, CTurboScript& context) {
+        mbCtx.Title("Profiler");
+        mbCtx.Subtitle("");
+
+        if (!Profiler::Enabled) {
+            mbCtx.Option("Not available",
+                { "This build was compiled with TF_PROFILER=0." });
+            return;
+        }
+
+        for (size_t i = 0; i < static_cast<size_t>(Profiler::EZone::Count); ++i) {
+            auto stats = Profiler::Stats(static_cast<Profiler::EZone>(i));
+            mbCtx.Option(fmt::format("{}: {:.1f} us (p99 {:.1f})", stats.Name, stats.P50Us, stats.P99Us),
+                { fmt::format("Count: {}", stats.Count),
+                  fmt::format("Average: {:.2f} us", stats.AvgUs),
+                  fmt::format("p50: {:.2f} us", stats.P50Us),
+                  fmt::format("p95: {:.2f} us", stats.P95Us),
+                  fmt::format("p99: {:.2f} us", stats.P99Us),
+                  fmt::format("Max: {:.2f} us", stats.MaxUs) });
+        }
+
+        if (mbCtx.Option("Reset", { "Clear all zones." })) {
+            Profiler::Reset();
+        }
+
+        auto traceStatus = Profiler::TraceStatus();
+        const std::string tracePath =
+            Paths::GetModuleFolder(Paths::GetOurModuleHandle()) + Constants::ModDir + "\\trace.json";
+        if (mbCtx.Option(traceStatus.Recording ? fmt::format("Recording trace... ({} events)", traceStatus.Events) : "Record trace",
+            { fmt::format("Records every zone for {} seconds, then writes [{}].", TurboFix::GetSettings().Debug.TraceSeconds, tracePath),
+              "Open it in chrome://tracing or ui.perfetto.dev.",
+              "NPCTick events show the vehicle handle.",
+              "Gaps between ScriptTick events are the script waiting for the next frame.",
+              "Length is set in settings_general.ini, [Debug] TraceSeconds." })) {
+            Profiler::StartTrace(tracePath, std::max(TurboFix::GetSettings().Debug.TraceSeconds, 1));
+        }
+
+        const std::string dumpPath =
+            Paths::GetModuleFolder(Paths::GetOurModuleHandle()) + Constants::ModDir + "\\profile.txt";
+        if (mbCtx.Option("Dump to file", { fmt::format("Writes all zones to [{}].", dumpPath) })) {
+            if (Profiler::Dump(dumpPath))
+                UI::Notify("Profiler results saved", true);
+            else
+                UI::Notify("Failed to save profiler results", true);
+        }
+    });
+
+    /* mainmenu -> developermenu -> allocationsmenu */
+    submenus.emplace_back("allocationsmenu", [](NativeMenu::Menu& mbCtx, CTurboScript& context) {
+        mbCtx.Title("Allocations");
+        mbCtx.Subtitle(fmt::format("{} frames", AllocTracker::Frames()));
+
+        if (!AllocTracker::Enabled) {
+            mbCtx.Option("Not available",
+                { "Build with TF_ALLOC_TRACKING=1 to count allocations." });
+            return;
+        }
+
+        for (size_t i = 0; i < AllocTracker::TagCount(); ++i) {
+            auto stats = AllocTracker::Stats(i);
+            mbCtx.Option(fmt::format("{}: {:.1f}/frame ({:.0f} B)", stats.Name, stats.AvgAllocs, stats.AvgBytes),
+                { fmt::format("Last frame: {} ({} B)", stats.LastAllocs, stats.LastBytes),
+                  fmt::format("Average: {:.2f} ({:.1f} B)", stats.AvgAllocs, stats.AvgBytes),
+                  fmt::format("Max: {} ({} B)", stats.MaxAllocs, stats.MaxBytes),
+                  "Untagged includes allocations on other threads." });
+        }
+
+        if (mbCtx.Option("Reset", { "Clear all counters." })) {
+            AllocTracker::Reset();
+        }
+
+        const std::string dumpPath =
+            Paths::GetModuleFolder(Paths::GetOurModuleHandle()) + Constants::ModDir + "\\allocations.txt";
+        if (mbCtx.Option("Dump to file", { fmt::format("Writes all tags to [{}].", dumpPath) })) {
+            if (AllocTracker::Dump(dumpPath))
+                UI::Notify("Allocation counts saved", true);
+            else
+                UI::Notify("Failed to save allocation counts", true);
+        }
     });
 
     return submenus;
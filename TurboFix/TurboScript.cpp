@@ -3,9 +3,13 @@
 #include "Compatibility.h"
 #include "Constants.hpp"
 #include "Memory/NativeMemory.hpp"
+#include "Memory/Signatures.hpp"
+#include "Ptfx/PtfxAssets.hpp"
+#include "Util/Logger.hpp"
 #include "Util/Game.hpp"
 #include "Util/Math.hpp"
 #include "Util/Paths.hpp"
+#include "Util/Profiler.hpp"
 #include "Util/UI.hpp"
 #include "Util/String.hpp"
 
@@ -14,43 +18,80 @@
 #include <fmt/format.h>
 #include <DirectXMath.h>
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <filesystem>
+#include <unordered_map>
 
 using namespace DirectX;
 using VExt = VehicleExtensions;
 
 // Thanks @alexguirre for this! Fixes ptfx positions for tuned exhausts.
 using CVehicle_GetExhaust_t = void(*)(/*CVehicle*/void*, uint32_t exhaustBoneId, XMMATRIX& outTransform, uint32_t& outId);
-static CVehicle_GetExhaust_t CVehicle_GetExhaust = []() {
-    return (CVehicle_GetExhaust_t)(mem::FindPattern("48 8B D9 44 0F 29 48 ? 48 8B 41 20 48 8B 80 ? ? ? ? 48 8B 00") - 0x39);
-}();
+static CVehicle_GetExhaust_t CVehicle_GetExhaust = nullptr;
+
+// Shared by all instances, vehicles of the same model only need to be looked at once.
+static CExhaustCache exhaustCache;
+
+// Exhaust bone IDs 56 (exhaust) to 87 (exhaust_32).
+static constexpr std::array<const char*, 32> exhaustBones{
+    "exhaust",    "exhaust_2",  "exhaust_3",  "exhaust_4",
+    "exhaust_5",  "exhaust_6",  "exhaust_7",  "exhaust_8",
+    "exhaust_9",  "exhaust_10", "exhaust_11", "exhaust_12",
+    "exhaust_13", "exhaust_14", "exhaust_15", "exhaust_16",
+    "exhaust_17", "exhaust_18", "exhaust_19", "exhaust_20",
+    "exhaust_21", "exhaust_22", "exhaust_23", "exhaust_24",
+    "exhaust_25", "exhaust_26", "exhaust_27", "exhaust_28",
+    "exhaust_29", "exhaust_30", "exhaust_31", "exhaust_32",
+};
+
+// Model -> bone indices of exhaustBones it has, in that order.
+static std::unordered_map<Hash, std::vector<int>> exhaustBoneIndexCache;
+
+// Util/Math.hpp's generic Vector3 operator- clashes with chrono's, so call that one explicitly.
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(std::chrono::operator-(now, start)).count();
+}
+
+void CTurboScript::InitPatterns() {
+    auto addr = mem::FindPattern(Signatures::GetExhaust);
+    if (!addr) {
+        logger.Write(ERROR, "Couldn't find CVehicle::GetExhaust");
+        return;
+    }
+    CVehicle_GetExhaust = (CVehicle_GetExhaust_t)(addr - 0x39);
+}
 
 CTurboScript::CTurboScript(
     CScriptSettings& settings,
     std::vector<CConfig>& configs,
-    std::vector<SSoundSet>& soundSets)
+    std::vector<SSoundSet>& soundSets,
+    CAudioThread& audio,
+    CParticleBudget& particleBudget)
     : mSettings(settings)
     , mConfigs(configs)
-    , mDefaultConfig(configs[0])
+    , mDefaultConfig()
     , mVehicle(0)
     , mActiveConfig(nullptr)
     , mLastFxTime(0)
     , mLastLoudTime(0)
     , mLastThrottle(0)
+    , mSnapshot{}
+    , mPtfxAssetsAcquired(false)
     , mSoundSets(soundSets)
-    , mSoundSetIndex(0)
+    , mAudio(audio)
+    , mParticleBudget(particleBudget)
     , mIsNPC(false) {
-
-    mSoundEngine = irrklang::createIrrKlangDevice(irrklang::ESOD_DIRECT_SOUND_8);
-    mSoundEngine->setDefault3DSoundMinDistance(7.5f);
-    mSoundEngine->setSoundVolume(0.20f);
 }
 
 CTurboScript::~CTurboScript() {
-        // Remove PTFX assets
-    STREAMING::REMOVE_NAMED_PTFX_ASSET("weap_sm_bom");
-    STREAMING::REMOVE_NAMED_PTFX_ASSET("veh_sanctus");
-    STREAMING::REMOVE_NAMED_PTFX_ASSET("turbo_flame");
+    // Stops a long flame that's still burning.
+    mEffects.Clear();
+
+    // Assets are only removed when no other instance uses them.
+    if (mPtfxAssetsAcquired)
+        PtfxAssets::Release();
 }
 
 void CTurboScript::UpdateActiveConfig(bool playerCheck) {
@@ -80,8 +121,15 @@ void CTurboScript::UpdateActiveConfig(bool playerCheck) {
         });
     }
 
-    // third pass - use default
+    // third pass - use default, which is always first.
+    // A copy, so edits only apply to this vehicle. Its sound set index is
+    // resolved again when sound sets are reloaded, see TurboFix::LoadSoundSets.
     if (foundConfig == mConfigs.end()) {
+        if (mConfigs.empty()) {
+            mActiveConfig = nullptr;
+            return;
+        }
+        mDefaultConfig = mConfigs[0];
         mActiveConfig = &mDefaultConfig;
     }
     else {
@@ -91,8 +139,6 @@ void CTurboScript::UpdateActiveConfig(bool playerCheck) {
     if (mActiveConfig->Turbo.ForceTurbo && !VEHICLE::IS_TOGGLE_MOD_ON(mVehicle, VehicleToggleModTurbo)) {
         VEHICLE::TOGGLE_VEHICLE_MOD(mVehicle, VehicleToggleModTurbo, true);
     }
-
-    updateSoundSetIndex(mActiveConfig->AntiLag.SoundSet);
 }
 
 void CTurboScript::ApplyConfig(const CConfig& config) {
@@ -122,6 +168,7 @@ void CTurboScript::ApplyConfig(const CConfig& config) {
     mActiveConfig->AntiLag.LoudOffThrottle = config.AntiLag.LoudOffThrottle;
     mActiveConfig->AntiLag.LoudOffThrottleIntervalMs = config.AntiLag.LoudOffThrottleIntervalMs;
     mActiveConfig->AntiLag.SoundSet = config.AntiLag.SoundSet;
+    mActiveConfig->AntiLag.SoundSetIndex = config.AntiLag.SoundSetIndex;
     mActiveConfig->AntiLag.Volume = config.AntiLag.Volume;
 
     mActiveConfig->Dial.BoostOffset = config.Dial.BoostOffset;
@@ -129,11 +176,12 @@ void CTurboScript::ApplyConfig(const CConfig& config) {
     mActiveConfig->Dial.VacuumOffset = config.Dial.VacuumOffset;
     mActiveConfig->Dial.VacuumScale = config.Dial.VacuumScale;
     mActiveConfig->Dial.BoostIncludesVacuum = config.Dial.BoostIncludesVacuum;
-
-    updateSoundSetIndex(mActiveConfig->AntiLag.SoundSet);
 }
 
 void CTurboScript::Tick() {
+    PROFILE_ZONE(PlayerTick);
+    mEffects.Update(MISC::GET_GAME_TIMER());
+
     Vehicle playerVehicle = PED::GET_VEHICLE_PED_IS_IN(PLAYER::PLAYER_PED_ID(), false);
 
     // Update active vehicle and config
@@ -143,11 +191,27 @@ void CTurboScript::Tick() {
         UpdateActiveConfig(true);
     }
 
+    updatePtfxAssets();
+
     if (mActiveConfig && Util::VehicleAvailable(mVehicle, PLAYER::PLAYER_PED_ID(), false)) {
         updateTurbo();
     }
 }
 
+// Holds the ptfx assets while the active config can fire backfires, so they're
+// loaded before the first one.
+void CTurboScript::updatePtfxAssets() {
+    bool needed = mActiveConfig && mActiveConfig->AntiLag.Enable && mActiveConfig->AntiLag.Effects;
+    if (needed == mPtfxAssetsAcquired)
+        return;
+
+    if (needed)
+        PtfxAssets::Acquire();
+    else
+        PtfxAssets::Release();
+    mPtfxAssetsAcquired = needed;
+}
+
 bool CTurboScript::GetHasTurbo() {
     return VEHICLE::IS_TOGGLE_MOD_ON(mVehicle, VehicleToggleModTurbo);
 }
@@ -159,8 +223,8 @@ float CTurboScript::GetCurrentBoost() {
 }
 
 float CTurboScript::updateAntiLag(float currentBoost, float newBoost, float limBoost) {
-    float currentThrottle = VExt::GetThrottleP(mVehicle);
-    if (abs(VExt::GetThrottleP(mVehicle)) < 0.1f && VExt::GetCurrentRPM(mVehicle) > mActiveConfig->AntiLag.MinRPM) {
+    float currentThrottle = mSnapshot.ThrottleP;
+    if (abs(currentThrottle) < 0.1f && mSnapshot.RPM > mActiveConfig->AntiLag.MinRPM) {
         if (mActiveConfig->AntiLag.Effects) {
             int delayMs = mLastFxTime + rand() % mActiveConfig->AntiLag.RandomMs + mActiveConfig->AntiLag.PeriodMs;
             int gameTime = MISC::GET_GAME_TIMER();
@@ -242,66 +306,145 @@ void CTurboScript::updateDial(float newBoost) {
     }
 }
 
-void firePtfx(Entity vehicle, float boneOffX, float boneOffY, float boneOffZ,
-    float boneRotX, float boneRotY, float boneRotZ, float explSz) {
-    static int longFlameHandle = -1;
-    bool checkPtfxAsset = STREAMING::HAS_NAMED_PTFX_ASSET_LOADED("weap_sm_bom") && STREAMING::HAS_NAMED_PTFX_ASSET_LOADED("veh_sanctus");
-    if (!checkPtfxAsset) {
-        STREAMING::REQUEST_NAMED_PTFX_ASSET("weap_sm_bom");
-        STREAMING::REQUEST_NAMED_PTFX_ASSET("veh_sanctus");
-        STREAMING::REQUEST_NAMED_PTFX_ASSET("turbo_flame");
-    }
-    if (longFlameHandle != -1) {
-        GRAPHICS::STOP_PARTICLE_FX_LOOPED(longFlameHandle, false);
-    }
-    bool checkPtfxAsset2 = STREAMING::HAS_NAMED_PTFX_ASSET_LOADED("turbo_flame");
-        // Start the standard flame effect  
-        bool cycleFx = (rand() % 2 == 0);
-        if (cycleFx) {
-            GRAPHICS::USE_PARTICLE_FX_ASSET("weap_sm_bom");
-            GRAPHICS::START_PARTICLE_FX_NON_LOOPED_ON_ENTITY("muz_sm_bom_cannon", vehicle,
-                boneOffX, boneOffY, boneOffZ, boneRotX, boneRotY, (boneRotZ - 180.0f), (explSz - 0.95f), false, false, false);
-        }
-        else {
-            GRAPHICS::USE_PARTICLE_FX_ASSET("veh_sanctus");
-            GRAPHICS::START_PARTICLE_FX_NON_LOOPED_ON_ENTITY("veh_sanctus_backfire", vehicle,
-                boneOffX, boneOffY, boneOffZ, boneRotX, boneRotY, boneRotZ, (explSz - 0.05f), false, false, false);
-        }
-            // Randomly decide second flame and check for ptfx file
-            if (checkPtfxAsset2) {
-                // Start second flame on delay
-                if (rand() % 2 == 0) {
-                    WAIT(300);
-                    GRAPHICS::USE_PARTICLE_FX_ASSET("turbo_flame");
-                    GRAPHICS::START_PARTICLE_FX_NON_LOOPED_ON_ENTITY("backfire_blue", vehicle,
-                        boneOffX, boneOffY, boneOffZ, boneRotX, boneRotY, boneRotZ, explSz, false, false, false);
-                }
-            }
-            else {
-                // if turbo_flame.ypt not found play vanilla backfire (for compatibility)
-                GRAPHICS::USE_PARTICLE_FX_ASSET("core");
-                GRAPHICS::START_PARTICLE_FX_NON_LOOPED_ON_ENTITY("veh_backfire", vehicle,
-                    boneOffX, boneOffY, boneOffZ, boneRotX, boneRotY, boneRotZ, explSz, false, false, false);
-            }
-            if ((rand() % 3 == 0) && checkPtfxAsset2) {
+unsigned CTurboScript::firePtfx(Entity vehicle, size_t exhaust, float boneOffX, float boneOffY, float boneOffZ,
+    float boneRotX, float boneRotY, float boneRotZ, float explSz, bool layered, unsigned maxEffects) {
+    // All exhausts fire in the same tick, so only replace this exhaust's long flame.
+    if (exhaust >= mLongFlameHandles.size())
+        mLongFlameHandles.resize(exhaust + 1, -1);
+    if (mLongFlameHandles[exhaust] != -1) {
+        GRAPHICS::STOP_PARTICLE_FX_LOOPED(mLongFlameHandles[exhaust], false);
+        mLongFlameHandles[exhaust] = -1;
+    }
+    bool checkPtfxAsset2 = PtfxAssets::Loaded(PtfxAssets::EAsset::TurboFlame);
+    const Vector3 offset{ boneOffX, boneOffY, boneOffZ };
+    int gameTime = MISC::GET_GAME_TIMER();
+
+    // Start the standard flame effect
+    bool cycleFx = (rand() % 2 == 0);
+    if (cycleFx) {
+        GRAPHICS::USE_PARTICLE_FX_ASSET("weap_sm_bom");
+        GRAPHICS::START_PARTICLE_FX_NON_LOOPED_ON_ENTITY("muz_sm_bom_cannon", vehicle,
+            offset, { boneRotX, boneRotY, boneRotZ - 180.0f }, (explSz - 0.95f), false, false, false);
+    }
+    else {
+        GRAPHICS::USE_PARTICLE_FX_ASSET("veh_sanctus");
+        GRAPHICS::START_PARTICLE_FX_NON_LOOPED_ON_ENTITY("veh_sanctus_backfire", vehicle,
+            offset, { boneRotX, boneRotY, boneRotZ }, (explSz - 0.05f), false, false, false);
+    }
+    unsigned started = 1;
+
+    // Randomly decide second flame and check for ptfx file
+    if (checkPtfxAsset2) {
+        // Start second flame on delay. Far away, the base flame is enough.
+        if (layered && started < maxEffects && rand() % 2 == 0) {
+            ++started;
+            mEffects.After(gameTime, 300, [=]() {
+                if (!ENTITY::DOES_ENTITY_EXIST(vehicle))
+                    return;
                 GRAPHICS::USE_PARTICLE_FX_ASSET("turbo_flame");
-                longFlameHandle = GRAPHICS::START_PARTICLE_FX_LOOPED_ON_ENTITY("exp_sht_flame_nop", vehicle,
-                    boneOffX, boneOffY, boneOffZ, boneRotX, (boneRotY + 90.0f), (boneRotZ - 90.0f), (explSz - 0.85f), false, false, false);
-                // Check throttle and time to stop longFlame
-                int secToStop = MISC::GET_GAME_TIMER();
-                while (VExt::GetThrottleP(vehicle) < 0.1f && (MISC::GET_GAME_TIMER() - secToStop) < 1000) {
-                    WAIT(0);
-                }
-                GRAPHICS::STOP_PARTICLE_FX_LOOPED(longFlameHandle, false);
-                longFlameHandle = -1;
-            }
+                GRAPHICS::START_PARTICLE_FX_NON_LOOPED_ON_ENTITY("backfire_blue", vehicle,
+                    offset, { boneRotX, boneRotY, boneRotZ }, explSz, false, false, false);
+            });
+        }
+    }
+    else if (started < maxEffects) {
+        // if turbo_flame.ypt not found play vanilla backfire (for compatibility)
+        ++started;
+        GRAPHICS::USE_PARTICLE_FX_ASSET("core");
+        GRAPHICS::START_PARTICLE_FX_NON_LOOPED_ON_ENTITY("veh_backfire", vehicle,
+            offset, { boneRotX, boneRotY, boneRotZ }, explSz, false, false, false);
+    }
+    if (layered && started < maxEffects && (rand() % 3 == 0) && checkPtfxAsset2) {
+        ++started;
+        GRAPHICS::USE_PARTICLE_FX_ASSET("turbo_flame");
+        int handle = GRAPHICS::START_PARTICLE_FX_LOOPED_ON_ENTITY("exp_sht_flame_nop", vehicle,
+            offset, { boneRotX, boneRotY + 90.0f, boneRotZ - 90.0f }, (explSz - 0.85f), false, false, false);
+        mLongFlameHandles[exhaust] = handle;
+
+        // Stop longFlame on throttle, or after a second
+        mEffects.Until(gameTime, 1000,
+            [vehicle]() {
+                return !ENTITY::DOES_ENTITY_EXIST(vehicle) || VExt::GetThrottleP(vehicle) >= 0.1f;
+            },
+            [this, exhaust, handle]() {
+                // A newer flame on this exhaust already stopped this one.
+                if (mLongFlameHandles[exhaust] != handle)
+                    return;
+                GRAPHICS::STOP_PARTICLE_FX_LOOPED(handle, false);
+                mLongFlameHandles[exhaust] = -1;
+            });
+    }
+    return started;
 }
 
 void CTurboScript::runPtfx(Vehicle vehicle, bool loud) {
-    int numPtfxPlayed = 0;
+    PROFILE_ZONE(Ptfx);
+    float explSz;
+    if (loud) {
+        explSz = 1.25f;
+    }
+    else {
+        explSz = map(mSnapshot.RPM,
+            mActiveConfig->Turbo.RPMSpoolStart, mActiveConfig->Turbo.RPMSpoolEnd,
+            0.75f, 1.25f);
+        explSz = std::clamp(explSz, 0.75f, 1.25f);
+    }
+
+    Vector3 camPos = CAM::GET_FINAL_RENDERED_CAM_COORD();
+    float distance = Distance(camPos, ENTITY::GET_ENTITY_COORDS(vehicle, true));
+
+    auto lod = mParticleBudget.GetLod(distance);
+    if (lod == CParticleBudget::ELod::Culled)
+        return;
+
+    bool layered = lod == CParticleBudget::ELod::Full;
+    float priority = CParticleBudget::Priority(distance, ENTITY::IS_ENTITY_ON_SCREEN(vehicle), !mIsNPC);
+
+    const auto& exhausts = getExhaustTransforms(vehicle);
+    size_t exhaustCount = layered ? exhausts.size() : std::min<size_t>(exhausts.size(), 1);
 
-    for (uint32_t exhaustBoneId = 56/*exhaust*/; exhaustBoneId <= 87/*exhaust_32*/; exhaustBoneId++) {
-        const auto& exhaustBoneName = mExhaustBones[exhaustBoneId - 56];
+    for (size_t i = 0; i < exhaustCount; ++i) {
+        // Fired later this tick, if it fits in the budget.
+        mParticleBudget.Request(priority, [this, vehicle, i, exhaust = exhausts[i], explSz, layered](unsigned maxEffects) {
+            // Separated ptfx call for modularity on fx and timing
+            return firePtfx(vehicle, i, exhaust.Offset.x, exhaust.Offset.y, exhaust.Offset.z,
+                exhaust.Rotation.x, exhaust.Rotation.y, exhaust.Rotation.z, explSz, layered, maxEffects);
+        });
+    }
+}
+
+const std::vector<SExhaustTransform>& CTurboScript::getExhaustTransforms(Vehicle vehicle) {
+    Hash model = ENTITY::GET_ENTITY_MODEL(vehicle);
+    int exhaustMod = VEHICLE::GET_VEHICLE_MOD(vehicle, eVehicleMod::VehicleModExhaust);
+
+    if (const auto* exhausts = exhaustCache.Find(model, exhaustMod))
+        return *exhausts;
+
+    std::vector<SExhaustTransform> exhausts = findExhaustTransforms(vehicle);
+    LOG_DEBUG("[Ptfx] Cached %llu exhaust(s) for model 0x%08X, exhaust mod %d",
+        static_cast<unsigned long long>(exhausts.size()), model, exhaustMod);
+    return exhaustCache.Store(model, exhaustMod, std::move(exhausts));
+}
+
+const std::vector<int>& CTurboScript::getExhaustBoneIndices(Vehicle vehicle) {
+    Hash model = ENTITY::GET_ENTITY_MODEL(vehicle);
+    auto it = exhaustBoneIndexCache.find(model);
+    if (it != exhaustBoneIndexCache.end())
+        return it->second;
+
+    std::vector<int> boneIndices;
+    for (const char* bone : exhaustBones) {
+        int boneIdx = ENTITY::GET_ENTITY_BONE_INDEX_BY_NAME(vehicle, bone);
+        if (boneIdx != -1)
+            boneIndices.push_back(boneIdx);
+    }
+    return exhaustBoneIndexCache.emplace(model, std::move(boneIndices)).first->second;
+}
+
+std::vector<SExhaustTransform> CTurboScript::findExhaustTransforms(Vehicle vehicle) {
+    std::vector<SExhaustTransform> exhausts;
+
+    for (uint32_t exhaustBoneId = 56/*exhaust*/; CVehicle_GetExhaust && exhaustBoneId <= 87/*exhaust_32*/; exhaustBoneId++) {
         XMMATRIX transform;
         uint32_t id;
         CVehicle_GetExhaust(VExt::GetAddress(vehicle), exhaustBoneId, transform, id);
@@ -315,7 +458,7 @@ void CTurboScript::runPtfx(Vehicle vehicle, bool loud) {
         }
         else {
             uint32_t boneIndex = id;
-            if (VEHICLE::GET_VEHICLE_MOD(mVehicle, eVehicleMod::VehicleModExhaust) != -1)
+            if (VEHICLE::GET_VEHICLE_MOD(vehicle, eVehicleMod::VehicleModExhaust) != -1)
                 continue;
         }
 
@@ -343,12 +486,10 @@ void CTurboScript::runPtfx(Vehicle vehicle, bool loud) {
         float upPosX = upPos.f[0], upPosY = upPos.f[1], upPosZ = upPos.f[2];
         float rightPosX = rightPos.f[0], rightPosY = rightPos.f[1], rightPosZ = rightPos.f[2];
 
-        Vector3 boneOff = ENTITY::GET_OFFSET_FROM_ENTITY_GIVEN_WORLD_COORDS(vehicle, posX, posY, posZ );
-        Vector3 boneFwdOff = ENTITY::GET_OFFSET_FROM_ENTITY_GIVEN_WORLD_COORDS(vehicle, forwardPosX, forwardPosY, forwardPosZ );
-        Vector3 boneUpOff = ENTITY::GET_OFFSET_FROM_ENTITY_GIVEN_WORLD_COORDS(vehicle, upPosX, upPosY, upPosZ );
-        Vector3 boneRightOff = ENTITY::GET_OFFSET_FROM_ENTITY_GIVEN_WORLD_COORDS(vehicle, rightPosX, rightPosY, rightPosZ );
-
-        float boneOffX = boneOff.x, boneOffY = boneOff.y, boneOffZ = boneOff.z;
+        Vector3 boneOff = ENTITY::GET_OFFSET_FROM_ENTITY_GIVEN_WORLD_COORDS(vehicle, { posX, posY, posZ });
+        Vector3 boneFwdOff = ENTITY::GET_OFFSET_FROM_ENTITY_GIVEN_WORLD_COORDS(vehicle, { forwardPosX, forwardPosY, forwardPosZ });
+        Vector3 boneUpOff = ENTITY::GET_OFFSET_FROM_ENTITY_GIVEN_WORLD_COORDS(vehicle, { upPosX, upPosY, upPosZ });
+        Vector3 boneRightOff = ENTITY::GET_OFFSET_FROM_ENTITY_GIVEN_WORLD_COORDS(vehicle, { rightPosX, rightPosY, rightPosZ });
 
         Vector3 relFwd = Normalize(boneFwdOff - boneOff);
         Vector3 relUp = Normalize(boneUpOff - boneOff);
@@ -356,31 +497,13 @@ void CTurboScript::runPtfx(Vehicle vehicle, bool loud) {
         Vector3 boneRot =  RotationFromVectors(relFwd, relUp);
         float boneRotX = rad2deg(boneRot.x), boneRotY = rad2deg(boneRot.y), boneRotZ = rad2deg(boneRot.z);
 
-        float explSz;
-        if (loud) {
-            explSz = 1.25f;
-        }
-        else {
-            explSz = map(VExt::GetCurrentRPM(mVehicle),
-                mActiveConfig->Turbo.RPMSpoolStart, mActiveConfig->Turbo.RPMSpoolEnd,
-                0.75f, 1.25f);
-            explSz = std::clamp(explSz, 0.75f, 1.25f);
-        }
-
-        // Separated ptfx call for modularity on fx and timing
-        firePtfx(vehicle, boneOffX, boneOffY, boneOffZ, boneRotX, boneRotY, boneRotZ, explSz);
-        
-        numPtfxPlayed++;
+        exhausts.push_back({ boneOff, { boneRotX, boneRotY, boneRotZ } });
     }
 
-    // Fallback: None has been played, so play on whatever exhausts it had originally.
+    // Fallback: None found, so play on whatever exhausts it had originally.
     // Could happen with exhaust bones on modded exhausts using the same as the original.
-    if (numPtfxPlayed == 0) {
-        for (const auto& bone : mExhaustBones) {
-            int boneIdx = ENTITY::GET_ENTITY_BONE_INDEX_BY_NAME(vehicle, bone.c_str());
-            if (boneIdx == -1)
-                continue;
-
+    if (exhausts.empty()) {
+        for (int boneIdx : getExhaustBoneIndices(vehicle)) {
             Vector3 bonePos = ENTITY::GET_WORLD_POSITION_OF_ENTITY_BONE(vehicle, boneIdx);
 
             float bonePosX = bonePos.x;
@@ -388,96 +511,87 @@ void CTurboScript::runPtfx(Vehicle vehicle, bool loud) {
             float bonePosZ = bonePos.z;
 
             Vector3 boneRot = ENTITY::GET_ENTITY_BONE_OBJECT_ROTATION(vehicle, boneIdx);
-            Vector3 boneOff = ENTITY::GET_OFFSET_FROM_ENTITY_GIVEN_WORLD_COORDS(vehicle, bonePosX, bonePosY, bonePosZ);
-
-            float boneOffX = boneOff.x;
-            float boneOffY = boneOff.y;
-            float boneOffZ = boneOff.z;
-
-            float boneRotX = boneRot.x;
-            float boneRotY = boneRot.y;
-            float boneRotZ = boneRot.z;
+            Vector3 boneOff = ENTITY::GET_OFFSET_FROM_ENTITY_GIVEN_WORLD_COORDS(vehicle, { bonePosX, bonePosY, bonePosZ });
 
-            float explSz;
-            if (loud) {
-                explSz = 1.25f;
-            }
-            else {
-                explSz = map(VExt::GetCurrentRPM(mVehicle),
-                    mActiveConfig->Turbo.RPMSpoolStart, mActiveConfig->Turbo.RPMSpoolEnd,
-                    0.75f, 1.25f);
-                explSz = std::clamp(explSz, 0.75f, 1.25f);
-            }
-
-            firePtfx(vehicle, boneOffX, boneOffY, boneOffZ, boneRotX, boneRotY, boneRotZ, explSz);
+            exhausts.push_back({ boneOff, boneRot });
         }
     }
+
+    return exhausts;
 }
 
 void CTurboScript::runSfx(Vehicle vehicle, bool loud) {
-    Vector3 camPos = CAM::GET_FINAL_RENDERED_CAM_COORD();
-    Vector3 camRot = CAM::GET_FINAL_RENDERED_CAM_ROT(0);
-    Vector3 camDir = RotationToDirection(camRot);
-
-    // UI::DrawSphere(camPos + camDir * 0.25f, 0.0625f, 255, 0, 0, 255);
-    mSoundEngine->setSoundVolume(mActiveConfig->AntiLag.Volume);
-    mSoundEngine->setListenerPosition(
-        irrklang::vec3df(camPos.x, camPos.y, camPos.z),
-        irrklang::vec3df(camDir.x, camDir.y, camDir.z),
-        irrklang::vec3df(0, 0, 0),
-        irrklang::vec3df(0, 0, -1)
-    );
-
-    for (const auto& bone : mExhaustBones) {
-        int boneIdx = ENTITY::GET_ENTITY_BONE_INDEX_BY_NAME(vehicle, bone.c_str());
-        if (boneIdx == -1)
-            continue;
+    PROFILE_ZONE(Sfx);
+    const int soundSetIndex = mActiveConfig->AntiLag.SoundSetIndex;
+    if (soundSetIndex < 0 || soundSetIndex >= static_cast<int>(mSoundSets.size()))
+        return;
 
-        Vector3 bonePos = ENTITY::GET_WORLD_POSITION_OF_ENTITY_BONE(vehicle, boneIdx);
-        std::string soundName;
-        const std::string soundNameBass = "EX_POP_SUB.wav";
-        // UI::DrawSphere(bonePos, 0.125f, 0, 255, 0, 255);
+    // NoSound has no samples.
+    const SSoundSet& soundSet = mSoundSets[soundSetIndex];
+    if (soundSet.Sub < 0)
+        return;
 
-        if (mActiveConfig->AntiLag.SoundSet != "NoSound") {
-            if (loud) {
-                auto randIndex = rand() % mSoundSets[mSoundSetIndex].EffectCount;
-                soundName = fmt::format("EX_POP_{}.wav", randIndex);
-            }
-            else {
-                soundName = soundNameBass;
-            }
+    // Synthesized pops are pitched up with revs and boost, and a bit of randomness on top.
+    float speed = 1.0f;
+    if (soundSet.Synth) {
+        float rpmSpeed = map(mSnapshot.RPM, 0.2f, 1.0f, 0.85f, 1.15f);
+        float boostSpeed = map(std::max(mSnapshot.Turbo, 0.0f),
+            0.0f, std::max(mActiveConfig->Turbo.MaxBoost, 0.01f), 0.0f, 0.08f);
+        float randSpeed = map(static_cast<float>(rand() % 101),
+            0.0f, 100.0f, 0.95f, 1.05f);
+        speed = std::clamp(rpmSpeed + boostSpeed, 0.75f, 1.3f) * randSpeed;
+    }
 
-            std::string soundFinalName =
-                fmt::format(R"({}\Sounds\{}\{})", Paths::GetModuleFolder(Paths::GetOurModuleHandle()) +
-                    Constants::ModDir, mActiveConfig->AntiLag.SoundSet, soundName);
-            std::string soundBassFinalName =
-                fmt::format(R"({}\Sounds\{}\{})", Paths::GetModuleFolder(Paths::GetOurModuleHandle()) +
-                    Constants::ModDir, mActiveConfig->AntiLag.SoundSet, soundNameBass);
+    // Just play on one exhaust.
+    const auto& boneIndices = getExhaustBoneIndices(vehicle);
+    if (boneIndices.empty())
+        return;
 
-            if (!soundName.empty())
-                mSoundEngine->play3D(soundFinalName.c_str(), { bonePos.x, bonePos.y, bonePos.z });
+    Vector3 bonePos = ENTITY::GET_WORLD_POSITION_OF_ENTITY_BONE(vehicle, boneIndices[0]);
+    // UI::DrawSphere(bonePos, 0.125f, 0, 255, 0, 255);
 
-            mSoundEngine->play3D(soundBassFinalName.c_str(), { bonePos.x, bonePos.y, bonePos.z });
+    auto tStart = std::chrono::steady_clock::now();
+    if (loud) {
+        auto randIndex = rand() % soundSet.EffectCount;
+        mAudio.Play(soundSet.Pops[randIndex], bonePos, mActiveConfig->AntiLag.Volume, speed);
+    }
+    if (!loud || !soundSet.Premixed)
+        mAudio.Play(soundSet.Sub, bonePos, mActiveConfig->AntiLag.Volume, speed);
+    double playTimeMs = elapsedMs(tStart);
+
+    // The turbo whistles on the way down, higher and louder the more boost there was.
+    if (loud && !soundSet.Whistles.empty() && mSnapshot.Turbo > 0.0f) {
+        float boost = std::clamp(mSnapshot.Turbo / std::max(mActiveConfig->Turbo.MaxBoost, 0.01f), 0.0f, 1.0f);
+        auto whistleIndex = rand() % soundSet.Whistles.size();
+        mAudio.Play(soundSet.Whistles[whistleIndex], bonePos, mActiveConfig->AntiLag.Volume * boost,
+            map(boost, 0.0f, 1.0f, 0.8f, 1.2f));
+    }
 
-            // Just play on one exhaust.
-            break;
-        }
+    static bool firstPop = true;
+    if (firstPop) {
+        firstPop = false;
+        LOG_DEBUG("[Sfx] First pop queued in %.3f ms", playTimeMs);
     }
 }
 
 void CTurboScript::updateTurbo() {
+    PROFILE_ZONE(Turbo);
+    const SVehicleSnapshot original = VExt::GetSnapshot(mVehicle);
+    mSnapshot = original;
+
     if (!VEHICLE::IS_TOGGLE_MOD_ON(mVehicle, VehicleToggleModTurbo) ||
         !VEHICLE::GET_IS_VEHICLE_ENGINE_RUNNING(mVehicle)) {
-        float currentBoost = VExt::GetTurbo(mVehicle);
+        float currentBoost = mSnapshot.Turbo;
         float newBoost = lerp(
             currentBoost, 0.0f, 1.0f - pow(1.0f - mActiveConfig->Turbo.UnspoolRate, MISC::GET_FRAME_TIME()));
         if (!mIsNPC)
             updateDial(newBoost);
-        VExt::SetTurbo(mVehicle, newBoost);
+        mSnapshot.Turbo = newBoost;
+        VExt::ApplySnapshot(original, mSnapshot);
         return;
     }
 
-    float currentBoost = VExt::GetTurbo(mVehicle);
+    float currentBoost = mSnapshot.Turbo;
     currentBoost = std::clamp(currentBoost,
         mActiveConfig->Turbo.MinBoost,
         mActiveConfig->Turbo.MaxBoost);
@@ -490,7 +604,7 @@ void CTurboScript::updateTurbo() {
     //   0.2 RPM to RPMSpoolStart -> NA
     //   RPMSpoolEnd to 1.0 RPM -> MaxBoost
 
-    float rpm = VExt::GetCurrentRPM(mVehicle);
+    float rpm = mSnapshot.RPM;
 
     float boostClosed = map(rpm,
         0.2f, 1.0f, 
@@ -502,7 +616,7 @@ void CTurboScript::updateTurbo() {
         0.0f, mActiveConfig->Turbo.MaxBoost);
     boostWOT = std::clamp(boostWOT, 0.0f, mActiveConfig->Turbo.MaxBoost);
 
-    float now = map(abs(VExt::GetThrottle(mVehicle)), 
+    float now = map(abs(mSnapshot.Throttle), 
         0.0f, 1.0f, 
         boostClosed, boostWOT);
 
@@ -521,7 +635,7 @@ void CTurboScript::updateTurbo() {
             mActiveConfig->Turbo.MaxBoost);
     }
     else {
-        auto currentGear = VExt::GetGearCurr(mVehicle);
+        auto currentGear = mSnapshot.GearCurr;
         auto topBoostKvp = mActiveConfig->BoostByGear.Gear.rbegin();
 
         // Use 1st gear boost limit for reverse.
@@ -568,17 +682,6 @@ void CTurboScript::updateTurbo() {
         });
     }
 
-    VExt::SetTurbo(mVehicle, newBoost);
-}
-
-void CTurboScript::updateSoundSetIndex(const std::string& soundSet) {
-    auto soundSetIt = std::find_if(mSoundSets.begin(), mSoundSets.end(), [soundSet](const auto& other) {
-        return other.Name == soundSet;
-    });
-    if (soundSetIt != mSoundSets.end()) {
-        mSoundSetIndex = static_cast<int>(soundSetIt - mSoundSets.begin());
-    }
-    else {
-        mSoundSetIndex = 0;
-    }
+    mSnapshot.Turbo = newBoost;
+    VExt::ApplySnapshot(original, mSnapshot);
 }
@@ -2,10 +2,13 @@
 #include "ScriptSettings.hpp"
 #include "Config.hpp"
 #include "SoundSet.hpp"
+#include "Audio/AudioThread.hpp"
+#include "Ptfx/EffectScheduler.hpp"
+#include "Ptfx/ExhaustCache.hpp"
+#include "Ptfx/ParticleBudget.hpp"
 
 #include "Memory/VehicleExtensions.hpp"
 
-#include <irrKlang.h>
 #include <vector>
 #include <string>
 
@@ -14,14 +17,25 @@ public:
     CTurboScript(
         CScriptSettings& settings,
         std::vector<CConfig>& configs,
-        std::vector<SSoundSet>& soundSets);
+        std::vector<SSoundSet>& soundSets,
+        CAudioThread& audio,
+        CParticleBudget& particleBudget);
     virtual ~CTurboScript();
     virtual void Tick();
 
+    // Resolves the game functions used by all instances.
+    static void InitPatterns();
+
     CConfig* ActiveConfig() {
         return mActiveConfig;
     }
 
+    // This instance's copy of the default config, active when no other config
+    // matches. Menu edits to it don't affect other vehicles on the default config.
+    CConfig& DefaultConfig() {
+        return mDefaultConfig;
+    }
+
     bool GetHasTurbo();
     float GetCurrentBoost();
 
@@ -30,21 +44,26 @@ public:
     // Applies the passed config onto the current active config.
     void ApplyConfig(const CConfig& config);
 
-    int& SoundSetIndex() {
-        return mSoundSetIndex;
-    }
-
     Vehicle GetVehicle() {
         return mVehicle;
     }
 
 protected:
     void runPtfx(Vehicle vehicle, bool loud);
+    // Cached per model and exhaust mod.
+    const std::vector<SExhaustTransform>& getExhaustTransforms(Vehicle vehicle);
+    std::vector<SExhaustTransform> findExhaustTransforms(Vehicle vehicle);
+    // Indices of the exhaust bones the model has, cached per model.
+    static const std::vector<int>& getExhaustBoneIndices(Vehicle vehicle);
+    // layered: also the delayed second flame and the long flame, as far as
+    // maxEffects allows. Returns the number of effects started.
+    unsigned firePtfx(Entity vehicle, size_t exhaust, float boneOffX, float boneOffY, float boneOffZ,
+        float boneRotX, float boneRotY, float boneRotZ, float explSz, bool layered, unsigned maxEffects);
     void runSfx(Vehicle vehicle, bool loud);
+    void updatePtfxAssets();
     float updateAntiLag(float currentBoost, float newBoost, float limBoost);
     void updateDial(float newBoost);
     void updateTurbo();
-    void updateSoundSetIndex(const std::string& soundSet);
 
     const CScriptSettings& mSettings;
     std::vector<CConfig>& mConfigs;
@@ -58,20 +77,20 @@ protected:
 
     float mLastThrottle;
 
+    // Vehicle state read at the start of updateTurbo.
+    SVehicleSnapshot mSnapshot;
+
+    // Delayed flames and long flame stop checks, updated at the start of Tick.
+    CEffectScheduler mEffects;
+    // Burning long flame per exhaust index, -1 when there's none.
+    std::vector<int> mLongFlameHandles;
+    // Holds a reference on the shared ptfx assets.
+    bool mPtfxAssetsAcquired;
+
     const std::vector<SSoundSet>& mSoundSets;
-    int mSoundSetIndex;
-
-    irrklang::ISoundEngine* mSoundEngine;
-    const std::vector<std::string> mExhaustBones{
-        "exhaust",    "exhaust_2",  "exhaust_3",  "exhaust_4",
-        "exhaust_5",  "exhaust_6",  "exhaust_7",  "exhaust_8",
-        "exhaust_9",  "exhaust_10", "exhaust_11", "exhaust_12",
-        "exhaust_13", "exhaust_14", "exhaust_15", "exhaust_16",
-        "exhaust_17", "exhaust_18", "exhaust_19", "exhaust_20",
-        "exhaust_21", "exhaust_22", "exhaust_23", "exhaust_24",
-        "exhaust_25", "exhaust_26", "exhaust_27", "exhaust_28",
-        "exhaust_29", "exhaust_30", "exhaust_31", "exhaust_32",
-    };
+
+    CAudioThread& mAudio;
+    CParticleBudget& mParticleBudget;
 
     bool mIsNPC;
 };
@@ -1,15 +1,25 @@
 #include "TurboScriptNPC.hpp"
 
+#include "Util/Profiler.hpp"
+
+#include <inc/natives.h>
+
 CTurboScriptNPC::CTurboScriptNPC(
     Vehicle vehicle,
     CScriptSettings& settings,
     std::vector<CConfig>& configs,
-    std::vector<SSoundSet>& soundSets)
-    : CTurboScript(settings, configs, soundSets) {
+    std::vector<SSoundSet>& soundSets,
+    CAudioThread& audio,
+    CParticleBudget& particleBudget)
+    : CTurboScript(settings, configs, soundSets, audio, particleBudget) {
     mIsNPC = true;
     mVehicle = vehicle;
 }
 
 void CTurboScriptNPC::Tick() {
-    updateTurbo();
+    PROFILE_ZONE_ARG(NPCTick, mVehicle);
+    mEffects.Update(MISC::GET_GAME_TIMER());
+    updatePtfxAssets();
+    if (mActiveConfig)
+        updateTurbo();
 }
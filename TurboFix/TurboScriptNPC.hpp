@@ -7,7 +7,9 @@ public:
         Vehicle vehicle,
         CScriptSettings& settings,
         std::vector<CConfig>& configs,
-        std::vector<SSoundSet>& soundSets
+        std::vector<SSoundSet>& soundSets,
+        CAudioThread& audio,
+        CParticleBudget& particleBudget
     );
 
     void Tick() override;
@@ -0,0 +1,230 @@
+#include "AllocTracker.hpp"
+
+#include "Logger.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+namespace {
+    // Index 0 is Untagged, then one per zone.
+    constexpr size_t Tags = static_cast<size_t>(Profiler::EZone::Count) + 1;
+
+    // Lock-free, since any thread can allocate.
+    std::array<std::atomic<uint64_t>, Tags> allocCount{};
+    std::array<std::atomic<uint64_t>, Tags> allocBytes{};
+
+    // Only touched from the script thread, in EndFrame.
+    struct SFrameStats {
+        uint64_t SeenAllocs = 0;
+        uint64_t SeenBytes = 0;
+        uint64_t LastAllocs = 0;
+        uint64_t LastBytes = 0;
+        uint64_t SumAllocs = 0;
+        uint64_t SumBytes = 0;
+        uint64_t MaxAllocs = 0;
+        uint64_t MaxBytes = 0;
+    };
+
+    std::array<SFrameStats, Tags> frameStats;
+    uint64_t frames = 0;
+    uint64_t overBudgetFrames = 0;
+
+    size_t slot(int tag) {
+        return static_cast<size_t>(tag + 1);
+    }
+
+    // Stats index: zones first, Untagged last.
+    size_t statsSlot(size_t index) {
+        return index + 1 == Tags ? 0 : index + 1;
+    }
+}
+
+thread_local int AllocTracker::detail::currentTag = AllocTracker::Untagged;
+
+void AllocTracker::EndFrame(int budget) {
+    ++frames;
+
+    uint64_t frameAllocs = 0;
+    uint64_t frameBytes = 0;
+    size_t worst = 0;
+    for (size_t i = 0; i < Tags; ++i) {
+        SFrameStats& stats = frameStats[i];
+        uint64_t allocs = allocCount[i].load(std::memory_order_relaxed);
+        uint64_t bytes = allocBytes[i].load(std::memory_order_relaxed);
+
+        stats.LastAllocs = allocs - stats.SeenAllocs;
+        stats.LastBytes = bytes - stats.SeenBytes;
+        stats.SeenAllocs = allocs;
+        stats.SeenBytes = bytes;
+        stats.SumAllocs += stats.LastAllocs;
+        stats.SumBytes += stats.LastBytes;
+        stats.MaxAllocs = std::max(stats.MaxAllocs, stats.LastAllocs);
+        stats.MaxBytes = std::max(stats.MaxBytes, stats.LastBytes);
+
+        if (i == slot(Untagged))
+            continue;
+        frameAllocs += stats.LastAllocs;
+        frameBytes += stats.LastBytes;
+        if (stats.LastAllocs > frameStats[worst].LastAllocs || worst == slot(Untagged))
+            worst = i;
+    }
+
+    bool reloaded = frameStats[slot(static_cast<int>(Profiler::EZone::LoadConfigs))].LastAllocs > 0;
+    if (budget <= 0 || frames <= WarmupFrames || reloaded || frameAllocs <= static_cast<uint64_t>(budget))
+        return;
+
+    ++overBudgetFrames;
+    LOG_WARN("[Alloc] Frame %llu: %llu allocations (%llu bytes), budget is %d. Most in [%s]: %llu",
+        static_cast<unsigned long long>(frames), static_cast<unsigned long long>(frameAllocs),
+        static_cast<unsigned long long>(frameBytes), budget,
+        Stats(worst - 1).Name, static_cast<unsigned long long>(frameStats[worst].LastAllocs));
+}
+
+uint64_t AllocTracker::Frames() {
+    return frames;
+}
+
+uint64_t AllocTracker::OverBudgetFrames() {
+    return overBudgetFrames;
+}
+
+size_t AllocTracker::TagCount() {
+    return Tags;
+}
+
+AllocTracker::SStats AllocTracker::Stats(size_t index) {
+    size_t i = statsSlot(index);
+    const SFrameStats& stats = frameStats[i];
+    double n = static_cast<double>(std::max<uint64_t>(frames, 1));
+    return {
+        i == 0 ? "Untagged" : Profiler::Stats(static_cast<Profiler::EZone>(i - 1)).Name,
+        stats.LastAllocs,
+        stats.LastBytes,
+        static_cast<double>(stats.SumAllocs) / n,
+        static_cast<double>(stats.SumBytes) / n,
+        stats.MaxAllocs,
+        stats.MaxBytes,
+    };
+}
+
+void AllocTracker::Reset() {
+    for (size_t i = 0; i < Tags; ++i) {
+        SFrameStats& stats = frameStats[i];
+        stats = SFrameStats{};
+        stats.SeenAllocs = allocCount[i].load(std::memory_order_relaxed);
+        stats.SeenBytes = allocBytes[i].load(std::memory_order_relaxed);
+    }
+    frames = 0;
+    overBudgetFrames = 0;
+}
+
+bool AllocTracker::Dump(const std::string& file) {
+    std::ofstream out(file, std::ofstream::out | std::ofstream::trunc);
+    if (!out.is_open())
+        return false;
+
+    char line[160];
+    snprintf(line, sizeof(line), "%llu frames\n", static_cast<unsigned long long>(frames));
+    out << line;
+    snprintf(line, sizeof(line), "%-12s %12s %12s %12s %12s %12s %12s\n",
+        "Tag", "Allocs/frame", "Bytes/frame", "Max allocs", "Max bytes", "Last allocs", "Last bytes");
+    out << line;
+
+    for (size_t i = 0; i < Tags; ++i) {
+        auto stats = Stats(i);
+        snprintf(line, sizeof(line), "%-12s %12.2f %12.1f %12llu %12llu %12llu %12llu\n",
+            stats.Name, stats.AvgAllocs, stats.AvgBytes,
+            static_cast<unsigned long long>(stats.MaxAllocs), static_cast<unsigned long long>(stats.MaxBytes),
+            static_cast<unsigned long long>(stats.LastAllocs), static_cast<unsigned long long>(stats.LastBytes));
+        out << line;
+    }
+    return true;
+}
+
+#if TF_ALLOC_TRACKING
+// Replaces the allocation functions for this DLL only, the game and other
+// scripts use their own.
+namespace {
+    void count(size_t size) {
+        size_t index = slot(AllocTracker::detail::currentTag);
+        allocCount[index].fetch_add(1, std::memory_order_relaxed);
+        allocBytes[index].fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void* alignedAlloc(size_t size, std::align_val_t align) {
+#ifdef _MSC_VER
+        return _aligned_malloc(size ? size : 1, static_cast<size_t>(align));
+#else
+        size_t alignment = static_cast<size_t>(align);
+        return std::aligned_alloc(alignment, (std::max<size_t>(size, 1) + alignment - 1) / alignment * alignment);
+#endif
+    }
+
+    void alignedFree(void* ptr) {
+#ifdef _MSC_VER
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+}
+
+void* operator new(size_t size) {
+    count(size);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    count(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void* operator new(size_t size, std::align_val_t align) {
+    count(size);
+    if (void* ptr = alignedAlloc(size, align))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t align) {
+    return operator new(size, align);
+}
+
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    count(size);
+    return alignedAlloc(size, align);
+}
+
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t& tag) noexcept {
+    return operator new(size, align, tag);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(ptr); }
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Counts heap allocations made by TurboFix, tagged with the innermost profiler
+// zone on the allocating thread. Build with TF_ALLOC_TRACKING=1 to replace the
+// DLL's operator new. Off by default, since it adds a few atomics per allocation.
+#ifndef TF_ALLOC_TRACKING
+#define TF_ALLOC_TRACKING 0
+#endif
+
+namespace AllocTracker {
+    constexpr bool Enabled = TF_ALLOC_TRACKING != 0;
+
+    // Tags are Profiler::EZone values. This one is for allocations outside any
+    // zone, which includes the worker threads.
+    constexpr int Untagged = -1;
+
+    struct SStats {
+        const char* Name;
+        uint64_t LastAllocs;
+        uint64_t LastBytes;
+        double AvgAllocs;
+        double AvgBytes;
+        uint64_t MaxAllocs;
+        uint64_t MaxBytes;
+    };
+
+    // Config loads and first ticks allocate a lot, EndFrame doesn't check these.
+    constexpr uint64_t WarmupFrames = 120;
+
+    // Call once per tick, from the script thread. Warns when the frame's tagged
+    // allocations go over budget (0 disables the check), skipping warm-up frames
+    // and frames that reloaded configs.
+    void EndFrame(int budget);
+
+    uint64_t Frames();
+    // Frames EndFrame found over budget, since the last Reset.
+    uint64_t OverBudgetFrames();
+
+    // Includes Untagged, as the last entry.
+    size_t TagCount();
+    SStats Stats(size_t index);
+
+    void Reset();
+
+    // Writes all tags as a table. Returns false if the file couldn't be opened.
+    bool Dump(const std::string& file);
+
+    namespace detail {
+        extern thread_local int currentTag;
+    }
+
+    // Sets the tag for the rest of the scope. Profiler zones do this already.
+    class CTagScope {
+    public:
+        explicit CTagScope(int tag)
+            : mPrevious(detail::currentTag) {
+            detail::currentTag = tag;
+        }
+
+        ~CTagScope() {
+            detail::currentTag = mPrevious;
+        }
+
+        CTagScope(const CTagScope&) = delete;
+        CTagScope& operator=(const CTagScope&) = delete;
+
+    private:
+        int mPrevious;
+    };
+}
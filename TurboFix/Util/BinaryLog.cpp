@@ -0,0 +1,169 @@
+#include "BinaryLog.hpp"
+
+#include "CommandQueue.hpp"
+#include "Threads.hpp"
+
+#include <Windows.h>
+
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace {
+    struct SState {
+        CCommandQueue<BinaryLog::detail::SRecord, 4096> Queue;
+        std::atomic<uint64_t> Dropped = 0;
+
+        // Guards the file, the format IDs and popping from the queue.
+        std::mutex FileMutex;
+        std::ofstream File;
+        uint16_t NextFormatId = 0;
+
+        std::atomic<uint32_t> Pushed = 0;
+        std::atomic<bool> Stop = false;
+        std::thread Thread;
+    };
+
+    // Never freed: the writer thread may still be around when the DLL unloads,
+    // see Threads::Detach.
+    SState* state = nullptr;
+
+    template <typename T>
+    void writeRaw(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // Gives up when the mutex is taken and wait is false.
+    void drain(bool wait = true) {
+        std::unique_lock lock(state->FileMutex, std::defer_lock);
+        if (wait)
+            lock.lock();
+        else if (!lock.try_lock())
+            return;
+
+        bool wrote = false;
+        BinaryLog::detail::SRecord record;
+        while (state->Queue.TryPop(record)) {
+            writeRaw(state->File, BinaryLog::EEntry::Record);
+            writeRaw(state->File, record.Header);
+            state->File.write(reinterpret_cast<const char*>(record.Args), record.Header.ArgsSize);
+            wrote = true;
+        }
+
+        if (wrote)
+            state->File.flush();
+    }
+
+    void run() {
+        uint32_t seen = 0;
+        while (!state->Stop.load()) {
+            state->Pushed.wait(seen, std::memory_order_acquire);
+            seen = state->Pushed.load(std::memory_order_acquire);
+            drain();
+        }
+    }
+}
+
+std::atomic<bool> BinaryLog::detail::enabled = false;
+
+void BinaryLog::Start(const std::string& file) {
+    if (state)
+        return;
+
+    state = new SState();
+    state->File.open(file, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!state->File.is_open()) {
+        logger.Write(ERROR, "[BinaryLog] Couldn't open [%s]", file.c_str());
+        return;
+    }
+
+    LARGE_INTEGER frequency, ticks;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&ticks);
+    SYSTEMTIME time;
+    GetLocalTime(&time);
+
+    SFileHeader header{};
+    memcpy(header.Magic, Magic, sizeof(Magic));
+    header.TickFrequency = static_cast<uint64_t>(frequency.QuadPart);
+    header.StartTicks = static_cast<uint64_t>(ticks.QuadPart);
+    header.Year = time.wYear;
+    header.Month = time.wMonth;
+    header.Day = time.wDay;
+    header.Hour = time.wHour;
+    header.Minute = time.wMinute;
+    header.Second = time.wSecond;
+    header.Milliseconds = time.wMilliseconds;
+    writeRaw(state->File, header);
+    state->File.flush();
+
+    state->Thread = std::thread(run);
+
+    detail::enabled.store(true);
+    logger.Write(INFO, "[BinaryLog] Recording to [%s]", file.c_str());
+}
+
+void BinaryLog::Stop() {
+    if (!state || !state->Thread.joinable())
+        return;
+
+    detail::enabled.store(false);
+    state->Stop.store(true);
+    state->Pushed.fetch_add(1);
+    state->Pushed.notify_one();
+
+    // Called from DllMain, so the thread is let go instead of joined. When it
+    // ended with the process, it may have been in drain: don't wait for the mutex.
+    bool exited = Threads::Detach(state->Thread);
+    drain(!exited);
+}
+
+void BinaryLog::Flush() {
+    if (state)
+        drain();
+}
+
+uint64_t BinaryLog::Dropped() {
+    return state ? state->Dropped.load(std::memory_order_relaxed) : 0;
+}
+
+uint16_t BinaryLog::Register(const char* fmt, const std::string& types) {
+    std::lock_guard lock(state->FileMutex);
+
+    SFormatHeader header{};
+    header.Id = state->NextFormatId++;
+    header.ArgCount = static_cast<uint8_t>(types.size());
+    header.FormatLength = static_cast<uint16_t>(strlen(fmt));
+
+    writeRaw(state->File, EEntry::Format);
+    writeRaw(state->File, header);
+    state->File.write(types.data(), header.ArgCount);
+    state->File.write(fmt, header.FormatLength);
+    return header.Id;
+}
+
+uint64_t BinaryLog::detail::Now() {
+    LARGE_INTEGER ticks;
+    QueryPerformanceCounter(&ticks);
+    return static_cast<uint64_t>(ticks.QuadPart);
+}
+
+void BinaryLog::detail::Push(const SRecord& record) {
+    // Same as the text log: when full, write the queue from this thread and try again.
+    for (int attempt = 0; !state->Queue.TryPush(record); ++attempt) {
+        if (attempt == 8) {
+            state->Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        drain();
+    }
+
+    // Errors are written right away.
+    if (record.Header.Level >= ERROR) {
+        drain();
+        return;
+    }
+
+    state->Pushed.fetch_add(1, std::memory_order_release);
+    state->Pushed.notify_one();
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include "BinaryLogFormat.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// Structured log: instead of formatting the message, the caller only records a
+// format string ID and the raw arguments. A background thread writes them to a
+// binary file, which tools/BinaryLogDecoder turns back into text. Cheap enough
+// to leave DEBUG messages on while tracking down a problem.
+namespace BinaryLog {
+    // Starts recording to file. Until then, BINLOG writes to the text log.
+    void Start(const std::string& file);
+    // Stops the writer thread, and writes what's left. BINLOG falls back to the text log after this.
+    void Stop();
+    // Writes everything recorded so far.
+    void Flush();
+    uint64_t Dropped();
+
+    // Returns the ID for a format string. BINLOG calls this once per call site.
+    uint16_t Register(const char* fmt, const std::string& types);
+
+    namespace detail {
+        extern std::atomic<bool> enabled;
+
+        constexpr size_t MaxArgsSize = 104;
+
+        struct SRecord {
+            SRecordHeader Header;
+            uint8_t Args[MaxArgsSize];
+        };
+
+        uint64_t Now();
+        void Push(const SRecord& record);
+
+        template <typename T>
+        constexpr char typeCode() {
+            using U = std::decay_t<T>;
+            if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>)
+                return ArgString;
+            else if constexpr (std::is_pointer_v<U>)
+                return ArgPointer;
+            else if constexpr (std::is_floating_point_v<U>)
+                return ArgDouble;
+            else if constexpr (std::is_enum_v<U> || std::is_integral_v<U> && std::is_signed_v<U>)
+                return ArgInt;
+            else if constexpr (std::is_integral_v<U>)
+                return ArgUInt;
+            else
+                static_assert(!sizeof(T), "Unsupported binary log argument type");
+        }
+
+        template <typename T>
+        void put(SRecord& record, const T& value) {
+            uint16_t& size = record.Header.ArgsSize;
+            uint8_t* out = record.Args + size;
+            const size_t space = MaxArgsSize - size;
+
+            if constexpr (typeCode<T>() == ArgString) {
+                const char* str = value ? value : "(null)";
+                if (space < 1)
+                    return;
+                size_t length = std::min({ strlen(str), space - 1, size_t{ 255 } });
+                out[0] = static_cast<uint8_t>(length);
+                memcpy(out + 1, str, length);
+                size += static_cast<uint16_t>(1 + length);
+            }
+            else {
+                if (space < 8)
+                    return;
+                uint64_t raw;
+                if constexpr (typeCode<T>() == ArgDouble) {
+                    double d = static_cast<double>(value);
+                    memcpy(&raw, &d, 8);
+                }
+                else if constexpr (typeCode<T>() == ArgPointer) {
+                    raw = reinterpret_cast<uintptr_t>(value);
+                }
+                else {
+                    raw = static_cast<uint64_t>(static_cast<int64_t>(value));
+                }
+                memcpy(out, &raw, 8);
+                size += 8;
+            }
+        }
+    }
+
+    inline bool Enabled() {
+        return detail::enabled.load(std::memory_order_relaxed);
+    }
+
+    template <typename... Args>
+    std::string TypeCodes(const Args&...) {
+        return { detail::typeCode<Args>()... };
+    }
+
+    template <typename... Args>
+    void Record(uint16_t id, LogLevel level, const Args&... args) {
+        detail::SRecord record;
+        record.Header.Level = static_cast<uint8_t>(level);
+        record.Header.FormatId = id;
+        record.Header.Ticks = detail::Now();
+        record.Header.ArgsSize = 0;
+        (detail::put(record, args), ...);
+        detail::Push(record);
+    }
+}
+
+// Same as logger.Write(level, fmt, ...), but recorded in the binary log when it's
+// running. fmt has to be a string literal, since it's registered once per call site.
+#define BINLOG(level, fmt, ...) \
+    do { \
+        if (BinaryLog::Enabled()) { \
+            static const uint16_t binlogFormatId = BinaryLog::Register(fmt, BinaryLog::TypeCodes(__VA_ARGS__)); \
+            BinaryLog::Record(binlogFormatId, level, ##__VA_ARGS__); \
+        } \
+        else { \
+            logger.Write(level, fmt, ##__VA_ARGS__); \
+        } \
+    } while (0)
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+
+// Layout of the binary log, shared with tools/BinaryLogDecoder.
+//
+// An SFileHeader, then entries that each start with an EEntry byte.
+// Everything is little-endian and packed.
+namespace BinaryLog {
+constexpr char Magic[8] = { 'T', 'F', 'B', 'L', 'O', 'G', '1', '\0' };
+
+#pragma pack(push, 1)
+struct SFileHeader {
+    char Magic[8];
+    // Record ticks per second
+    uint64_t TickFrequency;
+    // Ticks at the local time below
+    uint64_t StartTicks;
+    uint16_t Year;
+    uint16_t Month;
+    uint16_t Day;
+    uint16_t Hour;
+    uint16_t Minute;
+    uint16_t Second;
+    uint16_t Milliseconds;
+};
+
+// Written once per format string, before the first record using it. Followed by
+// ArgCount type codes (EArgType), then FormatLength characters.
+struct SFormatHeader {
+    uint16_t Id;
+    uint8_t ArgCount;
+    uint16_t FormatLength;
+};
+
+// Followed by ArgsSize bytes of arguments, in the order of the format's type codes.
+// Arguments that didn't fit are left out.
+struct SRecordHeader {
+    uint8_t Level;
+    uint16_t FormatId;
+    uint64_t Ticks;
+    uint16_t ArgsSize;
+};
+#pragma pack(pop)
+
+enum class EEntry : uint8_t {
+    Format = 1,
+    Record = 2,
+};
+
+// Numbers are stored as 8 bytes. Strings as a uint8 length, then the characters.
+enum EArgType : char {
+    ArgInt = 'i',
+    ArgUInt = 'u',
+    ArgDouble = 'd',
+    ArgString = 's',
+    ArgPointer = 'p',
+};
+}
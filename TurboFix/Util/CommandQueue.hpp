@@ -0,0 +1,71 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Bounded lock-free queue for multiple producers and a single consumer.
+// Based on Dmitry Vyukov's bounded MPMC queue, with a plain dequeue position
+// since only one thread pops at a time.
+template <typename T, size_t Capacity>
+class CCommandQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+public:
+    CCommandQueue() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            mCells[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    CCommandQueue(const CCommandQueue&) = delete;
+    CCommandQueue& operator=(const CCommandQueue&) = delete;
+
+    // False when the queue is full.
+    bool TryPush(const T& data) {
+        SCell* cell;
+        size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &mCells[pos & (Capacity - 1)];
+            size_t seq = cell->Sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = mEnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->Data = data;
+        cell->Sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Only call from one thread at a time. False when the queue is empty.
+    bool TryPop(T& data) {
+        SCell& cell = mCells[mDequeuePos & (Capacity - 1)];
+        size_t seq = cell.Sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(mDequeuePos + 1) < 0)
+            return false;
+
+        data = cell.Data;
+        cell.Sequence.store(mDequeuePos + Capacity, std::memory_order_release);
+        ++mDequeuePos;
+        return true;
+    }
+
+private:
+    struct SCell {
+        std::atomic<size_t> Sequence;
+        T Data;
+    };
+
+    std::array<SCell, Capacity> mCells;
+    alignas(64) std::atomic<size_t> mEnqueuePos = 0;
+    alignas(64) size_t mDequeuePos = 0;
+};
@@ -6,6 +6,7 @@
 #include <Windows.h>
 #include <Psapi.h>
 #include <filesystem>
+#include <vector>
 
 #pragma comment(lib, "Version.lib")
 
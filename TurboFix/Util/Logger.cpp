@@ -1,53 +1,175 @@
 #include "Logger.hpp"
 
+#include "Threads.hpp"
+
 #include <Windows.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstring>
 #include <iomanip>
-#include <fstream>
 
-Logger::Logger() = default;
+namespace {
+    const char* const levelStrings[] = {
+        " DEBUG ",
+        " INFO  ",
+        "WARNING",
+        " ERROR ",
+        " FATAL ",
+    };
+}
+
+Logger::Logger()
+    : mState(new SState()) {
+}
+
+Logger::~Logger() {
+    bool exited = true;
+    if (mThread.joinable()) {
+        mState->Stop.store(true);
+        mState->Pushed.fetch_add(1);
+        mState->Pushed.notify_one();
+        exited = Threads::Detach(mThread);
+    }
+
+    // When the writer thread ended with the process, it may have been in drain:
+    // the mutex would never be released, so don't wait for it.
+    drain(*mState, !exited);
+}
 
 void Logger::SetFile(const std::string &fileName) {
-    file = fileName;
+    std::lock_guard lock(mState->FileMutex);
+    if (fileName != file) {
+        file = fileName;
+        mState->File.close();
+        mState->File.open(file, std::ios_base::out | std::ios_base::app);
+    }
+
+    // SetFile is called from DllMain for every reason, only start once.
+    if (!mThread.joinable())
+        mThread = std::thread(&Logger::run, mState);
 }
 
 void Logger::SetMinLevel(LogLevel level) {
     minLevel = level;
 }
 
-void Logger::Clear() const {
-    std::ofstream logFile(file, std::ofstream::out | std::ofstream::trunc);
+void Logger::Clear() {
+    std::lock_guard lock(mState->FileMutex);
+    mState->File.close();
+    mState->File.open(file, std::ofstream::out | std::ofstream::trunc);
 }
 
-void Logger::Write(LogLevel level, const std::string& text) const {
-#ifndef _DEBUG
-    if (level < minLevel) return;
-#endif
-    std::ofstream logFile(file, std::ios_base::out | std::ios_base::app);
-    SYSTEMTIME currTimeLog;
-    GetLocalTime(&currTimeLog);
-    logFile << "[" <<
-        std::setw(2) << std::setfill('0') << currTimeLog.wHour << ":" <<
-        std::setw(2) << std::setfill('0') << currTimeLog.wMinute << ":" <<
-        std::setw(2) << std::setfill('0') << currTimeLog.wSecond << "." <<
-        std::setw(3) << std::setfill('0') << currTimeLog.wMilliseconds << "] " <<
-        "[" << levelText(level) << "] " <<
-        text << "\n";
-}
-
-void Logger::Write(LogLevel level, const char *fmt, ...) const {
-    const int size = 1024;
-    char buff[size];
+void Logger::Write(LogLevel level, const std::string& text) {
+    if (!Enabled(level)) return;
+    SEntry entry;
+    entry.Level = level;
+    size_t length = std::min(text.size(), MaxMessageLength - 1);
+    memcpy(entry.Text, text.c_str(), length);
+    entry.Text[length] = '\0';
+    push(entry);
+}
+
+void Logger::Write(LogLevel level, const char *fmt, ...) {
+    if (!Enabled(level)) return;
+    SEntry entry;
+    entry.Level = level;
     va_list args;
     va_start(args, fmt);
-    vsnprintf(buff, size, fmt, args);
+    vsnprintf(entry.Text, MaxMessageLength, fmt, args);
     va_end(args);
-    Write(level, std::string(buff));
+    push(entry);
 }
 
-std::string Logger::levelText(LogLevel level) const {
-    return levelStrings[level];
+void Logger::Flush() {
+    drain(*mState);
+}
+
+void Logger::push(const SEntry& entry) {
+    SYSTEMTIME currTimeLog;
+    GetLocalTime(&currTimeLog);
+
+    SEntry stamped = entry;
+    stamped.Hour = currTimeLog.wHour;
+    stamped.Minute = currTimeLog.wMinute;
+    stamped.Second = currTimeLog.wSecond;
+    stamped.Milliseconds = currTimeLog.wMilliseconds;
+
+    // When full, make room by writing the queue from this thread. Other threads
+    // may fill it up again in between, so only give up after a few tries.
+    for (int attempt = 0; !mState->Queue.TryPush(stamped); ++attempt) {
+        if (attempt == 8) {
+            mState->Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        drain(*mState);
+    }
+
+    // Errors are written right away, in case the game goes down next.
+    if (entry.Level >= ERROR) {
+        drain(*mState);
+        return;
+    }
+
+    mState->Pushed.fetch_add(1, std::memory_order_release);
+    mState->Pushed.notify_one();
+}
+
+void Logger::drain(SState& state, bool wait) {
+    std::unique_lock lock(state.FileMutex, std::defer_lock);
+    if (wait)
+        lock.lock();
+    else if (!lock.try_lock())
+        return;
+
+    bool wrote = false;
+    SEntry entry;
+    while (state.Queue.TryPop(entry)) {
+        state.File << "[" <<
+            std::setw(2) << std::setfill('0') << entry.Hour << ":" <<
+            std::setw(2) << std::setfill('0') << entry.Minute << ":" <<
+            std::setw(2) << std::setfill('0') << entry.Second << "." <<
+            std::setw(3) << std::setfill('0') << entry.Milliseconds << "] " <<
+            "[" << levelStrings[entry.Level] << "] " <<
+            entry.Text << "\n";
+        wrote = true;
+    }
+
+    if (wrote)
+        state.File.flush();
+}
+
+void Logger::run(SState* state) {
+    uint32_t seen = 0;
+    while (!state->Stop.load()) {
+        state->Pushed.wait(seen, std::memory_order_acquire);
+        seen = state->Pushed.load(std::memory_order_acquire);
+        drain(*state);
+    }
 }
 
 // Everything's gonna use this instance.
 Logger logger;
+
+bool CLogLimiter::Allow(uint32_t& suppressed) {
+    int64_t nowUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    std::lock_guard lock(mMutex);
+    if (mLastRefillUs != 0) {
+        double elapsedSec = static_cast<double>(nowUs - mLastRefillUs) / 1e6;
+        mTokens = std::min(Burst, mTokens + elapsedSec * PerSecond);
+    }
+    mLastRefillUs = nowUs;
+
+    if (mTokens < 1.0) {
+        ++mSuppressed;
+        return false;
+    }
+
+    mTokens -= 1.0;
+    suppressed = mSuppressed;
+    mSuppressed = 0;
+    return true;
+}
@@ -1,6 +1,12 @@
 #pragma once
+#include "CommandQueue.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
 #include <string>
-#include <vector>
+#include <thread>
 
 enum LogLevel {
     DEBUG,
@@ -10,27 +16,127 @@ enum LogLevel {
     FATAL,
 };
 
+// Write formats the message into a lock-free queue and returns. A background
+// thread writes queued messages in batches, to a file that stays open.
+// ERROR and FATAL messages, and Flush, write everything queued right away.
 class Logger {
 
 public:
     Logger();
+    ~Logger();
     void SetFile(const std::string &fileName);
     void SetMinLevel(LogLevel level);
-    void Clear() const;
-    void Write(LogLevel level, const std::string& text) const;
-    void Write(LogLevel level, const char *fmt, ...) const;
+    void Clear();
+    void Write(LogLevel level, const std::string& text);
+    void Write(LogLevel level, const char *fmt, ...);
+
+    // Debug builds log everything, release builds only minLevel and up.
+    bool Enabled(LogLevel level) const {
+#ifdef _DEBUG
+        return true;
+#else
+        return level >= minLevel;
+#endif
+    }
+
+    // Writes all queued messages to the file before returning.
+    void Flush();
+
+    // Messages that didn't fit in the queue, even after flushing it.
+    uint64_t Dropped() const {
+        return mState->Dropped.load(std::memory_order_relaxed);
+    }
 
 private:
+    // Messages longer than this are cut off.
+    static constexpr size_t MaxMessageLength = 480;
+
+    struct SEntry {
+        LogLevel Level;
+        uint16_t Hour;
+        uint16_t Minute;
+        uint16_t Second;
+        uint16_t Milliseconds;
+        char Text[MaxMessageLength];
+    };
+
+    // Everything the writer thread uses.
+    struct SState {
+        CCommandQueue<SEntry, 1024> Queue;
+        std::atomic<uint64_t> Dropped = 0;
+
+        // Guards the file, and popping from the queue.
+        std::mutex FileMutex;
+        std::ofstream File;
+
+        std::atomic<uint32_t> Pushed = 0;
+        std::atomic<bool> Stop = false;
+    };
+
+    void push(const SEntry& entry);
+    // Writes queued entries. Takes FileMutex, or gives up when it's taken and
+    // wait is false.
+    static void drain(SState& state, bool wait = true);
+    static void run(SState* state);
+
     std::string file = "";
-    std::string levelText(LogLevel level) const;
     LogLevel minLevel = INFO;
-    const std::vector<std::string> levelStrings{
-        " DEBUG ",
-        " INFO  ",
-        "WARNING",
-        " ERROR ",
-        " FATAL ",
-    };
+
+    // Never freed: the writer thread may outlive the logger, see Threads::Detach.
+    // This also keeps logging safe from other destructors that run after this one.
+    SState* mState;
+    std::thread mThread;
 };
 
 extern Logger logger;
+
+// Token bucket for a single LOG_* call site: Burst messages, then PerSecond.
+class CLogLimiter {
+public:
+    static constexpr double Burst = 50.0;
+    static constexpr double PerSecond = 2.0;
+
+    // False when the site ran out of tokens. Otherwise true, with suppressed set
+    // to the number of messages dropped since the last one that went through.
+    bool Allow(uint32_t& suppressed);
+
+private:
+    std::mutex mMutex;
+    double mTokens = Burst;
+    int64_t mLastRefillUs = 0;
+    uint32_t mSuppressed = 0;
+};
+
+// Levels below this are compiled out of the LOG_* macros, including their arguments.
+// DllMain sets the runtime level to DEBUG, so all levels are kept by default.
+// Define it as e.g. INFO to strip the DEBUG messages from a build.
+#ifndef TF_LOG_LEVEL
+#define TF_LOG_LEVEL DEBUG
+#endif
+
+// For messages that can repeat every tick. Arguments are only evaluated when the
+// level is logged, and every call site is rate limited, so it can't flood the log.
+// Loops over configs or sound sets at load time use logger.Write instead: those
+// are bounded, and a limited site drops lines past Burst, only saying so when it
+// logs again later.
+// level has to be a constant.
+#define TF_LOG(level, fmt, ...) \
+    do { \
+        if constexpr ((level) >= TF_LOG_LEVEL) { \
+            if (logger.Enabled(level)) { \
+                static CLogLimiter logLimiter; \
+                uint32_t logSuppressed = 0; \
+                if (logLimiter.Allow(logSuppressed)) { \
+                    if (logSuppressed > 0) \
+                        logger.Write(level, "[Log] Suppressed %u message(s) like [%s]", logSuppressed, fmt); \
+                    logger.Write(level, fmt, ##__VA_ARGS__); \
+                } \
+            } \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(fmt, ...) TF_LOG(DEBUG, fmt, ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...)  TF_LOG(INFO, fmt, ##__VA_ARGS__)
+#define LOG_WARN(fmt, ...)  TF_LOG(WARN, fmt, ##__VA_ARGS__)
+#define LOG_ERROR(fmt, ...) TF_LOG(ERROR, fmt, ##__VA_ARGS__)
+#define LOG_FATAL(fmt, ...) TF_LOG(FATAL, fmt, ##__VA_ARGS__)
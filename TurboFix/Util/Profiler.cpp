@@ -0,0 +1,295 @@
+#include "Profiler.hpp"
+
+#include "Logger.hpp"
+
+#include <Windows.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    // Exact below 8 ns, then 8 buckets per power of two: within 12.5% of the real value.
+    constexpr uint32_t SubBuckets = 8;
+    constexpr uint32_t SubBits = 3;
+    // 2^40 ns is about 18 minutes, anything longer goes in the last bucket.
+    constexpr uint32_t MaxExponent = 40;
+    constexpr uint32_t BucketCount = (MaxExponent - SubBits + 2) * SubBuckets;
+
+    struct SZone {
+        uint64_t Count = 0;
+        uint64_t TotalNs = 0;
+        uint64_t MaxNs = 0;
+        uint64_t LastNs = 0;
+        std::array<uint64_t, BucketCount> Buckets{};
+    };
+
+    const char* zoneNames[] = {
+        "ScriptTick",
+        "PlayerTick",
+        "Menu",
+        "NPC",
+        "Turbo",
+        "Ptfx",
+        "Sfx",
+        "LoadConfigs",
+        "NPCTick",
+        "Audio",
+        "SoundSets",
+        "PtfxFlush",
+    };
+    static_assert(std::size(zoneNames) == static_cast<size_t>(Profiler::EZone::Count));
+
+    // Only touched from the script thread.
+    std::array<SZone, static_cast<size_t>(Profiler::EZone::Count)> zones;
+
+    struct STraceEvent {
+        Profiler::EZone Zone;
+        int64_t Arg;
+        std::chrono::steady_clock::time_point Start;
+        std::chrono::steady_clock::time_point End;
+    };
+
+    // Per thread, so threads don't contend with each other. The mutex is only
+    // shared with the script thread writing the trace at the end.
+    struct SThreadBuffer {
+        uint32_t ThreadId;
+        std::mutex Mutex;
+        std::vector<STraceEvent> Events;
+    };
+
+    // About 32 MB per thread at most.
+    constexpr size_t MaxEventsPerThread = 1000000;
+
+    struct STrace {
+        std::string File;
+        std::chrono::steady_clock::time_point Start;
+        std::chrono::steady_clock::time_point End;
+        uint32_t ScriptThreadId = 0;
+
+        // Bumped for every trace, so threads register a new buffer.
+        std::atomic<uint32_t> Generation = 0;
+        std::atomic<uint64_t> Dropped = 0;
+
+        std::mutex BuffersMutex;
+        std::vector<std::shared_ptr<SThreadBuffer>> Buffers;
+    };
+
+    STrace trace;
+
+    thread_local std::shared_ptr<SThreadBuffer> threadBuffer;
+    thread_local uint32_t threadGeneration = 0;
+
+    SThreadBuffer& getThreadBuffer() {
+        uint32_t generation = trace.Generation.load(std::memory_order_acquire);
+        if (!threadBuffer || threadGeneration != generation) {
+            threadBuffer = std::make_shared<SThreadBuffer>();
+            threadBuffer->ThreadId = GetCurrentThreadId();
+            threadBuffer->Events.reserve(4096);
+            threadGeneration = generation;
+
+            std::lock_guard lock(trace.BuffersMutex);
+            trace.Buffers.push_back(threadBuffer);
+        }
+        return *threadBuffer;
+    }
+
+    double traceUs(std::chrono::steady_clock::time_point time) {
+        return std::chrono::duration<double, std::micro>(std::chrono::operator-(time, trace.Start)).count();
+    }
+
+    bool writeTrace() {
+        std::ofstream out(trace.File, std::ofstream::out | std::ofstream::trunc);
+        if (!out.is_open())
+            return false;
+
+        std::lock_guard buffersLock(trace.BuffersMutex);
+
+        // Complete ("X") events carry both begin and end, so an event cut off by
+        // the end of the capture can't leave an unmatched begin behind.
+        char line[256];
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        for (const auto& buffer : trace.Buffers) {
+            std::lock_guard lock(buffer->Mutex);
+
+            snprintf(line, sizeof(line),
+                "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}}",
+                first ? "" : ",\n", buffer->ThreadId,
+                buffer->ThreadId == trace.ScriptThreadId ? "Script" : "Thread", buffer->ThreadId);
+            out << line;
+            first = false;
+
+            for (const auto& event : buffer->Events) {
+                int length = snprintf(line, sizeof(line),
+                    ",\n{\"name\":\"%s\",\"cat\":\"TurboFix\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                    zoneNames[static_cast<size_t>(event.Zone)], buffer->ThreadId,
+                    traceUs(event.Start), traceUs(event.End) - traceUs(event.Start));
+                if (event.Arg != 0) {
+                    snprintf(line + length, sizeof(line) - length, ",\"args\":{\"arg\":%lld}}",
+                        static_cast<long long>(event.Arg));
+                }
+                else {
+                    snprintf(line + length, sizeof(line) - length, "}");
+                }
+                out << line;
+            }
+            buffer->Events.clear();
+            buffer->Events.shrink_to_fit();
+        }
+        out << "\n]}\n";
+
+        trace.Buffers.clear();
+        return true;
+    }
+
+    uint32_t bucketIndex(uint64_t ns) {
+        if (ns < SubBuckets)
+            return static_cast<uint32_t>(ns);
+
+        uint32_t exponent = static_cast<uint32_t>(std::bit_width(ns)) - 1;
+        if (exponent > MaxExponent)
+            return BucketCount - 1;
+
+        uint32_t sub = static_cast<uint32_t>(ns >> (exponent - SubBits)) - SubBuckets;
+        return (exponent - SubBits + 1) * SubBuckets + sub;
+    }
+
+    // Upper bound of the bucket, so percentiles err on the slow side.
+    uint64_t bucketMaxNs(uint32_t index) {
+        if (index < SubBuckets)
+            return index;
+
+        uint32_t exponent = index / SubBuckets + SubBits - 1;
+        uint64_t sub = index % SubBuckets;
+        return ((SubBuckets + sub + 1) << (exponent - SubBits)) - 1;
+    }
+
+    double percentileUs(const SZone& zone, double fraction) {
+        if (zone.Count == 0)
+            return 0.0;
+
+        uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * static_cast<double>(zone.Count) + 0.5));
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < BucketCount; ++i) {
+            seen += zone.Buckets[i];
+            if (seen >= target && i < BucketCount - 1)
+                return static_cast<double>(std::min(bucketMaxNs(i), zone.MaxNs)) / 1000.0;
+        }
+        // Only the overflow bucket has no upper bound.
+        return static_cast<double>(zone.MaxNs) / 1000.0;
+    }
+}
+
+std::atomic<bool> Profiler::detail::tracing = false;
+
+void Profiler::Record(EZone zone, uint64_t ns) {
+    SZone& z = zones[static_cast<size_t>(zone)];
+    ++z.Count;
+    z.TotalNs += ns;
+    z.MaxNs = std::max(z.MaxNs, ns);
+    z.LastNs = ns;
+    ++z.Buckets[bucketIndex(ns)];
+}
+
+Profiler::SZoneStats Profiler::Stats(EZone zone) {
+    const SZone& z = zones[static_cast<size_t>(zone)];
+    return {
+        zoneNames[static_cast<size_t>(zone)],
+        z.Count,
+        z.Count == 0 ? 0.0 : static_cast<double>(z.TotalNs) / static_cast<double>(z.Count) / 1000.0,
+        percentileUs(z, 0.50),
+        percentileUs(z, 0.95),
+        percentileUs(z, 0.99),
+        static_cast<double>(z.MaxNs) / 1000.0,
+        static_cast<double>(z.LastNs) / 1000.0,
+        static_cast<double>(z.TotalNs) / 1000.0,
+    };
+}
+
+void Profiler::Reset() {
+    zones.fill(SZone{});
+}
+
+bool Profiler::Dump(const std::string& file) {
+    std::ofstream out(file, std::ofstream::out | std::ofstream::trunc);
+    if (!out.is_open())
+        return false;
+
+    char line[160];
+    snprintf(line, sizeof(line), "%-12s %10s %10s %10s %10s %10s %10s\n",
+        "Zone", "Count", "Avg (us)", "p50 (us)", "p95 (us)", "p99 (us)", "Max (us)");
+    out << line;
+
+    for (size_t i = 0; i < static_cast<size_t>(EZone::Count); ++i) {
+        auto stats = Stats(static_cast<EZone>(i));
+        snprintf(line, sizeof(line), "%-12s %10llu %10.2f %10.2f %10.2f %10.2f %10.2f\n",
+            stats.Name, static_cast<unsigned long long>(stats.Count),
+            stats.AvgUs, stats.P50Us, stats.P95Us, stats.P99Us, stats.MaxUs);
+        out << line;
+    }
+    return true;
+}
+
+void Profiler::StartTrace(const std::string& file, unsigned seconds) {
+    if (detail::tracing.load())
+        return;
+
+    {
+        std::lock_guard lock(trace.BuffersMutex);
+        trace.Buffers.clear();
+    }
+    trace.File = file;
+    trace.Start = std::chrono::steady_clock::now();
+    trace.End = trace.Start + std::chrono::seconds(seconds);
+    trace.ScriptThreadId = GetCurrentThreadId();
+    trace.Dropped.store(0);
+    trace.Generation.fetch_add(1, std::memory_order_release);
+
+    detail::tracing.store(true);
+    logger.Write(INFO, "[Profiler] Recording a %u s trace to [%s]", seconds, file.c_str());
+}
+
+bool Profiler::UpdateTrace() {
+    if (!detail::tracing.load() || std::chrono::steady_clock::now() < trace.End)
+        return false;
+
+    detail::tracing.store(false);
+    auto status = TraceStatus();
+    if (!writeTrace()) {
+        logger.Write(ERROR, "[Profiler] Couldn't write trace to [%s]", trace.File.c_str());
+        return false;
+    }
+
+    logger.Write(INFO, "[Profiler] Wrote %llu trace events (%llu dropped) to [%s]",
+        static_cast<unsigned long long>(status.Events),
+        static_cast<unsigned long long>(status.Dropped), trace.File.c_str());
+    return true;
+}
+
+Profiler::STraceStatus Profiler::TraceStatus() {
+    uint64_t events = 0;
+    {
+        std::lock_guard buffersLock(trace.BuffersMutex);
+        for (const auto& buffer : trace.Buffers) {
+            std::lock_guard lock(buffer->Mutex);
+            events += buffer->Events.size();
+        }
+    }
+    return { detail::tracing.load(), events, trace.Dropped.load() };
+}
+
+void Profiler::detail::TraceEvent(EZone zone, std::chrono::steady_clock::time_point start,
+                                  std::chrono::steady_clock::time_point end, int64_t arg) {
+    SThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard lock(buffer.Mutex);
+    if (buffer.Events.size() >= MaxEventsPerThread) {
+        trace.Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.Events.push_back({ zone, arg, start, end });
+}
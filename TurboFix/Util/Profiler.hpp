@@ -0,0 +1,128 @@
+#pragma once
+#include "AllocTracker.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Times fixed zones of the script tick. Each zone keeps a log-linear histogram
+// of its durations, for percentiles without storing samples.
+// While a trace is recording, zones are also stored as individual events and
+// written as Chrome trace JSON, for chrome://tracing or ui.perfetto.dev.
+// Build with TF_PROFILER=0 to compile the zones out entirely.
+#ifndef TF_PROFILER
+#define TF_PROFILER 1
+#endif
+
+namespace Profiler {
+    enum class EZone {
+        ScriptTick,
+        PlayerTick,
+        Menu,
+        NPC,
+        Turbo,
+        Ptfx,
+        Sfx,
+        LoadConfigs,
+        NPCTick,
+        Audio,
+        SoundSets,
+        PtfxFlush,
+        Count
+    };
+
+    struct SZoneStats {
+        const char* Name;
+        uint64_t Count;
+        double AvgUs;
+        double P50Us;
+        double P95Us;
+        double P99Us;
+        double MaxUs;
+        // Most recent run
+        double LastUs;
+        // All runs together. Differences between two calls give the time spent
+        // in between, e.g. per frame for zones that run once per vehicle.
+        double TotalUs;
+    };
+
+    constexpr bool Enabled = TF_PROFILER != 0;
+
+    void Record(EZone zone, uint64_t ns);
+
+    SZoneStats Stats(EZone zone);
+    void Reset();
+
+    // Writes all zones as a table. Returns false if the file couldn't be opened.
+    bool Dump(const std::string& file);
+
+    // Records every zone on every thread for the next seconds, then writes them to file.
+    // Does nothing if a trace is already recording.
+    void StartTrace(const std::string& file, unsigned seconds);
+
+    // Call once per tick, from the script thread. Writes the trace when its time is up.
+    // Returns true on the tick the trace got written.
+    bool UpdateTrace();
+
+    struct STraceStatus {
+        bool Recording;
+        uint64_t Events;
+        uint64_t Dropped;
+    };
+
+    STraceStatus TraceStatus();
+
+    namespace detail {
+        extern std::atomic<bool> tracing;
+
+        // arg is shown in the event's details, when non-zero.
+        void TraceEvent(EZone zone, std::chrono::steady_clock::time_point start,
+            std::chrono::steady_clock::time_point end, int64_t arg);
+    }
+
+    class CZone {
+    public:
+        explicit CZone(EZone zone, int64_t arg = 0)
+            : mZone(zone)
+            , mArg(arg)
+#if TF_ALLOC_TRACKING
+            , mAllocTag(static_cast<int>(zone))
+#endif
+            , mStart(std::chrono::steady_clock::now()) {}
+
+        ~CZone() {
+            auto end = std::chrono::steady_clock::now();
+            // Util/Math.hpp's operator- clashes with chrono's.
+            auto elapsed = std::chrono::operator-(end, mStart);
+            Record(mZone, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+
+            if (detail::tracing.load(std::memory_order_relaxed))
+                detail::TraceEvent(mZone, mStart, end, mArg);
+        }
+
+        CZone(const CZone&) = delete;
+        CZone& operator=(const CZone&) = delete;
+
+    private:
+        EZone mZone;
+        int64_t mArg;
+#if TF_ALLOC_TRACKING
+        AllocTracker::CTagScope mAllocTag;
+#endif
+        std::chrono::steady_clock::time_point mStart;
+    };
+}
+
+#define PROFILER_CONCAT_(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_(a, b)
+
+// Times the rest of the enclosing scope as zone. The _ARG variant adds a number
+// (e.g. a vehicle handle) to the zone's trace events.
+#if TF_PROFILER
+#define PROFILE_ZONE(zone) Profiler::CZone PROFILER_CONCAT(profileZone, __LINE__)(Profiler::EZone::zone)
+#define PROFILE_ZONE_ARG(zone, arg) Profiler::CZone PROFILER_CONCAT(profileZone, __LINE__)(Profiler::EZone::zone, static_cast<int64_t>(arg))
+#else
+#define PROFILE_ZONE(zone) ((void)0)
+#define PROFILE_ZONE_ARG(zone, arg) ((void)0)
+#endif
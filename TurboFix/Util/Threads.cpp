@@ -0,0 +1,20 @@
+#include "Threads.hpp"
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+bool Threads::Detach(std::thread& thread) {
+    if (!thread.joinable())
+        return true;
+
+#ifdef _WIN32
+    // Doesn't wait: only checks whether the thread handle is signaled.
+    bool exited = WaitForSingleObject(thread.native_handle(), 0) == WAIT_OBJECT_0;
+#else
+    // Only the tools build this elsewhere, and they don't unload.
+    bool exited = false;
+#endif
+    thread.detach();
+    return exited;
+}
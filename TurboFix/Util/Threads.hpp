@@ -0,0 +1,16 @@
+#pragma once
+#include <thread>
+
+namespace Threads {
+    // Lets go of a thread that was told to stop, without waiting for it.
+    //
+    // Background threads are stopped from destructors that run during
+    // DLL_PROCESS_DETACH. Joining there deadlocks on the loader lock, and waiting
+    // only delays the unload, so whatever the thread uses has to stay alive
+    // after this: leak it, or let the thread clean up on its way out.
+    //
+    // Returns true when the thread had already exited. On process exit, Windows
+    // ends all other threads before DLL_PROCESS_DETACH, so that's the usual case,
+    // and the caller can clean up in the thread's place.
+    bool Detach(std::thread& thread);
+}
@@ -0,0 +1,194 @@
+// Runs the script on the fake game in tools/Stubs with a fixed set of turbo NPC
+// vehicles cycling through anti-lag, and fails when a steady-state tick makes
+// more heap allocations than [Debug] AllocBudget (Util/AllocTracker.hpp).
+//
+// Linux and x86-64 only, see tools/StressHarness. From this folder:
+//   g++ -std=c++20 -O2 -fpermissive -DFMT_HEADER_ONLY -DTF_ALLOC_TRACKING=1 '-D__declspec(x)=' -I../Stubs -I../Stubs/lowercase -I../../TurboFix -I../../thirdparty/ScriptHookV_SDK -I../../thirdparty -I../../thirdparty/fmt/include -o AllocBudget AllocBudget.cpp ../Stubs/Headless.cpp ../Stubs/HeadlessScript.cpp ../Stubs/Windows.cpp ../../TurboFix/{Script,TurboScript,TurboScriptNPC,StressTest,Config,ScriptSettings,Compatibility}.cpp ../../TurboFix/Audio/{AudioThread,Decode,Mix,RecordingBackend,SoundSetLoader,Synth,VoicePool,Wav}.cpp ../../TurboFix/Memory/{NativeMemory,PatternScan,Patches,VehicleExtensions}.cpp ../../TurboFix/Ptfx/*.cpp ../../TurboFix/Util/{AddonSpawnerCache,AllocTracker,BinaryLog,Logger,Paths,Profiler,String,Threads,UI}.cpp -pthread
+//
+// Usage:
+//   AllocBudget [work folder] [budget]
+//
+// Without a budget, the script's default is used. Exits with 1 when a check fails.
+
+#include "Headless.hpp"
+
+#include "Script.hpp"
+#include "Memory/NativeMemory.hpp"
+#include "Memory/Patches.h"
+#include "Memory/VehicleExtensions.hpp"
+#include "Util/AllocTracker.hpp"
+#include "Util/Logger.hpp"
+#include "Util/Paths.hpp"
+
+#include <inc/enums.h>
+#include <inc/natives.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+using VExt = VehicleExtensions;
+
+namespace {
+    constexpr unsigned VehicleCount = 100;
+    constexpr float Spacing = 20.0f;
+    // Frames checked after the script's warm-up.
+    constexpr unsigned SteadyFrames = 1200;
+    // Throttle on, then off: lift-off is what triggers the anti-lag effects.
+    constexpr float ProfileCycleSec = 2.0f;
+
+    int failures = 0;
+
+    void check(bool ok, const char* what) {
+        printf("  [%s] %s\n", ok ? "ok" : "FAIL", what);
+        if (!ok)
+            ++failures;
+    }
+
+    void writeFile(const std::string& file, const std::string& text) {
+        std::ofstream out(file, std::ofstream::out | std::ofstream::trunc);
+        out << text;
+    }
+
+    void writeModFiles(int budget) {
+        fs::create_directories(Headless::ModPath("\\Configs"));
+        fs::create_directories(fs::path(Headless::ModPath("\\Sounds")) / "Synth");
+
+        std::string general =
+            "[Audio]\n"
+            "Backend = Null\n"
+            "[Debug]\n";
+        if (budget >= 0)
+            general += "AllocBudget = " + std::to_string(budget) + "\n";
+        writeFile(Headless::ModPath("\\settings_general.ini"), general);
+
+        writeFile(Headless::ModPath("\\Configs") + "/Default.ini",
+            "[AntiLag]\n"
+            "Enable = true\n"
+            "Effects = true\n"
+            "SoundSet = Synth\n");
+
+        writeFile((fs::path(Headless::ModPath("\\Sounds")) / "Synth" / "SoundSet.ini").string(),
+            "[SoundSet]\n"
+            "Type = Synth\n");
+    }
+
+    std::vector<Vehicle> spawnVehicles() {
+        std::vector<Vehicle> vehicles;
+        Hash model = MISC::GET_HASH_KEY("sultan");
+        const unsigned columns = 10;
+        for (unsigned i = 0; i < VehicleCount; ++i) {
+            Vector3 position{};
+            position.x = static_cast<float>(i % columns) * Spacing;
+            position.y = static_cast<float>(i / columns) * Spacing;
+            Vehicle vehicle = VEHICLE::CREATE_VEHICLE(model, position, 0.0f, false, true, false);
+            VEHICLE::TOGGLE_VEHICLE_MOD(vehicle, VehicleToggleModTurbo, true);
+            VEHICLE::SET_VEHICLE_ENGINE_ON(vehicle, true, true, true);
+            vehicles.push_back(vehicle);
+        }
+        return vehicles;
+    }
+
+    void applyProfile(Vehicle vehicle, unsigned index, float timeSec) {
+        float phase = static_cast<float>(index) / VehicleCount * ProfileCycleSec;
+        float cycle = std::fmod(timeSec + phase, ProfileCycleSec) / ProfileCycleSec;
+        float throttle = cycle < 0.5f ? 1.0f : 0.0f;
+        float rpm = cycle < 0.5f ? 0.2f + 1.6f * cycle : 1.0f - 1.6f * (cycle - 0.5f);
+
+        VExt::SetThrottle(vehicle, throttle);
+        VExt::SetThrottleP(vehicle, throttle);
+        VExt::SetCurrentRPM(vehicle, rpm);
+    }
+}
+
+int main(int argc, char** argv) {
+    const fs::path workFolder = fs::absolute(argc > 1 ? argv[1] : "AllocBudget.out");
+    const int budget = argc > 2 ? atoi(argv[2]) : -1;
+    fs::create_directories(workFolder);
+
+    if (!AllocTracker::Enabled) {
+        fprintf(stderr, "Build with TF_ALLOC_TRACKING=1\n");
+        return 1;
+    }
+
+    Headless::SOptions options;
+    options.Folder = (workFolder / "game").string();
+    Headless::Init(options);
+    writeModFiles(budget);
+
+    // What DllMain does.
+    logger.SetFile(Headless::ModPath("\\TurboFix.log"));
+    logger.SetMinLevel(DEBUG);
+    logger.Clear();
+    Paths::SetOurModuleHandle(Headless::ScriptModule());
+    Patches::SetPatterns();
+
+    TurboFix::ScriptInit();
+    mem::GetAddressOfEntity = Headless::GetAddressOfEntity;
+
+    const std::vector<Vehicle> vehicles = spawnVehicles();
+
+    // Tagged allocations of each frame after the warm-up, and the worst one per tag.
+    const size_t tags = AllocTracker::TagCount() - 1;
+    std::vector<uint64_t> maxAllocs(tags);
+    uint64_t warmupAllocs = 0;
+    uint64_t steadyAllocs = 0;
+    uint64_t worstFrame = 0;
+
+    // Runs after EndFrame, in WAIT. The harness allocates nothing in here.
+    Headless::OnFrame([&]() {
+        uint64_t frame = AllocTracker::Frames();
+        uint64_t frameAllocs = 0;
+        for (size_t i = 0; i < tags; ++i) {
+            auto stats = AllocTracker::Stats(i);
+            frameAllocs += stats.LastAllocs;
+            if (frame > AllocTracker::WarmupFrames)
+                maxAllocs[i] = std::max(maxAllocs[i], stats.LastAllocs);
+        }
+
+        if (frame <= AllocTracker::WarmupFrames) {
+            warmupAllocs += frameAllocs;
+        }
+        else {
+            steadyAllocs += frameAllocs;
+            worstFrame = std::max(worstFrame, frameAllocs);
+        }
+
+        if (frame >= AllocTracker::WarmupFrames + SteadyFrames)
+            throw Headless::SStop{};
+
+        float timeSec = static_cast<float>(MISC::GET_GAME_TIMER()) / 1000.0f;
+        for (size_t i = 0; i < vehicles.size(); ++i) {
+            applyProfile(vehicles[i], static_cast<unsigned>(i), timeSec);
+        }
+    });
+
+    printf("Steady-state allocations, %u vehicles\n", VehicleCount);
+    try {
+        TurboFix::ScriptTick();
+    }
+    catch (const Headless::SStop&) {
+    }
+
+    for (size_t i = 0; i < tags; ++i) {
+        if (maxAllocs[i] > 0)
+            printf("  %-12s max %llu/frame\n", AllocTracker::Stats(i).Name,
+                static_cast<unsigned long long>(maxAllocs[i]));
+    }
+    printf("  %.2f allocations/frame, worst frame %llu, %llu frame(s) over budget\n",
+        static_cast<double>(steadyAllocs) / SteadyFrames, static_cast<unsigned long long>(worstFrame),
+        static_cast<unsigned long long>(AllocTracker::OverBudgetFrames()));
+
+    auto world = Headless::WorldStats();
+    check(TurboFix::GetNPCScriptCount() == VehicleCount, "every vehicle has an instance");
+    check(world.PtfxStarted > 0, "anti-lag effects played");
+    check(warmupAllocs > 0, "allocations are counted");
+    check(AllocTracker::OverBudgetFrames() == 0, "no steady-state frame over budget");
+
+    printf("\n%s (%d failed), log in [%s]\n", failures == 0 ? "Passed" : "Failed", failures,
+        workFolder.string().c_str());
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,332 @@
+// Checks what the audio thread hands to the sound backend: commands in the
+// order they were pushed, listener updates coalesced per batch, and a shutdown
+// that doesn't wait around or touch the backend after the destructor returns.
+// Sound set loader jobs must not touch it after Clear or the destructor either.
+//
+// Builds from this folder. Elsewhere than Windows, tools/Stubs stands in for Windows.h:
+//   g++ -std=c++20 -O2 -I../../TurboFix -I../../thirdparty/ScriptHookV_SDK -I../Stubs -o AudioThreadTest AudioThreadTest.cpp ../../TurboFix/Audio/AudioThread.cpp ../../TurboFix/Audio/SoundSetLoader.cpp ../../TurboFix/Audio/VoicePool.cpp ../../TurboFix/Util/Threads.cpp -pthread
+//   cl /std:c++20 /O2 /EHsc /I..\..\TurboFix /I..\..\thirdparty\ScriptHookV_SDK AudioThreadTest.cpp ..\..\TurboFix\Audio\AudioThread.cpp ..\..\TurboFix\Audio\SoundSetLoader.cpp ..\..\TurboFix\Audio\VoicePool.cpp ..\..\TurboFix\Util\Threads.cpp
+//
+// Exits with 1 when a check fails.
+
+#include "Audio/AudioThread.hpp"
+#include "Audio/SoundSetLoader.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+    // Records every call the audio thread makes, instead of playing anything.
+    // Play of HoldSample blocks until Release, so commands pushed in the
+    // meantime all end up in the next batch.
+    class CCommandLogBackend : public ISoundBackend {
+    public:
+        static constexpr int HoldSample = 99;
+
+        struct SCall {
+            enum class EType {
+                Listener,
+                Play,
+                Stop,
+                AddSample,
+            };
+
+            EType Type;
+            int Sample;
+            float X;
+        };
+
+        const char* Name() const override {
+            return "CommandLog";
+        }
+
+        int LoadSample(const std::string&) override {
+            return 0;
+        }
+
+        int AddSample(const std::string&, const Audio::SPcm&) override {
+            record({ SCall::EType::AddSample, -1, 0.0f });
+            return 0;
+        }
+
+        void SetListener(const Vector3& pos, const Vector3&) override {
+            record({ SCall::EType::Listener, -1, pos.x });
+        }
+
+        uint32_t Play(int sample, const Vector3& pos, float, float) override {
+            if (sample == HoldSample) {
+                std::unique_lock lock(mHoldMutex);
+                mHeld = true;
+                mHoldChanged.notify_all();
+                mHoldChanged.wait(lock, [this]() { return !mHolding; });
+                mHeld = false;
+            }
+            record({ SCall::EType::Play, sample, pos.x });
+            std::lock_guard lock(mCallsMutex);
+            return ++mNextVoice;
+        }
+
+        bool IsPlaying(uint32_t) override {
+            return true;
+        }
+
+        void Stop(uint32_t voice) override {
+            record({ SCall::EType::Stop, static_cast<int>(voice), 0.0f });
+        }
+
+        float MinDistance() const override {
+            return Audio::DefaultMinDistance;
+        }
+
+        // Makes the next Play of HoldSample block.
+        void Hold() {
+            std::lock_guard lock(mHoldMutex);
+            mHolding = true;
+        }
+
+        void WaitUntilHeld() {
+            std::unique_lock lock(mHoldMutex);
+            mHoldChanged.wait(lock, [this]() { return mHeld; });
+        }
+
+        void Release() {
+            std::lock_guard lock(mHoldMutex);
+            mHolding = false;
+            mHoldChanged.notify_all();
+        }
+
+        std::vector<SCall> Calls() {
+            std::lock_guard lock(mCallsMutex);
+            return mCalls;
+        }
+
+        void ClearCalls() {
+            std::lock_guard lock(mCallsMutex);
+            mCalls.clear();
+        }
+
+    private:
+        void record(const SCall& call) {
+            std::lock_guard lock(mCallsMutex);
+            mCalls.push_back(call);
+        }
+
+        std::mutex mCallsMutex;
+        std::vector<SCall> mCalls;
+        uint32_t mNextVoice = 0;
+
+        std::mutex mHoldMutex;
+        std::condition_variable mHoldChanged;
+        bool mHolding = false;
+        bool mHeld = false;
+    };
+
+    using ECall = CCommandLogBackend::SCall::EType;
+
+    constexpr unsigned MaxVoices = 64;
+    constexpr float MaxDistance = 1000.0f;
+
+    int failures = 0;
+
+    void check(bool ok, const char* what) {
+        printf("  [%s] %s\n", ok ? "ok" : "FAIL", what);
+        if (!ok)
+            ++failures;
+    }
+
+    Vector3 at(float x) {
+        Vector3 v{};
+        v.x = x;
+        return v;
+    }
+
+    bool waitForPlayed(CAudioThread& audio, uint64_t played) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (audio.Stats().Played + audio.Stats().Culled < played) {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    std::string describe(const std::vector<CCommandLogBackend::SCall>& calls) {
+        std::string text;
+        for (const auto& call : calls) {
+            char item[32];
+            switch (call.Type) {
+                case ECall::Listener: snprintf(item, sizeof(item), "L%.0f ", call.X); break;
+                case ECall::Play: snprintf(item, sizeof(item), "P%d ", call.Sample); break;
+                case ECall::Stop: snprintf(item, sizeof(item), "S%d ", call.Sample); break;
+                case ECall::AddSample: snprintf(item, sizeof(item), "A "); break;
+            }
+            text += item;
+        }
+        return text;
+    }
+
+    void testOrder() {
+        printf("Play order\n");
+        CCommandLogBackend backend;
+        CAudioThread audio(backend, MaxVoices, MaxDistance);
+
+        constexpr int count = 50;
+        for (int i = 0; i < count; ++i) {
+            audio.Play(i, at(0.0f), 1.0f);
+        }
+        check(waitForPlayed(audio, count), "all plays reached the backend");
+
+        std::vector<int> samples;
+        for (const auto& call : backend.Calls()) {
+            if (call.Type == ECall::Play)
+                samples.push_back(call.Sample);
+        }
+
+        bool inOrder = samples.size() == count;
+        for (int i = 0; inOrder && i < count; ++i) {
+            inOrder = samples[i] == i;
+        }
+        check(inOrder, "plays arrive in the order they were pushed");
+    }
+
+    void testListenerBatching() {
+        printf("Listener batching\n");
+        CCommandLogBackend backend;
+        CAudioThread audio(backend, MaxVoices, MaxDistance);
+
+        // Park the thread in the middle of a batch, then queue up the next one.
+        backend.Hold();
+        audio.Play(CCommandLogBackend::HoldSample, at(0.0f), 1.0f);
+        backend.WaitUntilHeld();
+        backend.ClearCalls();
+
+        audio.SetListener(at(1.0f), {});
+        audio.SetListener(at(2.0f), {});
+        audio.Play(1, at(0.0f), 1.0f);
+        audio.Play(2, at(0.0f), 1.0f);
+        audio.SetListener(at(3.0f), {});
+        audio.SetListener(at(4.0f), {});
+        audio.SetListener(at(5.0f), {});
+        audio.Play(3, at(0.0f), 1.0f);
+        audio.SetListener(at(6.0f), {});
+        audio.SetListener(at(7.0f), {});
+
+        backend.Release();
+        check(waitForPlayed(audio, 4), "all plays reached the backend");
+
+        // The listener for the tail of the batch is applied after the last play.
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (backend.Calls().empty() || backend.Calls().back().Type != ECall::Listener) {
+            if (std::chrono::steady_clock::now() > deadline)
+                break;
+            std::this_thread::yield();
+        }
+
+        auto calls = backend.Calls();
+        std::string got = describe(calls);
+        std::string expected = "P99 L2 P1 P2 L5 P3 L7 ";
+        printf("  got:      %s\n  expected: %s\n", got.c_str(), expected.c_str());
+        check(got == expected, "only the latest listener before each play, and at the end, is applied");
+    }
+
+    void testShutdown() {
+        printf("Shutdown\n");
+        CCommandLogBackend backend;
+        std::optional<CAudioThread> audio;
+        audio.emplace(backend, MaxVoices, MaxDistance);
+        for (int i = 0; i < 10; ++i) {
+            audio->Play(i, at(0.0f), 1.0f);
+        }
+        check(waitForPlayed(*audio, 10), "all plays reached the backend");
+
+        // Queued, but the thread may or may not get to it before stopping.
+        audio->Play(10, at(0.0f), 1.0f);
+
+        auto tStart = std::chrono::steady_clock::now();
+        audio.reset();
+        auto tEnd = std::chrono::steady_clock::now();
+        double destroyMs = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+        size_t callsAtDestruction = backend.Calls().size();
+
+        // Give a thread that's still around the chance to do something it shouldn't.
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        auto calls = backend.Calls();
+        unsigned played = 0;
+        unsigned stopped = 0;
+        for (size_t i = 0; i < callsAtDestruction; ++i) {
+            played += calls[i].Type == ECall::Play ? 1 : 0;
+            stopped += calls[i].Type == ECall::Stop ? 1 : 0;
+        }
+
+        printf("  destructor took %.3f ms\n", destroyMs);
+        check(destroyMs < 50.0, "destructor doesn't wait for a timeout");
+        check(played == stopped, "every voice is stopped by the destructor");
+        check(calls.size() == callsAtDestruction, "no backend calls after the destructor returned");
+    }
+
+    // A job that keeps adding samples until it's told to stop.
+    CSoundSetLoader::LoadFn addSamples(CCommandLogBackend& backend) {
+        return [&backend](SSoundSet&, const CSoundSetLoader::CJob& job) {
+            Audio::SPcm pcm;
+            while (job.Backend([&]() { return backend.AddSample("", pcm); }) >= 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            return false;
+        };
+    }
+
+    bool waitForCalls(CCommandLogBackend& backend, size_t count) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (backend.Calls().size() < count) {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    void testSoundSetLoader() {
+        printf("Sound set loader\n");
+        CCommandLogBackend backend;
+        std::optional<CSoundSetLoader> loader;
+        loader.emplace(2);
+
+        loader->Queue(0, SSoundSet{ "Cleared", 0 }, addSamples(backend));
+        check(waitForCalls(backend, 10), "job adds samples");
+        loader->Clear();
+        size_t callsAtClear = backend.Calls().size();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        check(backend.Calls().size() == callsAtClear, "no backend calls from old jobs after Clear");
+        check(loader->TakeFinished().empty(), "no results from old jobs after Clear");
+
+        loader->Queue(0, SSoundSet{ "Destroyed", 0 }, addSamples(backend));
+        check(waitForCalls(backend, callsAtClear + 10), "job after Clear adds samples");
+
+        auto tStart = std::chrono::steady_clock::now();
+        loader.reset();
+        auto tEnd = std::chrono::steady_clock::now();
+        double destroyMs = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+        size_t callsAtDestruction = backend.Calls().size();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        printf("  destructor took %.3f ms\n", destroyMs);
+        check(destroyMs < 50.0, "destructor doesn't wait for the job to finish");
+        check(backend.Calls().size() == callsAtDestruction, "no backend calls after the destructor returned");
+    }
+}
+
+int main() {
+    testOrder();
+    testListenerBatching();
+    testShutdown();
+    testSoundSetLoader();
+
+    printf("\n%s (%d failed)\n", failures == 0 ? "Passed" : "Failed", failures);
+    return failures == 0 ? 0 : 1;
+}
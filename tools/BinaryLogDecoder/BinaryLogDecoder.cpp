@@ -0,0 +1,226 @@
+// Turns a TurboFix binary log (.blog) back into the text log format.
+//
+// Standalone, so it builds anywhere:
+//   g++ -std=c++17 -O2 -o BinaryLogDecoder BinaryLogDecoder.cpp
+//   cl /std:c++17 /O2 /EHsc BinaryLogDecoder.cpp
+//
+// Usage: BinaryLogDecoder TurboFix.blog [output.log]
+
+#include "../../TurboFix/Util/BinaryLogFormat.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    // Same order as LogLevel in Util/Logger.hpp
+    const char* levelNames[] = { "DEBUG", "INFO", "WARN", "ERROR", "FATAL" };
+
+    struct SFormat {
+        std::string Types;
+        std::string Text;
+    };
+
+    template <typename T>
+    bool readRaw(std::istream& in, T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    struct SArg {
+        char Type;
+        uint64_t Raw;
+        std::string Str;
+    };
+
+    std::vector<SArg> parseArgs(const std::string& types, const std::vector<uint8_t>& data) {
+        std::vector<SArg> args;
+        size_t pos = 0;
+        for (char type : types) {
+            SArg arg{ type, 0, {} };
+            if (type == BinaryLog::ArgString) {
+                if (pos + 1 > data.size())
+                    break;
+                size_t length = data[pos];
+                if (pos + 1 + length > data.size())
+                    break;
+                arg.Str.assign(reinterpret_cast<const char*>(&data[pos + 1]), length);
+                pos += 1 + length;
+            }
+            else {
+                if (pos + 8 > data.size())
+                    break;
+                memcpy(&arg.Raw, &data[pos], 8);
+                pos += 8;
+            }
+            args.push_back(arg);
+        }
+        return args;
+    }
+
+    // Formats one conversion spec (e.g. "%08X") with the stored argument.
+    std::string formatArg(std::string spec, const SArg& arg) {
+        char conversion = spec.back();
+        spec.pop_back();
+        // Drop length modifiers, the argument is always passed as 64 bits below.
+        while (!spec.empty() && strchr("hljztL", spec.back()))
+            spec.pop_back();
+
+        char buf[512];
+        switch (conversion) {
+            case 'd': case 'i': case 'c': {
+                int64_t value = arg.Type == BinaryLog::ArgDouble ? 0 : static_cast<int64_t>(arg.Raw);
+                if (conversion == 'c')
+                    snprintf(buf, sizeof(buf), (spec + "c").c_str(), static_cast<int>(value));
+                else
+                    snprintf(buf, sizeof(buf), (spec + "lld").c_str(), static_cast<long long>(value));
+                break;
+            }
+            case 'u': case 'x': case 'X': case 'o':
+                snprintf(buf, sizeof(buf), (spec + "ll" + conversion).c_str(),
+                    static_cast<unsigned long long>(arg.Raw));
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+                double value;
+                if (arg.Type == BinaryLog::ArgDouble)
+                    memcpy(&value, &arg.Raw, 8);
+                else
+                    value = static_cast<double>(static_cast<int64_t>(arg.Raw));
+                snprintf(buf, sizeof(buf), (spec + conversion).c_str(), value);
+                break;
+            }
+            case 's':
+                if (arg.Type == BinaryLog::ArgString)
+                    snprintf(buf, sizeof(buf), (spec + "s").c_str(), arg.Str.c_str());
+                else
+                    snprintf(buf, sizeof(buf), "0x%llX", static_cast<unsigned long long>(arg.Raw));
+                break;
+            case 'p':
+                snprintf(buf, sizeof(buf), "0x%016llX", static_cast<unsigned long long>(arg.Raw));
+                break;
+            default:
+                return "<?>";
+        }
+        return buf;
+    }
+
+    std::string format(const SFormat& fmt, const std::vector<SArg>& args) {
+        std::string out;
+        size_t argIdx = 0;
+        const std::string& text = fmt.Text;
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (text[i] != '%') {
+                out += text[i];
+                continue;
+            }
+            if (i + 1 < text.size() && text[i + 1] == '%') {
+                out += '%';
+                ++i;
+                continue;
+            }
+
+            size_t end = text.find_first_of("diucxXofFeEgGaAsp", i + 1);
+            if (end == std::string::npos) {
+                out += text.substr(i);
+                break;
+            }
+
+            std::string spec = text.substr(i, end - i + 1);
+            out += argIdx < args.size() ? formatArg(spec, args[argIdx]) : "<?>";
+            ++argIdx;
+            i = end;
+        }
+        return out;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <file.blog> [output.log]\n", argv[0]);
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios_base::binary);
+    if (!in.is_open()) {
+        fprintf(stderr, "Couldn't open [%s]\n", argv[1]);
+        return 1;
+    }
+
+    std::ofstream outFile;
+    if (argc > 2) {
+        outFile.open(argv[2], std::ios_base::out | std::ios_base::trunc);
+        if (!outFile.is_open()) {
+            fprintf(stderr, "Couldn't open [%s]\n", argv[2]);
+            return 1;
+        }
+    }
+    std::ostream& out = argc > 2 ? outFile : std::cout;
+
+    BinaryLog::SFileHeader header;
+    if (!readRaw(in, header) || memcmp(header.Magic, BinaryLog::Magic, sizeof(BinaryLog::Magic)) != 0) {
+        fprintf(stderr, "[%s] is not a TurboFix binary log\n", argv[1]);
+        return 1;
+    }
+    if (header.TickFrequency == 0)
+        header.TickFrequency = 1;
+
+    const double startMs = ((header.Hour * 60.0 + header.Minute) * 60.0 + header.Second) * 1000.0 + header.Milliseconds;
+
+    std::unordered_map<uint16_t, SFormat> formats;
+    uint64_t records = 0;
+    uint64_t unknown = 0;
+
+    BinaryLog::EEntry entry;
+    while (readRaw(in, entry)) {
+        if (entry == BinaryLog::EEntry::Format) {
+            BinaryLog::SFormatHeader formatHeader;
+            if (!readRaw(in, formatHeader))
+                break;
+            SFormat fmt;
+            fmt.Types.resize(formatHeader.ArgCount);
+            fmt.Text.resize(formatHeader.FormatLength);
+            if (!in.read(fmt.Types.data(), fmt.Types.size()) ||
+                !in.read(fmt.Text.data(), fmt.Text.size()))
+                break;
+            formats[formatHeader.Id] = std::move(fmt);
+        }
+        else if (entry == BinaryLog::EEntry::Record) {
+            BinaryLog::SRecordHeader recordHeader;
+            if (!readRaw(in, recordHeader))
+                break;
+            std::vector<uint8_t> data(recordHeader.ArgsSize);
+            if (!in.read(reinterpret_cast<char*>(data.data()), data.size()))
+                break;
+
+            auto it = formats.find(recordHeader.FormatId);
+            if (it == formats.end()) {
+                ++unknown;
+                continue;
+            }
+
+            double elapsedMs = static_cast<double>(static_cast<int64_t>(recordHeader.Ticks - header.StartTicks)) *
+                1000.0 / static_cast<double>(header.TickFrequency);
+            unsigned long long timeMs = static_cast<unsigned long long>(startMs + elapsedMs) % (24ull * 3600 * 1000);
+
+            char prefix[64];
+            snprintf(prefix, sizeof(prefix), "[%02llu:%02llu:%02llu.%03llu] [%s] ",
+                timeMs / 3600000, timeMs / 60000 % 60, timeMs / 1000 % 60, timeMs % 1000,
+                recordHeader.Level < std::size(levelNames) ? levelNames[recordHeader.Level] : "?");
+
+            out << prefix << format(it->second, parseArgs(it->second.Types, data)) << "\n";
+            ++records;
+        }
+        else {
+            fprintf(stderr, "Unknown entry type %u, stopping\n", static_cast<unsigned>(entry));
+            break;
+        }
+    }
+
+    fprintf(stderr, "Decoded %llu records, %llu with an unknown format\n",
+        static_cast<unsigned long long>(records), static_cast<unsigned long long>(unknown));
+    return 0;
+}
@@ -0,0 +1,301 @@
+// Compares what starting the first pop of a sound set costs, before and after
+// sound sets were preloaded:
+// - Path: the file is found, decoded and played on first use, as irrKlang's
+//   play3D(path) did on the script thread.
+// - Preloaded: the sample was decoded when loading, playing it only starts a voice.
+// - Queued: what the script thread pays now, pushing a Play to the audio thread.
+//
+// Path and Preloaded are measured with the recording backend, which decodes
+// with Audio::ReadAudio like the irrKlang backend does. On Windows, irrKlang's
+// own play3D(path) and play3D(source) are measured as well.
+//
+// Needs the stb and dr_libs submodules. From this folder:
+//   g++ -std=c++20 -O2 -I../../TurboFix -I../../thirdparty -I../../thirdparty/ScriptHookV_SDK -I../Stubs -o FirstPopBench FirstPopBench.cpp ../Stubs/Windows.cpp ../../TurboFix/Audio/{AudioThread,Decode,Mix,RecordingBackend,Synth,VoicePool,Wav}.cpp ../../TurboFix/Util/{Logger,String,Threads}.cpp -pthread
+//   cl /std:c++20 /O2 /EHsc /I..\..\TurboFix /I..\..\thirdparty /I..\..\thirdparty\ScriptHookV_SDK /I..\..\thirdparty\irrKlang\include FirstPopBench.cpp ..\..\TurboFix\Audio\AudioThread.cpp ..\..\TurboFix\Audio\Decode.cpp ..\..\TurboFix\Audio\Mix.cpp ..\..\TurboFix\Audio\RecordingBackend.cpp ..\..\TurboFix\Audio\Synth.cpp ..\..\TurboFix\Audio\VoicePool.cpp ..\..\TurboFix\Audio\Wav.cpp ..\..\TurboFix\Util\Logger.cpp ..\..\TurboFix\Util\String.cpp ..\..\TurboFix\Util\Threads.cpp ..\..\thirdparty\irrKlang\lib\Winx64-visualStudio\irrKlang.lib
+//
+// Usage:
+//   FirstPopBench [sound set folder]
+//
+// Without a folder, 16 one-second pops are synthesized and written to
+// FirstPopBench.out first. Those files are in the OS cache then, so Path is a
+// lower bound: a pop read from disk for the first time takes longer.
+//
+// Before measuring, checks that sound sets in other WAV formats than 16-bit PCM
+// still load, and exits with 1 when they don't.
+
+#include "Audio/AudioThread.hpp"
+#include "Audio/Decode.hpp"
+#include "Audio/RecordingBackend.hpp"
+#include "Audio/Synth.hpp"
+#include "Util/String.hpp"
+
+#ifdef _WIN32
+#include <irrKlang.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedUs(Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    }
+
+    struct STimes {
+        std::vector<double> Us;
+
+        void Print(const char* name) {
+            std::sort(Us.begin(), Us.end());
+            double sum = 0.0;
+            for (double us : Us) {
+                sum += us;
+            }
+            printf("  %-22s avg %9.1f us, median %9.1f us, max %9.1f us\n", name,
+                sum / static_cast<double>(Us.size()), Us[Us.size() / 2], Us.back());
+        }
+    };
+
+    std::vector<std::string> findPops(const fs::path& folder) {
+        std::vector<std::string> pops;
+        const auto& extensions = Audio::AudioExtensions();
+        for (const auto& file : fs::directory_iterator(folder)) {
+            std::string extension = Util::to_lower(file.path().extension().string());
+            if (std::find(extensions.begin(), extensions.end(), extension) != extensions.end())
+                pops.push_back(file.path().string());
+        }
+        std::sort(pops.begin(), pops.end());
+        return pops;
+    }
+
+    std::vector<std::string> writePops(const fs::path& folder) {
+        fs::create_directories(folder);
+        Audio::SSynthParams params;
+        params.LengthMs = 1000.0f;
+
+        std::vector<std::string> pops;
+        const auto rendered = Audio::SynthesizePops(params);
+        for (size_t i = 0; i < rendered.size(); ++i) {
+            std::string file = (folder / ("EX_POP_" + std::to_string(i) + ".wav")).string();
+            if (Audio::WriteWav(file, rendered[i]))
+                pops.push_back(file);
+        }
+        return pops;
+    }
+
+    struct SWavFormat {
+        const char* Name;
+        uint16_t Format;
+        uint16_t Bits;
+        bool Extensible;
+        // Largest difference allowed from the 16-bit original.
+        int Tolerance;
+    };
+
+    template <typename T>
+    void put(std::ofstream& out, T value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // Writes pcm in another format than the 16-bit PCM Audio::WriteWav writes.
+    void writeWav(const std::string& file, const Audio::SPcm& pcm, const SWavFormat& format) {
+        std::vector<uint8_t> data;
+        for (int16_t sample : pcm.Samples) {
+            uint8_t bytes[8]{};
+            if (format.Format == 3 && format.Bits == 32) {
+                float value = sample / 32767.0f;
+                memcpy(bytes, &value, sizeof(value));
+            }
+            else if (format.Format == 3) {
+                double value = sample / 32767.0;
+                memcpy(bytes, &value, sizeof(value));
+            }
+            else if (format.Bits == 8) {
+                bytes[0] = static_cast<uint8_t>((sample >> 8) + 128);
+            }
+            else {
+                // The 16 bits go on top, the extra low bytes stay 0.
+                bytes[format.Bits / 8 - 2] = static_cast<uint8_t>(sample & 0xFF);
+                bytes[format.Bits / 8 - 1] = static_cast<uint8_t>((sample >> 8) & 0xFF);
+            }
+            data.insert(data.end(), bytes, bytes + format.Bits / 8);
+        }
+
+        const uint16_t blockAlign = static_cast<uint16_t>(pcm.Channels * format.Bits / 8);
+        const uint32_t fmtSize = format.Extensible ? 40 : 16;
+        std::ofstream out(file, std::ios::binary | std::ios::trunc);
+        out.write("RIFF", 4);
+        put<uint32_t>(out, 4 + 8 + fmtSize + 8 + static_cast<uint32_t>(data.size()));
+        out.write("WAVE", 4);
+        out.write("fmt ", 4);
+        put<uint32_t>(out, fmtSize);
+        put<uint16_t>(out, format.Extensible ? 0xFFFE : format.Format);
+        put<uint16_t>(out, pcm.Channels);
+        put<uint32_t>(out, pcm.SampleRate);
+        put<uint32_t>(out, pcm.SampleRate * blockAlign);
+        put<uint16_t>(out, blockAlign);
+        put<uint16_t>(out, format.Bits);
+        if (format.Extensible) {
+            put<uint16_t>(out, 22);
+            put<uint16_t>(out, format.Bits);
+            put<uint32_t>(out, 0);
+            // Sub format GUID: the format, then the rest of KSDATAFORMAT_SUBTYPE_PCM.
+            const uint8_t guid[14] = { 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 };
+            put<uint16_t>(out, format.Format);
+            out.write(reinterpret_cast<const char*>(guid), sizeof(guid));
+        }
+        out.write("data", 4);
+        put<uint32_t>(out, static_cast<uint32_t>(data.size()));
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    // Sound set packs often come in these. The backends decode them all with ReadAudio.
+    int checkWavFormats(const fs::path& folder) {
+        printf("WAV formats:\n");
+        Audio::SSynthParams params;
+        const Audio::SPcm original = Audio::SynthesizePops(params)[0];
+
+        const SWavFormat formats[] = {
+            { "8-bit PCM", 1, 8, false, 257 },
+            { "24-bit PCM", 1, 24, false, 0 },
+            { "32-bit PCM", 1, 32, false, 0 },
+            { "32-bit float", 3, 32, false, 1 },
+            { "64-bit float", 3, 64, false, 1 },
+            { "24-bit PCM, extensible", 1, 24, true, 0 },
+            { "32-bit float, extensible", 3, 32, true, 1 },
+        };
+
+        int failures = 0;
+        CRecordingBackend backend((folder / "formats.wav").string());
+        for (const auto& format : formats) {
+            const std::string file = (folder / (std::string("format ") + format.Name + ".wav")).string();
+            writeWav(file, original, format);
+
+            Audio::SPcm pcm;
+            bool ok = Audio::ReadAudio(file, pcm) && backend.LoadSample(file) >= 0 &&
+                pcm.Channels == original.Channels && pcm.SampleRate == original.SampleRate &&
+                pcm.Samples.size() == original.Samples.size();
+            for (size_t i = 0; ok && i < pcm.Samples.size(); ++i) {
+                ok = std::abs(pcm.Samples[i] - original.Samples[i]) <= format.Tolerance;
+            }
+            printf("  [%s] %s\n", ok ? "ok" : "FAIL", format.Name);
+            if (!ok)
+                ++failures;
+        }
+        return failures;
+    }
+
+#ifdef _WIN32
+    void benchIrrKlang(const std::vector<std::string>& pops) {
+        printf("irrKlang:\n");
+        const irrklang::vec3df position(0.0f, 0.0f, 0.0f);
+
+        // Before: every backfire played the file by its path.
+        irrklang::ISoundEngine* engine = irrklang::createIrrKlangDevice(irrklang::ESOD_DIRECT_SOUND_8);
+        if (!engine) {
+            printf("  No sound device\n");
+            return;
+        }
+        STimes path;
+        for (const auto& pop : pops) {
+            auto tStart = Clock::now();
+            engine->play3D(pop.c_str(), position);
+            path.Us.push_back(elapsedUs(tStart));
+        }
+        path.Print("play3D(path), first");
+        engine->drop();
+
+        // After: sources are added when loading, and played from memory.
+        engine = irrklang::createIrrKlangDevice(irrklang::ESOD_DIRECT_SOUND_8);
+        std::vector<irrklang::ISoundSource*> sources;
+        for (const auto& pop : pops) {
+            sources.push_back(engine->addSoundSourceFromFile(pop.c_str(), irrklang::ESM_NO_STREAMING, true));
+        }
+        STimes preloaded;
+        for (auto* source : sources) {
+            if (!source)
+                continue;
+            auto tStart = Clock::now();
+            engine->play3D(source, position);
+            preloaded.Us.push_back(elapsedUs(tStart));
+        }
+        preloaded.Print("play3D(source)");
+        engine->drop();
+    }
+#endif
+}
+
+int main(int argc, char** argv) {
+    const fs::path outFolder = fs::absolute("FirstPopBench.out");
+    fs::create_directories(outFolder);
+    if (checkWavFormats(outFolder) > 0) {
+        fprintf(stderr, "Some WAV formats don't load\n");
+        return 1;
+    }
+
+    std::vector<std::string> pops = argc > 1 ? findPops(argv[1]) : writePops(outFolder);
+    if (pops.empty()) {
+        fprintf(stderr, "No sounds found\n");
+        return 1;
+    }
+    printf("%zu sounds\n", pops.size());
+
+    const Vector3 position{};
+    const std::string recording = (outFolder / "recording.wav").string();
+    fs::create_directories(outFolder);
+
+    printf("Recording backend:\n");
+    {
+        // Before: the first play of each file had to find and decode it.
+        CRecordingBackend backend(recording);
+        STimes path;
+        for (const auto& pop : pops) {
+            auto tStart = Clock::now();
+            int sample = backend.LoadSample(pop);
+            backend.Play(sample, position, 1.0f, 1.0f);
+            path.Us.push_back(elapsedUs(tStart));
+        }
+        path.Print("Path, first play");
+
+        // After: LoadSoundSets decoded them all, so only the voice is started.
+        // Samples are looked up by name, so these are the ones decoded above.
+        STimes preloaded;
+        for (const auto& pop : pops) {
+            int sample = backend.LoadSample(pop);
+            auto tStart = Clock::now();
+            backend.Play(sample, position, 1.0f, 1.0f);
+            preloaded.Us.push_back(elapsedUs(tStart));
+        }
+        preloaded.Print("Preloaded");
+
+        // What runSfx waits for now: the backend call happens on the audio thread.
+        std::vector<int> samples;
+        for (const auto& pop : pops) {
+            samples.push_back(backend.LoadSample(pop));
+        }
+        CAudioThread audio(backend, 64, 1000.0f);
+        STimes queued;
+        for (int sample : samples) {
+            auto tStart = Clock::now();
+            audio.Play(sample, position, 1.0f);
+            queued.Us.push_back(elapsedUs(tStart));
+        }
+        queued.Print("Queued to audio thread");
+    }
+
+#ifdef _WIN32
+    benchIrrKlang(pops);
+#endif
+    return 0;
+}
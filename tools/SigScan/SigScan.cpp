@@ -0,0 +1,176 @@
+// Scans a dumped game image for every signature in TurboFix/Memory/Signatures.hpp,
+// with the same scanner the script uses, and compares reports of two builds.
+//
+// Builds anywhere, from this folder:
+//   g++ -std=c++17 -O2 -I../../TurboFix -o SigScan SigScan.cpp ../../TurboFix/Memory/PatternScan.cpp ../../TurboFix/Util/String.cpp
+//   cl /std:c++17 /O2 /EHsc /I..\..\TurboFix SigScan.cpp ..\..\TurboFix\Memory\PatternScan.cpp ..\..\TurboFix\Util\String.cpp
+//
+// Usage:
+//   SigScan scan <GTA5 dump> [report.txt]
+//   SigScan diff <before.txt> <after.txt>
+//
+// A dump of the loaded image is scanned as is. A PE file in its on-disk layout
+// has its sections mapped first, so offsets are always relative to the image
+// base, same as in the signatures.txt the script writes with [Debug] SignatureReport.
+// Reports from either can be diffed. diff exits with 1 when anything changed.
+
+#include "Memory/PatternScan.hpp"
+#include "Memory/Signatures.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+    template <typename T>
+    T readAt(const std::vector<uint8_t>& data, size_t offset) {
+        T value{};
+        if (offset + sizeof(T) <= data.size())
+            memcpy(&value, &data[offset], sizeof(T));
+        return value;
+    }
+
+    // Returns the image as loaded: sections at their virtual addresses.
+    std::vector<uint8_t> mapImage(std::vector<uint8_t> file, bool& mapped) {
+        mapped = false;
+        if (file.size() < 0x40 || file[0] != 'M' || file[1] != 'Z')
+            return file;
+
+        size_t pe = readAt<uint32_t>(file, 0x3C);
+        if (readAt<uint32_t>(file, pe) != 0x00004550) // "PE\0\0"
+            return file;
+
+        size_t fileHeader = pe + 4;
+        uint16_t numSections = readAt<uint16_t>(file, fileHeader + 2);
+        uint16_t optionalSize = readAt<uint16_t>(file, fileHeader + 16);
+        size_t optional = fileHeader + 20;
+        uint32_t sizeOfImage = readAt<uint32_t>(file, optional + 56);
+        uint32_t sizeOfHeaders = readAt<uint32_t>(file, optional + 60);
+
+        // A dump of the loaded image is already laid out like this.
+        if (file.size() >= sizeOfImage)
+            return file;
+
+        std::vector<uint8_t> image(sizeOfImage);
+        memcpy(image.data(), file.data(), std::min<size_t>(sizeOfHeaders, std::min(file.size(), image.size())));
+
+        size_t sections = optional + optionalSize;
+        for (uint16_t i = 0; i < numSections; ++i) {
+            size_t section = sections + i * 40;
+            uint32_t virtualSize = readAt<uint32_t>(file, section + 8);
+            uint32_t virtualAddress = readAt<uint32_t>(file, section + 12);
+            uint32_t rawSize = readAt<uint32_t>(file, section + 16);
+            uint32_t rawOffset = readAt<uint32_t>(file, section + 20);
+
+            size_t size = std::min(virtualSize ? virtualSize : rawSize, rawSize);
+            if (rawOffset >= file.size() || virtualAddress >= image.size())
+                continue;
+            size = std::min<size_t>({ size, file.size() - rawOffset, image.size() - virtualAddress });
+            memcpy(&image[virtualAddress], &file[rawOffset], size);
+        }
+        mapped = true;
+        return image;
+    }
+
+    void printScan(const char* prefix, const mem::SPatternScan& scan) {
+        char operand[16] = "-";
+        if (scan.HasOperand)
+            snprintf(operand, sizeof(operand), "0x%X", static_cast<uint32_t>(scan.Operand));
+
+        printf("%s%-32s %-10s 0x%08llX %3u  %-10s %8.3f ms\n", prefix, scan.Name.c_str(),
+            scan.Matches == 1 ? "unique" : (scan.Matches == 0 ? "not found" : "ambiguous"),
+            static_cast<unsigned long long>(scan.Offset), scan.Matches, operand, scan.ScanTimeMs);
+    }
+
+    int scan(const char* dumpFile, const char* reportFile) {
+        std::ifstream in(dumpFile, std::ios_base::binary);
+        if (!in.is_open()) {
+            fprintf(stderr, "Couldn't open [%s]\n", dumpFile);
+            return 1;
+        }
+        std::vector<uint8_t> file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        bool mapped;
+        std::vector<uint8_t> image = mapImage(std::move(file), mapped);
+        printf("[%s]: %llu bytes%s\n\n", dumpFile, static_cast<unsigned long long>(image.size()),
+            mapped ? ", sections mapped from the PE file" : "");
+
+        mem::SetScanReport(true);
+        for (const auto& signature : Signatures::All) {
+            mem::FindPattern(image.data(), image.size(), signature);
+        }
+
+        mem::SScanReport report{ dumpFile, mem::GetScanReport() };
+        printf("  %-32s %-10s %-10s %3s  %-10s %11s\n", "Signature", "Result", "Offset", "#", "Operand", "Time");
+        unsigned unique = 0;
+        double totalTimeMs = 0.0;
+        for (const auto& result : report.Scans) {
+            printScan("  ", result);
+            unique += result.Matches == 1 ? 1 : 0;
+            totalTimeMs += result.ScanTimeMs;
+        }
+        // Signatures for other game versions are expected to be missing.
+        printf("\n%u of %llu signatures unique, scanned in %.3f ms\n", unique,
+            static_cast<unsigned long long>(report.Scans.size()), totalTimeMs);
+
+        if (reportFile && !mem::SaveScanReport(reportFile, report)) {
+            fprintf(stderr, "Couldn't write [%s]\n", reportFile);
+            return 1;
+        }
+        return 0;
+    }
+
+    int diff(const char* beforeFile, const char* afterFile) {
+        mem::SScanReport before;
+        mem::SScanReport after;
+        if (!mem::ReadScanReport(beforeFile, before)) {
+            fprintf(stderr, "Couldn't read [%s]\n", beforeFile);
+            return 2;
+        }
+        if (!mem::ReadScanReport(afterFile, after)) {
+            fprintf(stderr, "Couldn't read [%s]\n", afterFile);
+            return 2;
+        }
+
+        printf("Before: %s\nAfter:  %s\n\n", before.Header.c_str(), after.Header.c_str());
+
+        auto changes = mem::DiffScanReports(before, after);
+        for (const auto& change : changes) {
+            switch (change.Kind) {
+                case mem::SScanChange::EKind::Added:
+                    printScan("+ ", change.After);
+                    break;
+                case mem::SScanChange::EKind::Removed:
+                    printScan("- ", change.Before);
+                    break;
+                case mem::SScanChange::EKind::Changed:
+                    printScan("< ", change.Before);
+                    printScan("> ", change.After);
+                    if (change.Before.Pattern != change.After.Pattern)
+                        printf("  Pattern changed: [%s] -> [%s]\n", change.Before.Pattern.c_str(), change.After.Pattern.c_str());
+                    break;
+            }
+        }
+
+        printf("%s%llu change(s)\n", changes.empty() ? "" : "\n", static_cast<unsigned long long>(changes.size()));
+        return changes.empty() ? 0 : 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && strcmp(argv[1], "scan") == 0)
+        return scan(argv[2], argc > 3 ? argv[3] : nullptr);
+
+    if (argc >= 4 && strcmp(argv[1], "diff") == 0)
+        return diff(argv[2], argv[3]);
+
+    fprintf(stderr,
+        "Usage:\n"
+        "  %s scan <GTA5 dump> [report.txt]\n"
+        "  %s diff <before.txt> <after.txt>\n", argv[0], argv[0]);
+    return 2;
+}
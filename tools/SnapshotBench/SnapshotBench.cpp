@@ -0,0 +1,124 @@
+// Compares what reading and writing the per-tick vehicle state costs with many
+// NPCs: one VehicleExtensions getter per field, as updateTurbo did before
+// SVehicleSnapshot, against GetSnapshot and ApplySnapshot. Each vehicle's
+// reads are timed in the Turbo profiler zone, the same zone updateTurbo has,
+// so the numbers line up with the stress test's turbo_us column.
+//
+// Runs on the fake game in tools/Stubs. Its entity lookup is a map rather than
+// the game's pool, so only compare the two paths with each other.
+//
+// Linux and x86-64 only, see tools/StressHarness. From this folder:
+//   g++ -std=c++20 -O2 -fpermissive -DFMT_HEADER_ONLY '-D__declspec(x)=' -I../Stubs -I../Stubs/lowercase -I../../TurboFix -I../../thirdparty/ScriptHookV_SDK -I../../thirdparty -I../../thirdparty/fmt/include -o SnapshotBench SnapshotBench.cpp ../Stubs/Headless.cpp ../Stubs/Windows.cpp ../../TurboFix/Memory/{NativeMemory,PatternScan,VehicleExtensions}.cpp ../../TurboFix/Util/{Logger,Profiler,String,Threads}.cpp -pthread
+
+#include "Headless.hpp"
+
+#include "Memory/NativeMemory.hpp"
+#include "Memory/VehicleExtensions.hpp"
+#include "Util/Profiler.hpp"
+
+#include <inc/enums.h>
+#include <inc/natives.h>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using VExt = VehicleExtensions;
+
+namespace {
+    constexpr std::array<unsigned, 5> steps = { 10, 100, 400, 700, 1024 };
+    constexpr unsigned WarmupFrames = 30;
+    constexpr unsigned Frames = 300;
+
+    enum class EMode {
+        Accessors,
+        Snapshot,
+    };
+
+    // What updateTurbo read and wrote through the getters, with anti-lag on:
+    // the boost, RPM twice, throttle, gear, and the throttle pedal twice in a row.
+    float tickAccessors(Vehicle vehicle) {
+        PROFILE_ZONE(Turbo);
+        float boost = VExt::GetTurbo(vehicle);
+        float rpm = VExt::GetCurrentRPM(vehicle);
+        float throttle = VExt::GetThrottle(vehicle);
+        uint16_t gear = VExt::GetGearCurr(vehicle);
+        float throttleP = VExt::GetThrottleP(vehicle);
+        if (std::abs(VExt::GetThrottleP(vehicle)) < 0.1f && VExt::GetCurrentRPM(vehicle) > 0.5f)
+            boost += 0.01f;
+
+        boost = boost * 0.9f + rpm * throttle * 0.1f + throttleP * 0.01f * gear;
+        VExt::SetTurbo(vehicle, boost);
+        return boost;
+    }
+
+    float tickSnapshot(Vehicle vehicle) {
+        PROFILE_ZONE(Turbo);
+        const SVehicleSnapshot original = VExt::GetSnapshot(vehicle);
+        SVehicleSnapshot snapshot = original;
+        if (std::abs(snapshot.ThrottleP) < 0.1f && snapshot.RPM > 0.5f)
+            snapshot.Turbo += 0.01f;
+
+        snapshot.Turbo = snapshot.Turbo * 0.9f + snapshot.RPM * snapshot.Throttle * 0.1f +
+            snapshot.ThrottleP * 0.01f * snapshot.GearCurr;
+        VExt::ApplySnapshot(original, snapshot);
+        return snapshot.Turbo;
+    }
+
+    // Per frame, all vehicles: the Turbo zone's total, and its p50/p95 per vehicle.
+    struct SResult {
+        double FrameUs;
+        double P50Us;
+        double P95Us;
+    };
+
+    SResult run(EMode mode, const std::vector<Vehicle>& vehicles) {
+        // Keeps the compiler from dropping the reads.
+        volatile float sink = 0.0f;
+        for (unsigned frame = 0; frame < WarmupFrames + Frames; ++frame) {
+            if (frame == WarmupFrames)
+                Profiler::Reset();
+            for (Vehicle vehicle : vehicles) {
+                sink = mode == EMode::Accessors ? tickAccessors(vehicle) : tickSnapshot(vehicle);
+            }
+        }
+        (void)sink;
+
+        auto stats = Profiler::Stats(Profiler::EZone::Turbo);
+        return { stats.TotalUs / Frames, stats.P50Us, stats.P95Us };
+    }
+}
+
+int main() {
+    if (!Profiler::Enabled) {
+        fprintf(stderr, "Build with TF_PROFILER=1\n");
+        return 1;
+    }
+
+    Headless::Init({});
+    VExt::Init();
+    VExt::ResolveOffsets();
+    mem::GetAddressOfEntity = Headless::GetAddressOfEntity;
+
+    Hash model = MISC::GET_HASH_KEY("sultan");
+    std::vector<Vehicle> vehicles;
+
+    printf("%8s  %26s  %26s  %7s\n", "Vehicles", "Accessors us/frame (p95)", "Snapshot us/frame (p95)", "Ratio");
+    for (unsigned target : steps) {
+        while (vehicles.size() < target) {
+            Vector3 position{ static_cast<float>(vehicles.size() % 32) * 6.0f, static_cast<float>(vehicles.size() / 32) * 6.0f, 0.0f };
+            Vehicle vehicle = VEHICLE::CREATE_VEHICLE(model, position, 0.0f, false, true, false);
+            VExt::SetCurrentRPM(vehicle, 0.3f + 0.6f * static_cast<float>(vehicles.size() % 10) / 10.0f);
+            VExt::SetThrottle(vehicle, static_cast<float>(vehicles.size() % 2));
+            VExt::SetThrottleP(vehicle, static_cast<float>(vehicles.size() % 2));
+            vehicles.push_back(vehicle);
+        }
+
+        SResult accessors = run(EMode::Accessors, vehicles);
+        SResult snapshot = run(EMode::Snapshot, vehicles);
+        printf("%8u  %16.1f (%6.3f)  %16.1f (%6.3f)  %6.2fx\n", target,
+            accessors.FrameUs, accessors.P95Us, snapshot.FrameUs, snapshot.P95Us,
+            snapshot.FrameUs > 0.0 ? accessors.FrameUs / snapshot.FrameUs : 0.0);
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+// Runs the NPC stress test (TurboFix/StressTest.hpp) without the game, on the
+// fake one in tools/Stubs, and checks that the only vehicles that die are the
+// ones the test blows up itself, and that what it counts matches the world.
+// turbo_flame isn't installed in the fake game, like in many real ones.
+//
+// Linux and x86-64 only. Needs the fmt, simpleini, stb and dr_libs submodules. -fpermissive is
+// for what only MSVC accepts in Memory/Offsets.hpp. From this folder:
+//   g++ -std=c++20 -O2 -fpermissive -DFMT_HEADER_ONLY '-D__declspec(x)=' -I../Stubs -I../Stubs/lowercase -I../../TurboFix -I../../thirdparty/ScriptHookV_SDK -I../../thirdparty -I../../thirdparty/fmt/include -o StressHarness StressHarness.cpp ../Stubs/Headless.cpp ../Stubs/HeadlessScript.cpp ../Stubs/Windows.cpp ../../TurboFix/{Script,TurboScript,TurboScriptNPC,StressTest,Config,ScriptSettings,Compatibility}.cpp ../../TurboFix/Audio/{AudioThread,Decode,Mix,RecordingBackend,SoundSetLoader,Synth,VoicePool,Wav}.cpp ../../TurboFix/Memory/{NativeMemory,PatternScan,Patches,VehicleExtensions}.cpp ../../TurboFix/Ptfx/*.cpp ../../TurboFix/Util/{AddonSpawnerCache,AllocTracker,BinaryLog,Logger,Paths,Profiler,String,Threads,UI}.cpp -pthread
+//
+// Usage:
+//   StressHarness [work folder]
+//
+// The script's files, its log and the stress test CSV end up in the work folder
+// (default StressHarness.out). Exits with 1 when a check fails.
+
+#include "Headless.hpp"
+
+#include "Script.hpp"
+#include "StressTest.hpp"
+#include "Memory/NativeMemory.hpp"
+#include "Memory/Patches.h"
+#include "Util/Logger.hpp"
+#include "Util/Paths.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const char* what) {
+        printf("  [%s] %s\n", ok ? "ok" : "FAIL", what);
+        if (!ok)
+            ++failures;
+    }
+
+    void writeFile(const std::string& file, const char* text) {
+        std::ofstream out(file, std::ofstream::out | std::ofstream::trunc);
+        out << text;
+    }
+
+    // Every vehicle gets the default config, with anti-lag and a synthesized sound set.
+    void writeModFiles() {
+        fs::create_directories(Headless::ModPath("\\Configs"));
+        fs::create_directories(fs::path(Headless::ModPath("\\Sounds")) / "Synth");
+
+        writeFile(Headless::ModPath("\\settings_general.ini"),
+            "[Audio]\n"
+            "Backend = Null\n"
+            "[Debug]\n"
+            "SignatureReport = true\n");
+
+        writeFile(Headless::ModPath("\\Configs") + "/Default.ini",
+            "[AntiLag]\n"
+            "Enable = true\n"
+            "Effects = true\n"
+            "SoundSet = Synth\n");
+
+        writeFile((fs::path(Headless::ModPath("\\Sounds")) / "Synth" / "SoundSet.ini").string(),
+            "[SoundSet]\n"
+            "Type = Synth\n");
+    }
+
+    unsigned aliveVehicles() {
+        auto world = Headless::WorldStats();
+        return world.Vehicles - world.DeadVehicles;
+    }
+}
+
+int main(int argc, char** argv) {
+    const fs::path workFolder = fs::absolute(argc > 1 ? argv[1] : "StressHarness.out");
+    fs::create_directories(workFolder);
+
+    Headless::SOptions options;
+    options.Folder = (workFolder / "game").string();
+    options.MissingPtfxAssets = { "turbo_flame" };
+    Headless::Init(options);
+    writeModFiles();
+
+    // What DllMain does.
+    logger.SetFile(Headless::ModPath("\\TurboFix.log"));
+    logger.SetMinLevel(DEBUG);
+    logger.Clear();
+    Paths::SetOurModuleHandle(Headless::ScriptModule());
+    Patches::SetPatterns();
+
+    TurboFix::ScriptInit();
+    mem::GetAddressOfEntity = Headless::GetAddressOfEntity;
+
+    StressTest::Start(Headless::ModPath("\\stress.csv"));
+    if (!StressTest::Status().Running) {
+        fprintf(stderr, "Stress test didn't start, see [%s]\n", Headless::ModPath("\\TurboFix.log").c_str());
+        return 1;
+    }
+
+    unsigned mismatchFrames = 0;
+    unsigned lastStep = 0;
+    auto tStart = std::chrono::steady_clock::now();
+    Headless::OnFrame([&]() {
+        auto status = StressTest::Status();
+        if (!status.Running)
+            throw Headless::SStop{};
+
+        // Vehicles killed by something else are only noticed in the next Update.
+        if (status.Vehicles != aliveVehicles())
+            ++mismatchFrames;
+
+        if (status.Step != lastStep) {
+            lastStep = status.Step;
+            printf("  Step %u of %u: %u vehicles, %llu instances\n", status.Step, status.Steps,
+                status.Vehicles, static_cast<unsigned long long>(TurboFix::GetNPCScriptCount()));
+        }
+    });
+
+    printf("Stress test\n");
+    try {
+        TurboFix::ScriptTick();
+    }
+    catch (const Headless::SStop&) {
+    }
+    auto tEnd = std::chrono::steady_clock::now();
+
+    auto status = StressTest::Status();
+    auto world = Headless::WorldStats();
+    printf("  %llu frames in %.1f s, %llu natives (%llu unknown), %u explosions, %llu effects\n",
+        static_cast<unsigned long long>(world.Frames),
+        std::chrono::duration<double>(tEnd - tStart).count(),
+        static_cast<unsigned long long>(world.NativeCalls),
+        static_cast<unsigned long long>(world.UnknownNativeCalls),
+        world.Explosions,
+        static_cast<unsigned long long>(world.PtfxStarted + world.PtfxLoopedStarted));
+
+    check(status.Step == status.Steps, "all steps ran");
+    check(world.Explosions > 0, "vehicles were blown up");
+    check(world.CollateralKills == 0, "explosions didn't kill other vehicles");
+    check(status.Lost == 0, "no vehicles lost outside of churn");
+    check(mismatchFrames == 0, "live vehicle count matches the world every frame");
+    check(world.PtfxStarted > 0, "anti-lag effects played");
+    check(world.PtfxAssetChecks < world.Frames / 2, "the missing ptfx asset isn't polled every frame");
+    // Delayed flames of vehicles deleted in the meantime are counted, but never started.
+    const uint64_t ptfxCounted = TurboFix::GetParticleBudget().Stats().Spawned;
+    const uint64_t ptfxStarted = world.PtfxStarted + world.PtfxLoopedStarted;
+    printf("  %llu effects counted by the budget, %llu started\n",
+        static_cast<unsigned long long>(ptfxCounted), static_cast<unsigned long long>(ptfxStarted));
+    check(ptfxStarted <= ptfxCounted && ptfxStarted >= ptfxCounted * 95 / 100, "the ptfx budget counts effects, not exhausts");
+    check(world.Vehicles == 0, "all vehicles deleted afterwards");
+
+    printf("\n%s (%d failed), log and CSV in [%s]\n", failures == 0 ? "Passed" : "Failed", failures,
+        workFolder.string().c_str());
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+#pragma once
+// The bits of DirectXMath the script uses, in plain scalar code. Same layout
+// as the real thing, so the fake CVehicle::GetExhaust can fill in an XMMATRIX.
+
+namespace DirectX {
+    struct alignas(16) XMVECTOR {
+        float f[4];
+    };
+
+    using FXMVECTOR = const XMVECTOR&;
+
+    struct alignas(16) XMMATRIX {
+        XMVECTOR r[4];
+    };
+
+    struct alignas(16) XMVECTORF32 {
+        union {
+            float f[4];
+            XMVECTOR v;
+        };
+
+        operator XMVECTOR() const {
+            return v;
+        }
+    };
+
+    inline XMVECTOR XMVectorZero() {
+        return {};
+    }
+
+    inline bool XMVector3NotEqual(FXMVECTOR a, FXMVECTOR b) {
+        return a.f[0] != b.f[0] || a.f[1] != b.f[1] || a.f[2] != b.f[2];
+    }
+
+    inline XMVECTOR XMVectorAdd(FXMVECTOR a, FXMVECTOR b) {
+        return { { a.f[0] + b.f[0], a.f[1] + b.f[1], a.f[2] + b.f[2], a.f[3] + b.f[3] } };
+    }
+
+    inline XMVECTOR XMVectorScale(FXMVECTOR v, float scale) {
+        return { { v.f[0] * scale, v.f[1] * scale, v.f[2] * scale, v.f[3] * scale } };
+    }
+}
@@ -0,0 +1,619 @@
+#include "Headless.hpp"
+
+#include "../../TurboFix/Memory/Signatures.hpp"
+
+#include <inc/main.h>
+#include <inc/types.h>
+#include <DirectXMath.h>
+#include <Psapi.h>
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+namespace {
+    // G_VER_1_0_2802_0 in Memory/Versions.hpp, so only the newest signature
+    // variants are needed. Read during static initialization, so it's fixed.
+    constexpr int GameVersion = 80;
+
+    constexpr float FrameTime = 1.0f / 60.0f;
+
+    constexpr Ped PlayerPed = 1;
+    constexpr Vehicle FirstVehicle = 0x100;
+
+    // Exhaust bones 56 (exhaust) and 57 (exhaust_2), at these bone indices.
+    constexpr int ExhaustBoneIndex = 20;
+    constexpr unsigned ExhaustCount = 2;
+
+    // Fake CVehicle, and what it points to. Offsets are what's planted in the image.
+    constexpr size_t VehicleSize = 0x1000;
+    constexpr size_t ModelInfoSize = 0x1000;
+    constexpr size_t HandlingSize = 0x400;
+    constexpr size_t WheelSize = 0x400;
+    constexpr unsigned WheelCount = 4;
+
+    constexpr int ModelInfoOffset = 0x20;
+    constexpr int HandlingOffset = 0x9C0;
+    constexpr int WheelsOffset = 0xA08;
+
+    struct SPlant {
+        const Signatures::SSignature& Signature;
+        // Written at the signature's operand.
+        int Operand;
+        // Where the function starts relative to the match, when it's called.
+        int Function;
+    };
+
+    constexpr int NoFunction = INT32_MIN;
+
+    const SPlant plants[] = {
+        { Signatures::GetAddressOfEntity, 0, NoFunction },
+        { Signatures::GetModelInfo58, 0, NoFunction },
+        { Signatures::GetExhaust, 0, -0x39 },
+        { Signatures::BoostLimiter, 0, NoFunction },
+        { Signatures::HoverTransform, 0x970, NoFunction },
+        { Signatures::Gear, 0x880, NoFunction },
+        { Signatures::RPM, 0x8C0, NoFunction },
+        { Signatures::Steering, 0x930, NoFunction },
+        { Signatures::Wheels, WheelsOffset, NoFunction },
+        { Signatures::WheelFlags, 0x1C0, NoFunction },
+        { Signatures::WheelCompression, 0x160, NoFunction },
+        { Signatures::WheelSteering1737, 0x1A0, NoFunction },
+        { Signatures::RocketBoostActive, 0x9A0, NoFunction },
+        { Signatures::RocketBoostCharge, 0x9A4, NoFunction },
+        { Signatures::FuelLevel, 0x960, NoFunction },
+        { Signatures::DriveForce1604, 0x8E0, NoFunction },
+        { Signatures::Turbo1604, 0x8F0, NoFunction },
+        { Signatures::Handling, HandlingOffset, NoFunction },
+        { Signatures::LightStates, 0x9D1, NoFunction },
+        { Signatures::Handbrake2060, 0x950, NoFunction },
+        { Signatures::DirtLevel, 0x9B0, NoFunction },
+        { Signatures::EngineTemp, 0x9B4, NoFunction },
+        { Signatures::DashSpeed, 0x9B8, NoFunction },
+        { Signatures::ModelType, 0x9D8, NoFunction },
+        { Signatures::VehicleFlags, 0x9E0, NoFunction },
+        { Signatures::SteeringMult, 0x9F0, NoFunction },
+        { Signatures::WheelHealth, 0x1E0, NoFunction },
+    };
+
+    constexpr size_t ImageBytes = 0x10000;
+    constexpr size_t SlotSize = 0x100;
+    // Room for operands and functions before the match.
+    constexpr size_t SlotMatch = 0x80;
+
+    struct SVehicle {
+        Hash Model;
+        Vector3 Position;
+        bool Dead;
+        bool Turbo;
+        bool EngineOn;
+        std::unique_ptr<uint8_t[]> Memory;
+        std::unique_ptr<uint8_t[]> ModelInfo;
+        std::unique_ptr<uint8_t[]> Handling;
+        std::vector<std::unique_ptr<uint8_t[]>> Wheels;
+        std::array<uint64_t, WheelCount> WheelPtrs;
+    };
+
+    Headless::SOptions options;
+    uint8_t* image = nullptr;
+    std::function<void()> onFrame;
+
+    std::map<int, SVehicle> vehicles;
+    // CVehicle address -> handle, for GetExhaust.
+    std::map<uintptr_t, int> vehicleAddresses;
+    int nextVehicle = FirstVehicle;
+    int nextLoopedPtfx = 1;
+    Headless::SWorldStats stats{};
+
+    uint64_t args[32];
+    unsigned argCount = 0;
+    uint64_t nativeHash = 0;
+    alignas(16) uint64_t result[4];
+
+    uint8_t* allocZeroed(size_t size) {
+        auto* memory = new uint8_t[size];
+        memset(memory, 0, size);
+        return memory;
+    }
+
+    struct SPattern {
+        std::vector<uint8_t> Bytes;
+        std::vector<bool> Compare;
+    };
+
+    SPattern parse(const Signatures::SSignature& signature) {
+        SPattern pattern;
+        if (signature.Mask) {
+            for (size_t i = 0; signature.Mask[i]; ++i) {
+                pattern.Bytes.push_back(static_cast<uint8_t>(signature.Pattern[i]));
+                pattern.Compare.push_back(signature.Mask[i] != '?');
+            }
+            return pattern;
+        }
+
+        std::istringstream text(signature.Pattern);
+        for (std::string byte; text >> byte;) {
+            bool wildcard = byte[0] == '?';
+            pattern.Bytes.push_back(wildcard ? 0 : static_cast<uint8_t>(strtoul(byte.c_str(), nullptr, 16)));
+            pattern.Compare.push_back(!wildcard);
+        }
+        return pattern;
+    }
+
+    // movabs rax, target; jmp rax
+    void writeJump(uint8_t* at, const void* target) {
+        uint64_t address = reinterpret_cast<uint64_t>(target);
+        at[0] = 0x48;
+        at[1] = 0xB8;
+        memcpy(at + 2, &address, sizeof(address));
+        at[10] = 0xFF;
+        at[11] = 0xE0;
+    }
+
+    void getExhaust(void* vehicle, uint32_t exhaustBoneId, DirectX::XMMATRIX& outTransform, uint32_t& outId);
+
+    void plant(uint8_t* slot, const SPlant& entry) {
+        const auto& signature = entry.Signature;
+        SPattern pattern = parse(signature);
+        uint8_t* match = slot + SlotMatch;
+        memcpy(match, pattern.Bytes.data(), pattern.Bytes.size());
+
+        if (signature.Operand != Signatures::NoOperand) {
+            uint8_t operand[sizeof(int32_t)];
+            memcpy(operand, &entry.Operand, sizeof(operand));
+            for (size_t i = 0; i < sizeof(operand); ++i) {
+                ptrdiff_t at = signature.Operand + static_cast<ptrdiff_t>(i);
+                // The operand can't be anything the pattern itself fixes.
+                if (at >= 0 && static_cast<size_t>(at) < pattern.Bytes.size() &&
+                    pattern.Compare[at] && pattern.Bytes[at] != operand[i]) {
+                    fprintf(stderr, "[Headless] 0x%X doesn't fit the operand of [%s]\n", entry.Operand, signature.Name);
+                    abort();
+                }
+                match[at] = operand[i];
+            }
+        }
+
+        if (entry.Function != NoFunction)
+            writeJump(match + entry.Function, reinterpret_cast<const void*>(&getExhaust));
+    }
+
+    SVehicle* findVehicle(int handle) {
+        auto it = vehicles.find(handle);
+        return it == vehicles.end() ? nullptr : &it->second;
+    }
+
+    bool exists(int handle) {
+        return handle == PlayerPed || findVehicle(handle) != nullptr;
+    }
+
+    bool isDead(int handle) {
+        SVehicle* vehicle = findVehicle(handle);
+        return vehicle && vehicle->Dead;
+    }
+
+    Vector3 position(int handle) {
+        SVehicle* vehicle = findVehicle(handle);
+        return vehicle ? vehicle->Position : Vector3{};
+    }
+
+    float distance(const Vector3& a, const Vector3& b) {
+        float x = a.x - b.x;
+        float y = a.y - b.y;
+        float z = a.z - b.z;
+        return std::sqrt(x * x + y * y + z * z);
+    }
+
+    void getExhaust(void* address, uint32_t exhaustBoneId, DirectX::XMMATRIX& outTransform, uint32_t& outId) {
+        outTransform = {};
+        outId = 0;
+
+        auto it = vehicleAddresses.find(reinterpret_cast<uintptr_t>(address));
+        uint32_t exhaust = exhaustBoneId - 56;
+        if (it == vehicleAddresses.end() || exhaust >= ExhaustCount)
+            return;
+
+        const Vector3& pos = vehicles.at(it->second).Position;
+        float side = exhaust == 0 ? -0.4f : 0.4f;
+        outTransform.r[0] = { { 1.0f, 0.0f, 0.0f, 0.0f } };
+        outTransform.r[1] = { { 0.0f, 1.0f, 0.0f, 0.0f } };
+        outTransform.r[2] = { { 0.0f, 0.0f, 1.0f, 0.0f } };
+        outTransform.r[3] = { { pos.x + side, pos.y - 2.2f, pos.z + 0.3f, 1.0f } };
+        outId = ExhaustBoneIndex + exhaust;
+    }
+
+    int createVehicle(Hash model, const Vector3& pos) {
+        if (vehicles.size() >= options.MaxVehicles)
+            return 0;
+
+        SVehicle vehicle{};
+        vehicle.Model = model;
+        vehicle.Position = pos;
+        vehicle.Memory.reset(allocZeroed(VehicleSize));
+        vehicle.ModelInfo.reset(allocZeroed(ModelInfoSize));
+        vehicle.Handling.reset(allocZeroed(HandlingSize));
+        for (unsigned i = 0; i < WheelCount; ++i) {
+            vehicle.Wheels.emplace_back(allocZeroed(WheelSize));
+            vehicle.WheelPtrs[i] = reinterpret_cast<uint64_t>(vehicle.Wheels.back().get());
+        }
+
+        uint8_t* memory = vehicle.Memory.get();
+        uint64_t modelInfo = reinterpret_cast<uint64_t>(vehicle.ModelInfo.get());
+        uint64_t handling = reinterpret_cast<uint64_t>(vehicle.Handling.get());
+        uint64_t wheels = reinterpret_cast<uint64_t>(vehicle.WheelPtrs.data());
+        uint32_t wheelCount = WheelCount;
+        memcpy(memory + ModelInfoOffset, &modelInfo, sizeof(modelInfo));
+        memcpy(memory + HandlingOffset, &handling, sizeof(handling));
+        memcpy(memory + WheelsOffset - 8, &wheels, sizeof(wheels));
+        memcpy(memory + WheelsOffset, &wheelCount, sizeof(wheelCount));
+
+        int handle = nextVehicle++;
+        vehicleAddresses[reinterpret_cast<uintptr_t>(memory)] = handle;
+        vehicles.emplace(handle, std::move(vehicle));
+        return handle;
+    }
+
+    void deleteVehicle(int handle) {
+        SVehicle* vehicle = findVehicle(handle);
+        if (!vehicle)
+            return;
+        vehicleAddresses.erase(reinterpret_cast<uintptr_t>(vehicle->Memory.get()));
+        vehicles.erase(handle);
+    }
+
+    void explodeVehicle(int handle) {
+        SVehicle* vehicle = findVehicle(handle);
+        if (!vehicle)
+            return;
+
+        vehicle->Dead = true;
+        ++stats.Explosions;
+        for (auto& [otherHandle, other] : vehicles) {
+            if (otherHandle == handle || other.Dead)
+                continue;
+            if (distance(other.Position, vehicle->Position) < options.BlastRadius) {
+                other.Dead = true;
+                ++stats.CollateralKills;
+            }
+        }
+    }
+
+    // GET_HASH_KEY: Jenkins one-at-a-time, case insensitive.
+    Hash joaat(const char* text) {
+        Hash hash = 0;
+        for (; text && *text; ++text) {
+            hash += static_cast<uint8_t>(tolower(static_cast<unsigned char>(*text)));
+            hash += hash << 10;
+            hash ^= hash >> 6;
+        }
+        hash += hash << 3;
+        hash ^= hash >> 11;
+        hash += hash << 15;
+        return hash;
+    }
+
+    int argInt(unsigned i) {
+        return static_cast<int>(args[i]);
+    }
+
+    float argFloat(unsigned i) {
+        float value;
+        uint32_t bits = static_cast<uint32_t>(args[i]);
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    template <typename T>
+    T* argPtr(unsigned i) {
+        return reinterpret_cast<T*>(args[i]);
+    }
+
+    Vector3 argVector3(unsigned i) {
+        return { argFloat(i), argFloat(i + 1), argFloat(i + 2) };
+    }
+
+    void returnInt(int value) {
+        result[0] = static_cast<uint32_t>(value);
+    }
+
+    void returnFloat(float value) {
+        memcpy(&result[0], &value, sizeof(value));
+    }
+
+    void returnPtr(const void* value) {
+        result[0] = reinterpret_cast<uint64_t>(value);
+    }
+
+    void returnVector3(const Vector3& value) {
+        static_assert(sizeof(Vector3) <= sizeof(result));
+        memcpy(result, &value, sizeof(value));
+    }
+
+    void call(uint64_t hash) {
+        switch (hash) {
+            // MISC
+            case 0x9CD27B0045628463: // GET_GAME_TIMER
+                returnInt(static_cast<int>(stats.Frames * 1000 / 60));
+                break;
+            case 0x15C40837039FFAF7: // GET_FRAME_TIME
+                returnFloat(FrameTime);
+                break;
+            case 0xD24D37CC275948CC: // GET_HASH_KEY
+                returnInt(static_cast<int>(joaat(argPtr<const char>(0))));
+                break;
+
+            // PLAYER, PED: on foot, not in anything.
+            case 0xD80958FC74E988A6: // PLAYER_PED_ID
+                returnInt(PlayerPed);
+                break;
+            case 0x9A9112A0FE9A4713: // GET_VEHICLE_PED_IS_IN
+            case 0xA3EE4A07279BB9DB: // IS_PED_IN_VEHICLE
+            case 0xBB40DD2270B65366: // GET_PED_IN_VEHICLE_SEAT
+                returnInt(0);
+                break;
+
+            // CAM: at the player.
+            case 0xA200EB1EE790F448: // GET_FINAL_RENDERED_CAM_COORD
+            case 0x5B4E4C817FCC2DFB: // GET_FINAL_RENDERED_CAM_ROT
+                returnVector3({});
+                break;
+
+            // ENTITY
+            case 0x7239B21A38F536BA: // DOES_ENTITY_EXIST
+                returnInt(exists(argInt(0)));
+                break;
+            case 0x5F9532F3B5CC2551: // IS_ENTITY_DEAD
+                returnInt(isDead(argInt(0)));
+                break;
+            case 0x3FEF770D40960D5A: // GET_ENTITY_COORDS
+                returnVector3(position(argInt(0)));
+                break;
+            case 0x06843DA7060A026B: // SET_ENTITY_COORDS
+                if (SVehicle* vehicle = findVehicle(argInt(0)))
+                    vehicle->Position = argVector3(1);
+                break;
+            case 0x9F47B058362C84B5: { // GET_ENTITY_MODEL
+                SVehicle* vehicle = findVehicle(argInt(0));
+                returnInt(vehicle ? static_cast<int>(vehicle->Model) : 0);
+                break;
+            }
+            case 0xE659E47AF827484B: // IS_ENTITY_ON_SCREEN
+                returnInt(exists(argInt(0)));
+                break;
+            case 0x2274BC1C4885E333: { // GET_OFFSET_FROM_ENTITY_GIVEN_WORLD_COORDS, never rotated
+                Vector3 world = argVector3(1);
+                Vector3 pos = position(argInt(0));
+                returnVector3({ world.x - pos.x, world.y - pos.y, world.z - pos.z });
+                break;
+            }
+            case 0xFB71170B7E76ACBA: { // GET_ENTITY_BONE_INDEX_BY_NAME
+                std::string bone = argPtr<const char>(1);
+                int index = -1;
+                if (bone == "exhaust")
+                    index = ExhaustBoneIndex;
+                else if (bone == "exhaust_2")
+                    index = ExhaustBoneIndex + 1;
+                returnInt(index);
+                break;
+            }
+            case 0x44A8FCB8ED227738: // GET_WORLD_POSITION_OF_ENTITY_BONE
+                returnVector3(position(argInt(0)));
+                break;
+            case 0xBD8D32550E5CEBFE: // GET_ENTITY_BONE_OBJECT_ROTATION
+                returnVector3({});
+                break;
+
+            // VEHICLE
+            case 0xAF35D0D2583051B0: // CREATE_VEHICLE
+                returnInt(createVehicle(static_cast<Hash>(args[0]), argVector3(1)));
+                break;
+            case 0xEA386986E786A54F: { // DELETE_VEHICLE
+                auto* handle = argPtr<Vehicle>(0);
+                deleteVehicle(*handle);
+                *handle = 0;
+                break;
+            }
+            case 0xBA71116ADF5B514C: // EXPLODE_VEHICLE
+                explodeVehicle(argInt(0));
+                break;
+            case 0x84B233A8C8FC8AE7: { // IS_TOGGLE_MOD_ON
+                SVehicle* vehicle = findVehicle(argInt(0));
+                returnInt(vehicle && argInt(1) == 18 && vehicle->Turbo);
+                break;
+            }
+            case 0x2A1F4F37F95BAD08: // TOGGLE_VEHICLE_MOD
+                if (SVehicle* vehicle = findVehicle(argInt(0)); vehicle && argInt(1) == 18)
+                    vehicle->Turbo = argInt(2) != 0;
+                break;
+            case 0x772960298DA26FDB: // GET_VEHICLE_MOD, all stock
+                returnInt(-1);
+                break;
+            case 0x2497C4717C8B881E: // SET_VEHICLE_ENGINE_ON
+                if (SVehicle* vehicle = findVehicle(argInt(0)))
+                    vehicle->EngineOn = argInt(1) != 0;
+                break;
+            case 0xAE31E7DF9B5B132E: { // GET_IS_VEHICLE_ENGINE_RUNNING
+                SVehicle* vehicle = findVehicle(argInt(0));
+                returnInt(vehicle && vehicle->EngineOn && !vehicle->Dead);
+                break;
+            }
+            case 0x7CE1CCB9B293020E: // GET_VEHICLE_NUMBER_PLATE_TEXT
+                returnPtr("HEADLESS");
+                break;
+
+            // STREAMING: everything is loaded, except the missing ptfx assets.
+            case 0x98A4EB5D89A0C952: // HAS_MODEL_LOADED
+                returnInt(1);
+                break;
+            case 0x8702416E512EC454: { // HAS_NAMED_PTFX_ASSET_LOADED
+                ++stats.PtfxAssetChecks;
+                const auto& missing = options.MissingPtfxAssets;
+                returnInt(std::find(missing.begin(), missing.end(), argPtr<const char>(0)) == missing.end());
+                break;
+            }
+
+            // GRAPHICS
+            case 0x0D53A3B8DA0809D2: // START_PARTICLE_FX_NON_LOOPED_ON_ENTITY
+                ++stats.PtfxStarted;
+                returnInt(1);
+                break;
+            case 0x1AE42C1660FD6517: // START_PARTICLE_FX_LOOPED_ON_ENTITY
+                ++stats.PtfxLoopedStarted;
+                returnInt(nextLoopedPtfx++);
+                break;
+            case 0x8F75998877616996: // STOP_PARTICLE_FX_LOOPED
+                ++stats.PtfxLoopedStopped;
+                break;
+
+            default:
+                ++stats.UnknownNativeCalls;
+                break;
+        }
+    }
+}
+
+void Headless::Init(const SOptions& newOptions) {
+    options = newOptions;
+
+    void* memory = mmap(nullptr, ImageBytes, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        fprintf(stderr, "[Headless] Couldn't map the game image\n");
+        abort();
+    }
+    image = static_cast<uint8_t*>(memory);
+    // int3, so anything else in the image that gets called stops right there.
+    memset(image, 0xCC, ImageBytes);
+
+    // MZ, as a start. The script doesn't look at the headers.
+    image[0] = 'M';
+    image[1] = 'Z';
+    for (size_t i = 0; i < std::size(plants); ++i) {
+        plant(image + SlotSize * (i + 1), plants[i]);
+    }
+}
+
+void Headless::OnFrame(std::function<void()> callback) {
+    onFrame = std::move(callback);
+}
+
+std::string Headless::ModPath(const std::string& sub) {
+    return options.Folder + "\\TurboFix" + sub;
+}
+
+HMODULE Headless::ScriptModule() {
+    static int module;
+    return &module;
+}
+
+uintptr_t Headless::GetAddressOfEntity(int handle) {
+    SVehicle* vehicle = findVehicle(handle);
+    return vehicle ? reinterpret_cast<uintptr_t>(vehicle->Memory.get()) : 0;
+}
+
+Headless::SWorldStats Headless::WorldStats() {
+    SWorldStats current = stats;
+    current.Vehicles = static_cast<unsigned>(vehicles.size());
+    current.DeadVehicles = 0;
+    for (const auto& [handle, vehicle] : vehicles) {
+        current.DeadVehicles += vehicle.Dead ? 1 : 0;
+    }
+    return current;
+}
+
+// ScriptHookV
+
+void scriptWait(DWORD) {
+    ++stats.Frames;
+    if (onFrame)
+        onFrame();
+}
+
+void scriptRegister(HMODULE, void(*)()) {}
+void scriptRegisterAdditionalThread(HMODULE, void(*)()) {}
+void scriptUnregister(HMODULE) {}
+void scriptUnregister(void(*)()) {}
+
+void nativeInit(UINT64 hash) {
+    nativeHash = hash;
+    argCount = 0;
+}
+
+void nativePush64(UINT64 value) {
+    if (argCount < std::size(args))
+        args[argCount++] = value;
+}
+
+PUINT64 nativeCall() {
+    ++stats.NativeCalls;
+    memset(result, 0, sizeof(result));
+    call(nativeHash);
+    return result;
+}
+
+UINT64* getGlobalPtr(int) {
+    static UINT64 global;
+    return &global;
+}
+
+int worldGetAllVehicles(int* arr, int arrSize) {
+    int count = 0;
+    for (auto it = vehicles.begin(); it != vehicles.end() && count < arrSize; ++it) {
+        arr[count++] = it->first;
+    }
+    return count;
+}
+
+int worldGetAllPeds(int* arr, int arrSize) {
+    if (arrSize < 1)
+        return 0;
+    arr[0] = PlayerPed;
+    return 1;
+}
+
+int worldGetAllObjects(int*, int) {
+    return 0;
+}
+
+int worldGetAllPickups(int*, int) {
+    return 0;
+}
+
+BYTE* getScriptHandleBaseAddress(int handle) {
+    return reinterpret_cast<BYTE*>(Headless::GetAddressOfEntity(handle));
+}
+
+eGameVersion getGameVersion() {
+    return static_cast<eGameVersion>(GameVersion);
+}
+
+// Windows, for the game's image and the script's module
+
+HMODULE GetModuleHandle(const char* name) {
+    return name == nullptr ? image : nullptr;
+}
+
+HMODULE GetModuleHandleA(const char* name) {
+    return GetModuleHandle(name);
+}
+
+DWORD GetModuleFileNameA(HMODULE module, char* fileName, DWORD size) {
+    const char* name = module == Headless::ScriptModule() ? "TurboFix.asi" : "GTA5.exe";
+    int length = snprintf(fileName, size, "%s\\%s", options.Folder.c_str(), name);
+    return length < 0 ? 0 : static_cast<DWORD>(std::min<int>(length, static_cast<int>(size) - 1));
+}
+
+BOOL GetModuleInformation(HANDLE, HMODULE module, MODULEINFO* info, DWORD) {
+    if (module != image)
+        return FALSE;
+    info->lpBaseOfDll = image;
+    info->SizeOfImage = static_cast<DWORD>(ImageBytes);
+    info->EntryPoint = nullptr;
+    return TRUE;
+}
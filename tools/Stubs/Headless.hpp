@@ -0,0 +1,68 @@
+#pragma once
+// A fake game, so the script runs without it: ScriptHookV's exports, the
+// natives the script calls on a world of vehicles, and a game image with the
+// signatures from TurboFix/Memory/Signatures.hpp planted in it.
+// Elsewhere than Windows only, together with the other headers in this folder.
+// x86-64 only: the fake CVehicle::GetExhaust is called through the image.
+//
+// Files go where the script expects them, but on Linux a backslash is part of
+// the name: the script's settings are "<Folder>/\TurboFix\settings_general.ini".
+// ModPath builds those paths the same way.
+
+#include <Windows.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Headless {
+    struct SOptions {
+        // Folder with GTA5.exe and the script.
+        std::string Folder = ".";
+        // Vehicles closer than this to an exploding vehicle are killed too.
+        float BlastRadius = 10.0f;
+        // CREATE_VEHICLE fails once this many vehicles exist.
+        unsigned MaxVehicles = 2048;
+        // Particle assets that never load, like an asset that isn't installed.
+        std::vector<std::string> MissingPtfxAssets;
+    };
+
+    // Thrown from the frame callback, to get out of the script's tick loop.
+    struct SStop {};
+
+    struct SWorldStats {
+        uint64_t Frames;
+        uint64_t NativeCalls;
+        // Natives the fake game doesn't know, which returned zeroes.
+        uint64_t UnknownNativeCalls;
+        unsigned Vehicles;
+        unsigned DeadVehicles;
+        unsigned Explosions;
+        // Vehicles killed by an explosion of another vehicle.
+        unsigned CollateralKills;
+        uint64_t PtfxStarted;
+        uint64_t PtfxLoopedStarted;
+        uint64_t PtfxLoopedStopped;
+        // HAS_NAMED_PTFX_ASSET_LOADED calls.
+        uint64_t PtfxAssetChecks;
+    };
+
+    // Sets up the image. Call before the script scans anything.
+    void Init(const SOptions& options);
+
+    // Called by scriptWait, after the game advanced a frame.
+    void OnFrame(std::function<void()> onFrame);
+
+    // <Folder> + "\TurboFix" + sub, the same way the script builds its paths.
+    std::string ModPath(const std::string& sub);
+
+    // The handle DllMain would get for the script.
+    HMODULE ScriptModule();
+
+    // The signature is in the image, but the code around it isn't: point
+    // mem::GetAddressOfEntity here after the script scanned for it.
+    uintptr_t GetAddressOfEntity(int handle);
+
+    SWorldStats WorldStats();
+}
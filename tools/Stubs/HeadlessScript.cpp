@@ -0,0 +1,15 @@
+// What the script gets from elsewhere than its own sources, for the tools that
+// run it on the fake game in Headless.hpp.
+
+#include "Script.hpp"
+#include "Audio/NullBackend.hpp"
+
+// TurboFixMenu.cpp needs the real menu, and there's nothing to show it on.
+std::vector<CScriptMenu<CTurboScript>::CSubmenu> TurboFix::BuildMenu() {
+    return {};
+}
+
+// IrrKlang is Windows only. Voices of the null backend finish right away.
+std::unique_ptr<ISoundBackend> Audio::CreateSoundBackend(const std::string&, const std::string&) {
+    return std::make_unique<CNullBackend>();
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include "Windows.h"
+
+struct MODULEINFO {
+    LPVOID lpBaseOfDll;
+    DWORD SizeOfImage;
+    LPVOID EntryPoint;
+};
+
+BOOL GetModuleInformation(HANDLE process, HMODULE module, MODULEINFO* info, DWORD size);
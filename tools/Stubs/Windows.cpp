@@ -0,0 +1,70 @@
+#include "Windows.h"
+
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <thread>
+
+void GetLocalTime(SYSTEMTIME* time) {
+    auto now = std::chrono::system_clock::now();
+    std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+
+    std::tm local{};
+    localtime_r(&seconds, &local);
+    time->wYear = static_cast<WORD>(local.tm_year + 1900);
+    time->wMonth = static_cast<WORD>(local.tm_mon + 1);
+    time->wDayOfWeek = static_cast<WORD>(local.tm_wday);
+    time->wDay = static_cast<WORD>(local.tm_mday);
+    time->wHour = static_cast<WORD>(local.tm_hour);
+    time->wMinute = static_cast<WORD>(local.tm_min);
+    time->wSecond = static_cast<WORD>(local.tm_sec);
+    time->wMilliseconds = static_cast<WORD>(ms);
+}
+
+BOOL QueryPerformanceCounter(LARGE_INTEGER* count) {
+    count->QuadPart = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return TRUE;
+}
+
+BOOL QueryPerformanceFrequency(LARGE_INTEGER* frequency) {
+    frequency->QuadPart = 1000000000;
+    return TRUE;
+}
+
+DWORD GetCurrentThreadId() {
+    return static_cast<DWORD>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+}
+
+DWORD GetLastError() {
+    return 0;
+}
+
+void Sleep(DWORD ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+HANDLE GetCurrentProcess() {
+    return reinterpret_cast<HANDLE>(-1);
+}
+
+// Nothing else is around, so DashHook.dll isn't either.
+HMODULE LoadLibraryA(const char*) {
+    return nullptr;
+}
+
+BOOL FreeLibrary(HMODULE module) {
+    return module != nullptr;
+}
+
+FARPROC GetProcAddress(HMODULE, const char*) {
+    return nullptr;
+}
+
+// The image is writable already.
+BOOL VirtualProtect(void*, size_t, DWORD newProtect, DWORD* oldProtect) {
+    if (oldProtect)
+        *oldProtect = newProtect;
+    return TRUE;
+}
@@ -0,0 +1,87 @@
+#pragma once
+// Just enough of Windows.h for the tools to build script sources elsewhere.
+// Add to the include path only when not building on Windows, and lowercase/ too
+// for sources that include the SDK's main.h. Windows.cpp has the functions, for
+// the tools that link script sources that call them. The ones about modules are
+// in Headless.cpp, they answer for the fake game.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+typedef uint32_t DWORD;
+typedef int BOOL;
+typedef uint8_t BYTE;
+typedef uint16_t WORD;
+typedef uint32_t UINT;
+typedef int32_t LONG;
+typedef char CHAR;
+typedef void VOID;
+typedef uint64_t DWORD64;
+typedef uint64_t UINT64;
+typedef uint64_t ULONGLONG;
+typedef uintptr_t ULONG_PTR;
+typedef UINT64* PUINT64;
+typedef BYTE* LPBYTE;
+typedef void* LPVOID;
+typedef void* HANDLE;
+typedef void* HMODULE;
+typedef void* FARPROC;
+
+#ifndef __declspec
+#define __declspec(x)
+#endif
+#define APIENTRY
+#define WINAPI
+#define FAR
+#define TRUE 1
+#define FALSE 0
+#define MAX_PATH 260
+#define MAXDWORD 0xFFFFFFFF
+#define PAGE_EXECUTE_READWRITE 0x40
+#define DLL_PROCESS_DETACH 0
+#define DLL_PROCESS_ATTACH 1
+
+#define sscanf_s sscanf
+
+// MSVC's sized integer types.
+#define __int8 char
+#define __int16 short
+#define __int32 int
+#define __int64 long long
+
+struct SYSTEMTIME {
+    WORD wYear;
+    WORD wMonth;
+    WORD wDayOfWeek;
+    WORD wDay;
+    WORD wHour;
+    WORD wMinute;
+    WORD wSecond;
+    WORD wMilliseconds;
+};
+
+union LARGE_INTEGER {
+    struct {
+        DWORD LowPart;
+        LONG HighPart;
+    };
+    int64_t QuadPart;
+};
+
+void GetLocalTime(SYSTEMTIME* time);
+BOOL QueryPerformanceCounter(LARGE_INTEGER* count);
+BOOL QueryPerformanceFrequency(LARGE_INTEGER* frequency);
+DWORD GetCurrentThreadId();
+DWORD GetLastError();
+void Sleep(DWORD ms);
+
+// The game's image is the one from Headless.hpp, any other module doesn't exist.
+HMODULE GetModuleHandle(const char* name);
+HMODULE GetModuleHandleA(const char* name);
+DWORD GetModuleFileNameA(HMODULE module, char* fileName, DWORD size);
+HANDLE GetCurrentProcess();
+HMODULE LoadLibraryA(const char* fileName);
+BOOL FreeLibrary(HMODULE module);
+FARPROC GetProcAddress(HMODULE module, const char* name);
+BOOL VirtualProtect(void* address, size_t size, DWORD newProtect, DWORD* oldProtect);
@@ -0,0 +1,4 @@
+#pragma once
+// The SDK's main.h includes it lowercase. Kept apart from Windows.h, so the two
+// don't clash on case-insensitive file systems.
+#include "../Windows.h"
@@ -0,0 +1,35 @@
+#pragma once
+// Stands in for GTAVMenuBase's menu.h: a menu that never opens. Only what
+// ScriptMenu.hpp calls, the menu pages themselves aren't built headless.
+
+#include <inc/enums.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace NativeMenu {
+    class Menu {
+    public:
+        void RegisterOnMain(std::function<void()> onMain) {
+            mOnMain = std::move(onMain);
+        }
+
+        void RegisterOnExit(std::function<void()> onExit) {
+            mOnExit = std::move(onExit);
+        }
+
+        void SetFiles(const std::string&) {}
+        void Initialize() {}
+        void ReadSettings() {}
+        void CheckKeys() {}
+        void EndMenu() {}
+
+        bool CurrentMenu(const std::string&) {
+            return false;
+        }
+
+    private:
+        std::function<void()> mOnMain;
+        std::function<void()> mOnExit;
+    };
+}
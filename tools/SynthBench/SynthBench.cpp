@@ -0,0 +1,110 @@
+// Renders synthesized sound sets (TurboFix/Audio/Synth.hpp) offline and reports
+// how fast, to see what a change to the synth costs without starting the game.
+// Can also write what it renders to WAV files, to listen to the parameters.
+//
+// Needs the simpleini submodule. SSE2, so x86 or x86-64. From this folder:
+//   g++ -std=c++20 -O2 -I../../TurboFix -I../../thirdparty -I../Stubs -o SynthBench SynthBench.cpp ../Stubs/Windows.cpp ../../TurboFix/Audio/{Mix,Synth,Wav}.cpp ../../TurboFix/Util/{Logger,Threads}.cpp -pthread
+//   cl /std:c++20 /O2 /EHsc /I..\..\TurboFix /I..\..\thirdparty SynthBench.cpp ..\..\TurboFix\Audio\Mix.cpp ..\..\TurboFix\Audio\Synth.cpp ..\..\TurboFix\Audio\Wav.cpp ..\..\TurboFix\Util\Logger.cpp ..\..\TurboFix\Util\Threads.cpp
+//
+// Usage:
+//   SynthBench [SoundSet.ini] [output folder]
+//
+// Without a SoundSet.ini, the default [Synth] parameters are used.
+
+#include "Audio/Mix.hpp"
+#include "Audio/Synth.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+    // Enough for a stable number, in well under a second with the defaults.
+    constexpr unsigned Runs = 50;
+
+    struct SRendered {
+        std::vector<Audio::SPcm> Pops;
+        Audio::SPcm Sub;
+        std::vector<Audio::SPcm> Whistles;
+    };
+
+    // Same as loading a sound set with Type = Synth.
+    SRendered render(const Audio::SSynthParams& params) {
+        return { Audio::SynthesizePops(params), Audio::SynthesizeSub(params), Audio::SynthesizeWhistles(params) };
+    }
+
+    size_t frameCount(const SRendered& rendered) {
+        size_t frames = rendered.Sub.FrameCount();
+        for (const auto& pop : rendered.Pops) {
+            frames += pop.FrameCount();
+        }
+        for (const auto& whistle : rendered.Whistles) {
+            frames += whistle.FrameCount();
+        }
+        return frames;
+    }
+
+    bool write(const std::filesystem::path& folder, const SRendered& rendered) {
+        std::filesystem::create_directories(folder);
+        bool ok = Audio::WriteWav((folder / "SYNTH_SUB.wav").string(), rendered.Sub);
+        for (size_t i = 0; i < rendered.Pops.size(); ++i) {
+            ok &= Audio::WriteWav((folder / ("SYNTH_POP_" + std::to_string(i) + ".wav")).string(), rendered.Pops[i]);
+        }
+        for (size_t i = 0; i < rendered.Whistles.size(); ++i) {
+            ok &= Audio::WriteWav((folder / ("SYNTH_WHISTLE_" + std::to_string(i) + ".wav")).string(), rendered.Whistles[i]);
+        }
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    Audio::SSynthParams params;
+    if (argc > 1)
+        params = Audio::ReadSynthParams(argv[1]);
+
+    printf("Parameters %08x: %u pops of %.0f ms, whistle %.0f ms at %.0f Hz (level %.2f)\n",
+        Audio::HashSynthParams(params), params.Variants, params.LengthMs,
+        params.WhistleMs, params.WhistleHz, params.WhistleLevel);
+
+    // Once to warm up, and to have something to write.
+    SRendered rendered = render(params);
+    const size_t frames = frameCount(rendered);
+
+    std::vector<double> runMs;
+    for (unsigned run = 0; run < Runs; ++run) {
+        auto tStart = std::chrono::steady_clock::now();
+        SRendered result = render(params);
+        auto tEnd = std::chrono::steady_clock::now();
+        runMs.push_back(std::chrono::duration<double, std::milli>(tEnd - tStart).count());
+
+        if (frameCount(result) != frames) {
+            fprintf(stderr, "Run %u rendered %zu frames instead of %zu\n", run, frameCount(result), frames);
+            return 1;
+        }
+    }
+
+    double totalMs = 0.0;
+    double minMs = runMs[0];
+    for (double ms : runMs) {
+        totalMs += ms;
+        minMs = std::min(minMs, ms);
+    }
+    const double avgMs = totalMs / Runs;
+    const double audioMs = static_cast<double>(frames) * 1000.0 / Audio::MixSampleRate;
+
+    printf("%zu samples, %.0f ms of audio at %u Hz\n", rendered.Pops.size() + 1 + rendered.Whistles.size(),
+        audioMs, Audio::MixSampleRate);
+    printf("Sound set: avg %.3f ms, min %.3f ms over %u runs\n", avgMs, minMs, Runs);
+    printf("%.1f ns per frame, %.0fx real time\n", avgMs * 1e6 / static_cast<double>(frames), audioMs / avgMs);
+
+    if (argc > 2) {
+        if (!write(argv[2], rendered)) {
+            fprintf(stderr, "Couldn't write to [%s]\n", argv[2]);
+            return 1;
+        }
+        printf("Written to [%s]\n", argv[2]);
+    }
+    return 0;
+}